@@ -0,0 +1,336 @@
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <ostream>
+#include <utility>
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+namespace rb::bench
+{
+	/**
+	 * \brief Settings shared by every benchmark of a run.
+	 */
+	struct options
+	{
+		// Untimed samples taken before the measured ones, so that caches, branch predictors and the clock frequency settle
+		size_t warmup = 2;
+
+		// Measured samples, the statistics are computed over these
+		size_t repetitions = 11;
+
+		// Every sample repeats the operation until it takes at least this long
+		double min_sample_time = 0.01;
+
+		// Only benchmarks whose `group/name` contains this string are run
+		std::string filter;
+	};
+
+	/**
+	 * \brief Order statistics of the samples of one benchmark.
+	 */
+	struct stats
+	{
+		double min = 0.0;
+		double p10 = 0.0;
+		double median = 0.0;
+		double p90 = 0.0;
+		double max = 0.0;
+	};
+
+	/**
+	 * \brief Measurements of one benchmark, every statistic is per operation.
+	 */
+	struct result
+	{
+		std::string group;
+		std::string name;
+
+		// Bytes processed by one operation, 0 when throughput is meaningless
+		size_t bytes = 0;
+
+		// Number of times the operation was repeated within each sample
+		size_t iterations = 0;
+
+		stats nanoseconds;
+		stats cycles;
+	};
+
+	/**
+	 * \brief Keeps the compiler from optimizing away the computation of `value`.
+	 */
+	template<class T>
+	inline void do_not_optimize(T& value) noexcept
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		static volatile const void* sink;
+		sink = &value;
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "g"(&value) : "memory");
+#endif
+	}
+
+	/**
+	 * \brief Reads the time stamp counter.
+	 *
+	 * The counter ticks at a constant reference rate on current processors, so cycle counts are
+	 * in reference cycles and differ from core cycles while the core runs above or below it.
+	 */
+	[[nodiscard]] inline uint64_t cycles() noexcept
+	{
+		return __rdtsc();
+	}
+
+	/**
+	 * \brief Returns the `p`-th percentile of sorted `values`, interpolating between the nearest ranks.
+	 */
+	[[nodiscard]] inline double percentile(const std::vector<double>& values, double p) noexcept
+	{
+		if (values.empty())
+			return 0.0;
+
+		const double rank = p / 100.0 * static_cast<double>(values.size() - 1);
+		const size_t lower = static_cast<size_t>(rank);
+		const size_t upper = std::min(lower + 1, values.size() - 1);
+
+		return values[lower] + (values[upper] - values[lower]) * (rank - static_cast<double>(lower));
+	}
+
+	[[nodiscard]] inline stats make_stats(std::vector<double> values) noexcept
+	{
+		std::sort(values.begin(), values.end());
+
+		stats s;
+
+		if (values.empty())
+			return s;
+
+		s.min = values.front();
+		s.p10 = percentile(values, 10.0);
+		s.median = percentile(values, 50.0);
+		s.p90 = percentile(values, 90.0);
+		s.max = values.back();
+
+		return s;
+	}
+
+	/**
+	 * \brief Fills a buffer with reproducible pseudorandom bytes.
+	 */
+	[[nodiscard]] inline std::vector<uint8_t> random_bytes(size_t size, uint64_t seed = 0x5EED) noexcept
+	{
+		std::mt19937_64 engine(seed);
+		std::vector<uint8_t> bytes(size);
+
+		for (uint8_t& b : bytes)
+			b = static_cast<uint8_t>(engine());
+
+		return bytes;
+	}
+
+	/**
+	 * \brief Runs benchmarks and collects their results.
+	 */
+	class runner
+	{
+	public:
+		explicit runner(const options& opts) noexcept
+			: m_options(opts)
+		{
+		}
+
+		/**
+		 * \brief Measures `op`, which performs one operation processing `bytes` bytes.
+		 *
+		 * The number of operations per sample is calibrated once, then `warmup` samples are discarded
+		 * and `repetitions` samples are recorded.
+		 */
+		template<class F>
+		void run(const std::string& group, const std::string& name, size_t bytes, F&& op)
+		{
+			if (!m_options.filter.empty() && (group + "/" + name).find(m_options.filter) == std::string::npos)
+				return;
+
+			result r;
+			r.group = group;
+			r.name = name;
+			r.bytes = bytes;
+			r.iterations = calibrate(op);
+
+			std::vector<double> nanoseconds;
+			std::vector<double> cycle_counts;
+
+			for (size_t i = 0; i < m_options.warmup + m_options.repetitions; i++)
+			{
+				const auto start = clock::now();
+				const uint64_t start_cycles = cycles();
+
+				for (size_t j = 0; j < r.iterations; j++)
+					op();
+
+				const uint64_t end_cycles = cycles();
+				const auto end = clock::now();
+
+				if (i < m_options.warmup)
+					continue;
+
+				const double n = static_cast<double>(r.iterations);
+
+				nanoseconds.push_back(std::chrono::duration<double, std::nano>(end - start).count() / n);
+				cycle_counts.push_back(static_cast<double>(end_cycles - start_cycles) / n);
+			}
+
+			r.nanoseconds = make_stats(std::move(nanoseconds));
+			r.cycles = make_stats(std::move(cycle_counts));
+
+			m_results.push_back(std::move(r));
+		}
+
+		[[nodiscard]] const std::vector<result>& results() const noexcept
+		{
+			return m_results;
+		}
+
+		/**
+		 * \brief Writes the options and every result as a JSON document.
+		 *
+		 * Besides the raw statistics every result has the derived `ops_per_second`, and if it processes
+		 * bytes, `cycles_per_byte` and `megabytes_per_second` (10^6 bytes), all computed from the medians.
+		 */
+		void write_json(std::ostream& os, const std::string& header = {}) const
+		{
+			os << "{\n";
+
+			if (!header.empty())
+				os << header << ",\n";
+
+			os << "\t\"options\": { \"warmup\": " << m_options.warmup
+				<< ", \"repetitions\": " << m_options.repetitions
+				<< ", \"min_sample_time\": " << m_options.min_sample_time << " },\n";
+
+			os << "\t\"results\": [";
+
+			for (size_t i = 0; i < m_results.size(); i++)
+			{
+				const result& r = m_results[i];
+
+				os << (i == 0 ? "\n" : ",\n") << "\t\t{ ";
+				os << "\"group\": " << quote(r.group) << ", \"name\": " << quote(r.name);
+				os << ", \"bytes\": " << r.bytes << ", \"iterations\": " << r.iterations;
+
+				os << ", \"ns_per_op\": ";
+				write_stats(os, r.nanoseconds);
+				os << ", \"cycles_per_op\": ";
+				write_stats(os, r.cycles);
+
+				os << ", \"ops_per_second\": " << number(r.nanoseconds.median > 0.0 ? 1e9 / r.nanoseconds.median : 0.0);
+
+				if (r.bytes > 0)
+				{
+					const double bytes = static_cast<double>(r.bytes);
+
+					os << ", \"cycles_per_byte\": " << number(r.cycles.median / bytes);
+					os << ", \"megabytes_per_second\": " << number(r.nanoseconds.median > 0.0 ? bytes * 1e3 / r.nanoseconds.median : 0.0);
+				}
+
+				os << " }";
+			}
+
+			os << "\n\t]\n}\n";
+		}
+
+		[[nodiscard]] static std::string quote(const std::string& str)
+		{
+			std::string s = "\"";
+
+			for (char c : str)
+			{
+				if (c == '"' || c == '\\')
+				{
+					s += '\\';
+					s += c;
+				}
+				else if (static_cast<unsigned char>(c) < 0x20)
+				{
+					// Control characters are not allowed in JSON strings
+					static constexpr char HEX[] = "0123456789abcdef";
+
+					s += "\\u00";
+					s += HEX[static_cast<unsigned char>(c) >> 4];
+					s += HEX[c & 0x0F];
+				}
+				else
+				{
+					s += c;
+				}
+			}
+
+			return s + "\"";
+		}
+
+	private:
+		using clock = std::chrono::steady_clock;
+
+		options m_options;
+		std::vector<result> m_results;
+
+		// Doubles the number of operations until a batch takes at least `min_sample_time`
+		template<class F>
+		size_t calibrate(F& op) const
+		{
+			size_t iterations = 1;
+
+			for (;;)
+			{
+				const auto start = clock::now();
+
+				for (size_t j = 0; j < iterations; j++)
+					op();
+
+				const double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+
+				if (elapsed >= m_options.min_sample_time || iterations >= (size_t(1) << 40))
+					return iterations;
+
+				// Jump close to the target once the measurement is long enough to be trusted
+				if (elapsed > m_options.min_sample_time / 16)
+					return std::max<size_t>(iterations, static_cast<size_t>(std::ceil(iterations * m_options.min_sample_time / elapsed)));
+
+				iterations *= 2;
+			}
+		}
+
+		// JSON has no representation of infinities and NaN
+		[[nodiscard]] static double number(double value) noexcept
+		{
+			return std::isfinite(value) ? value : 0.0;
+		}
+
+		static void write_stats(std::ostream& os, const stats& s)
+		{
+			os << "{ \"min\": " << number(s.min)
+				<< ", \"p10\": " << number(s.p10)
+				<< ", \"median\": " << number(s.median)
+				<< ", \"p90\": " << number(s.p90)
+				<< ", \"max\": " << number(s.max) << " }";
+		}
+	};
+
+	void run_hash_benchmarks(runner& r);
+	void run_cipher_benchmarks(runner& r);
+	void run_bigint_benchmarks(runner& r);
+	void run_ecdsa_benchmarks(runner& r);
+	void run_matrix_benchmarks(runner& r);
+}
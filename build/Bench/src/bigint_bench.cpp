@@ -0,0 +1,72 @@
+#include "bench.h"
+
+#include "math/bigint.h"
+
+namespace rb::bench
+{
+	template<class T>
+	[[nodiscard]] static T random_int(size_t bits, uint64_t seed)
+	{
+		const std::vector<uint8_t> bytes = random_bytes(bits / 8, seed);
+		return T(bytes.data(), bytes.size());
+	}
+
+	// Products wrap around and the divisor has half as many bits as the dividend
+	template<class T>
+	static void bench_fixed(runner& r, const std::string& name, size_t bits)
+	{
+		const T a = random_int<T>(bits, 1);
+		const T b = random_int<T>(bits, 2);
+		const T d = random_int<T>(bits / 2, 3);
+		const T e = T(65537);
+
+		r.run("bigint", name + "/mul", 0, [&]()
+		{
+			T c = a * b;
+			do_not_optimize(c);
+		});
+
+		r.run("bigint", name + "/div", 0, [&]()
+		{
+			T c = a / d;
+			do_not_optimize(c);
+		});
+
+		r.run("bigint", name + "/pow_65537", 0, [&]()
+		{
+			T c = a.pow(e);
+			do_not_optimize(c);
+		});
+	}
+
+	void run_bigint_benchmarks(runner& r)
+	{
+		bench_fixed<math::uint256>(r, "uint256", 256);
+		bench_fixed<math::uint2048>(r, "uint2048", 2048);
+
+		// Arbitrary precision grows instead of wrapping, so its operand sizes are listed in the names
+		const math::bigint a = random_int<math::bigint>(1024, 1);
+		const math::bigint b = random_int<math::bigint>(1024, 2);
+		const math::bigint n = random_int<math::bigint>(2048, 3);
+		const math::bigint base = random_int<math::bigint>(64, 4);
+		const math::bigint e = math::bigint(64);
+
+		r.run("bigint", "bigint/mul_1024x1024", 0, [&]()
+		{
+			math::bigint c = a * b;
+			do_not_optimize(c);
+		});
+
+		r.run("bigint", "bigint/div_2048x1024", 0, [&]()
+		{
+			math::bigint c = n / a;
+			do_not_optimize(c);
+		});
+
+		r.run("bigint", "bigint/pow_64x64", 0, [&]()
+		{
+			math::bigint c = base.pow(e);
+			do_not_optimize(c);
+		});
+	}
+}
@@ -0,0 +1,69 @@
+#include "bench.h"
+
+#include "crypto/aes.h"
+
+namespace rb::bench
+{
+	static constexpr size_t CIPHER_SIZES[] = { 64, 1024, 16 * 1024, 1024 * 1024 };
+
+	// One operation encrypts or decrypts a whole message through the `basic_cipher` interface,
+	// the key schedule is cached by the cipher after the first message
+	template<class C>
+	static void bench_cipher(runner& r, const std::string& name, const std::vector<uint8_t>& data, const std::vector<uint8_t>& key)
+	{
+		const std::vector<uint8_t> iv = random_bytes(16, 2);
+
+		std::vector<uint8_t> encrypted(data.size() + 16);
+		std::vector<uint8_t> decrypted(data.size() + 16);
+
+		C cipher;
+
+		for (size_t size : CIPHER_SIZES)
+		{
+			size_t encrypted_size = 0;
+
+			r.run("cipher", name + "/encrypt/" + std::to_string(size), size, [&]()
+			{
+				cipher.clear();
+				cipher.set_iv(iv.data(), C::MODE == crypto::cipher_mode::GCM ? 12 : 16);
+				cipher.write(data.data(), size);
+
+				encrypted_size = cipher.encrypt(key.data(), key.size(), encrypted.data());
+
+				do_not_optimize(encrypted);
+			});
+
+			r.run("cipher", name + "/decrypt/" + std::to_string(size), size, [&]()
+			{
+				cipher.clear();
+				cipher.set_iv(iv.data(), C::MODE == crypto::cipher_mode::GCM ? 12 : 16);
+				cipher.write(encrypted.data(), encrypted_size);
+
+				size_t decrypted_size = cipher.decrypt(key.data(), key.size(), decrypted.data());
+
+				do_not_optimize(decrypted_size);
+			});
+		}
+	}
+
+	template<size_t K, size_t R>
+	static void bench_modes(runner& r, const std::string& name, const std::vector<uint8_t>& data)
+	{
+		const std::vector<uint8_t> key = random_bytes(K * 4, 1);
+
+		bench_cipher<crypto::aes<crypto::cipher_mode::ECB, K, 4, R>>(r, name + "_ecb", data, key);
+		bench_cipher<crypto::aes<crypto::cipher_mode::CBC, K, 4, R>>(r, name + "_cbc", data, key);
+		bench_cipher<crypto::aes<crypto::cipher_mode::PCBC, K, 4, R>>(r, name + "_pcbc", data, key);
+		bench_cipher<crypto::aes<crypto::cipher_mode::CTR, K, 4, R>>(r, name + "_ctr", data, key);
+		bench_cipher<crypto::aes<crypto::cipher_mode::GCM, K, 4, R>>(r, name + "_gcm", data, key);
+	}
+
+	void run_cipher_benchmarks(runner& r)
+	{
+		const std::vector<uint8_t> data = random_bytes(CIPHER_SIZES[std::size(CIPHER_SIZES) - 1]);
+
+		bench_modes<4, 10>(r, "aes_128", data);
+		bench_modes<6, 12>(r, "aes_192", data);
+		bench_modes<8, 14>(r, "aes_256", data);
+	}
+}
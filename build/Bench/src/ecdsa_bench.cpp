@@ -0,0 +1,44 @@
+#include "bench.h"
+
+#include "crypto/ecdsa.h"
+
+namespace rb::bench
+{
+	// Signs and verifies a 32 byte message, one key pair is generated up front
+	template<class E>
+	static void bench_ecdsa(runner& r, const std::string& name)
+	{
+		const std::vector<uint8_t> message = random_bytes(32);
+
+		// Structured bindings cannot be captured by lambdas in C++17
+		const typename E::key_pair_type key_pair = E::generate_key_pair();
+		const typename E::private_key_type& d = std::get<0>(key_pair);
+		const typename E::public_key_type& Q = std::get<1>(key_pair);
+
+		const typename E::signature_type signature = E::sign(d, message.data(), message.size());
+
+		r.run("ecdsa", name + "/sign", 0, [&]()
+		{
+			typename E::signature_type s = E::sign(d, message.data(), message.size());
+			do_not_optimize(s);
+		});
+
+		r.run("ecdsa", name + "/verify", 0, [&]()
+		{
+			bool valid = E::verify(Q, signature, message.data(), message.size());
+			do_not_optimize(valid);
+		});
+	}
+
+	void run_ecdsa_benchmarks(runner& r)
+	{
+		bench_ecdsa<crypto::ECDSA_secp192k1>(r, "secp192k1");
+		bench_ecdsa<crypto::ECDSA_secp192r1>(r, "secp192r1");
+		bench_ecdsa<crypto::ECDSA_secp224k1>(r, "secp224k1");
+		bench_ecdsa<crypto::ECDSA_secp224r1>(r, "secp224r1");
+		bench_ecdsa<crypto::ECDSA_secp256k1>(r, "secp256k1");
+		bench_ecdsa<crypto::ECDSA_secp256r1>(r, "secp256r1");
+		bench_ecdsa<crypto::ECDSA_secp384r1>(r, "secp384r1");
+		bench_ecdsa<crypto::ECDSA_secp521r1>(r, "secp521r1");
+	}
+}
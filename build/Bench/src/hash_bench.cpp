@@ -0,0 +1,75 @@
+#include "bench.h"
+
+#include "crypto/md5.h"
+#include "crypto/sha1.h"
+#include "crypto/sha2.h"
+#include "crypto/ripemd.h"
+#include "crypto/keccak.h"
+#include "crypto/hmac.h"
+
+namespace rb::bench
+{
+	static constexpr size_t HASH_SIZES[] = { 16, 64, 1024, 16 * 1024, 1024 * 1024 };
+
+	// One operation hashes a whole message from a cleared state
+	template<class H>
+	static void bench_hash(runner& r, const std::string& name, const std::vector<uint8_t>& data, H hash = H())
+	{
+		for (size_t size : HASH_SIZES)
+		{
+			r.run("hash", name + "/" + std::to_string(size), size, [&]()
+			{
+				uint8_t digest[128];
+
+				hash.clear();
+				hash.write(data.data(), size);
+				hash.digest(digest);
+
+				do_not_optimize(digest);
+			});
+		}
+	}
+
+	void run_hash_benchmarks(runner& r)
+	{
+		const std::vector<uint8_t> data = random_bytes(HASH_SIZES[std::size(HASH_SIZES) - 1]);
+		const std::vector<uint8_t> key = random_bytes(32, 1);
+
+		bench_hash<crypto::md5>(r, "md5", data);
+		bench_hash<crypto::sha1>(r, "sha1", data);
+		bench_hash<crypto::ripemd160>(r, "ripemd160", data);
+
+		bench_hash<crypto::sha2_224>(r, "sha2_224", data);
+		bench_hash<crypto::sha2_256>(r, "sha2_256", data);
+		bench_hash<crypto::sha2_384>(r, "sha2_384", data);
+		bench_hash<crypto::sha2_512>(r, "sha2_512", data);
+
+		bench_hash<crypto::sha3_224>(r, "sha3_224", data);
+		bench_hash<crypto::sha3_256>(r, "sha3_256", data);
+		bench_hash<crypto::sha3_384>(r, "sha3_384", data);
+		bench_hash<crypto::sha3_512>(r, "sha3_512", data);
+
+		bench_hash<crypto::shake128<256>>(r, "shake128", data);
+		bench_hash<crypto::shake256<512>>(r, "shake256", data);
+
+		bench_hash(r, "hmac_sha2_256", data, crypto::hmac_context<crypto::sha2_256>(key.data(), key.size()));
+
+		// Tree hashes on a single thread, so that their numbers compare with the sequential hashes
+		for (size_t size : HASH_SIZES)
+		{
+			r.run("hash", "parallel_hash128/" + std::to_string(size), size, [&]()
+			{
+				uint8_t digest[32];
+				crypto::parallel_hash128(data.data(), size, 8192, digest, sizeof(digest), {}, 1);
+				do_not_optimize(digest);
+			});
+
+			r.run("hash", "kangaroo_twelve/" + std::to_string(size), size, [&]()
+			{
+				uint8_t digest[32];
+				crypto::kangaroo_twelve(data.data(), size, digest, sizeof(digest), {}, 1);
+				do_not_optimize(digest);
+			});
+		}
+	}
+}
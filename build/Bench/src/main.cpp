@@ -0,0 +1,146 @@
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include "bench.h"
+
+#include "intrin/cpu.h"
+
+using namespace rb::bench;
+
+static void print_usage(const char* program)
+{
+	std::cerr << "Usage: " << program << " [options]\n"
+		<< "  --warmup N        untimed samples before measuring, at most 1000000 (default 2)\n"
+		<< "  --repetitions N   measured samples, 1 to 1000000 (default 11)\n"
+		<< "  --min-time MS     minimum duration of a sample in milliseconds, greater than 0 (default 10)\n"
+		<< "  --filter TEXT     only runs benchmarks whose group/name contains TEXT\n"
+		<< "  --out FILE        writes the JSON report to FILE instead of stdout\n";
+}
+
+// Largest accepted --warmup and --repetitions, keeps their sum far from overflowing
+static constexpr unsigned long long MAX_SAMPLES = 1000000;
+
+// Parses a decimal number in [min, MAX_SAMPLES] spanning the whole argument, std::stoul would accept a sign and trailing garbage
+static bool parse_count(const char* text, size_t min, size_t& value)
+{
+	if (*text < '0' || *text > '9')
+		return false;
+
+	char* end = nullptr;
+	errno = 0;
+
+	const unsigned long long n = std::strtoull(text, &end, 10);
+
+	if (errno != 0 || *end != '\0' || n < min || n > MAX_SAMPLES)
+		return false;
+
+	value = static_cast<size_t>(n);
+	return true;
+}
+
+// Parses a finite number of milliseconds greater than 0 and converts it to seconds, the whole argument has to be the number
+static bool parse_time(const char* text, double& value)
+{
+	char* end = nullptr;
+	errno = 0;
+
+	const double ms = std::strtod(text, &end);
+
+	if (end == text || errno != 0 || *end != '\0' || !std::isfinite(ms) || ms <= 0.0)
+		return false;
+
+	value = ms / 1000.0;
+	return true;
+}
+
+static std::string describe_environment()
+{
+	const rb::intrin::cpu_features& cpu = rb::intrin::cpu();
+
+	std::ostringstream os;
+
+	os << "\t\"environment\": { \"compiler\": ";
+
+#if defined(__clang__)
+	os << runner::quote("clang " __clang_version__);
+#elif defined(__GNUC__)
+	os << runner::quote("gcc " __VERSION__);
+#elif defined(_MSC_VER)
+	os << runner::quote("msvc " + std::to_string(_MSC_VER));
+#else
+	os << runner::quote("unknown");
+#endif
+
+	os << std::boolalpha
+		<< ", \"sse41\": " << cpu.sse41
+		<< ", \"avx2\": " << cpu.avx2
+		<< ", \"bmi2\": " << cpu.bmi2
+		<< ", \"adx\": " << cpu.adx
+		<< ", \"aes\": " << cpu.aes
+		<< ", \"pclmulqdq\": " << cpu.pclmulqdq
+		<< ", \"sha\": " << cpu.sha << " }";
+
+	return os.str();
+}
+
+int main(int argc, char* argv[])
+{
+	options opts;
+	std::string out_path;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const bool has_value = i + 1 < argc;
+		bool valid = has_value;
+
+		if (std::strcmp(argv[i], "--warmup") == 0 && has_value)
+			valid = parse_count(argv[++i], 0, opts.warmup);
+		else if (std::strcmp(argv[i], "--repetitions") == 0 && has_value)
+			valid = parse_count(argv[++i], 1, opts.repetitions);
+		else if (std::strcmp(argv[i], "--min-time") == 0 && has_value)
+			valid = parse_time(argv[++i], opts.min_sample_time);
+		else if (std::strcmp(argv[i], "--filter") == 0 && has_value)
+			opts.filter = argv[++i];
+		else if (std::strcmp(argv[i], "--out") == 0 && has_value)
+			out_path = argv[++i];
+		else
+			valid = false;
+
+		if (!valid)
+		{
+			print_usage(argv[0]);
+			return 1;
+		}
+	}
+
+	runner r(opts);
+
+	run_hash_benchmarks(r);
+	run_cipher_benchmarks(r);
+	run_bigint_benchmarks(r);
+	run_ecdsa_benchmarks(r);
+	run_matrix_benchmarks(r);
+
+	if (out_path.empty())
+	{
+		r.write_json(std::cout, describe_environment());
+		return 0;
+	}
+
+	std::ofstream file(out_path);
+
+	if (!file)
+	{
+		std::cerr << "Cannot open `" << out_path << "`\n";
+		return 1;
+	}
+
+	r.write_json(file, describe_environment());
+
+	return 0;
+}
@@ -0,0 +1,171 @@
+#include "bench.h"
+
+#include "math/matrix.h"
+#include "math/vector.h"
+#include "math/transform.h"
+
+namespace rb::bench
+{
+	static constexpr size_t POINT_COUNT = 1024;
+
+	template<class M>
+	[[nodiscard]] static M random_matrix(uint64_t seed)
+	{
+		std::mt19937_64 engine(seed);
+		std::uniform_real_distribution<typename M::value_type> dist(-1, 1);
+
+		M m;
+
+		for (size_t i = 0; i < M::SIZE; i++)
+			m[i] = dist(engine);
+
+		// Diagonal dominance keeps the matrix far from singular
+		for (size_t i = 0; i < M::ROWS; i++)
+			m.at(i, i) += 4;
+
+		return m;
+	}
+
+	template<class V>
+	[[nodiscard]] static V random_vector(uint64_t seed)
+	{
+		std::mt19937_64 engine(seed);
+		std::uniform_real_distribution<typename V::value_type> dist(-1, 1);
+
+		V v;
+
+		for (size_t i = 0; i < v.size(); i++)
+			v[i] = dist(engine);
+
+		return v;
+	}
+
+	template<class M>
+	static void bench_matrix(runner& r, const std::string& name)
+	{
+		const M a = random_matrix<M>(1);
+		const M b = random_matrix<M>(2);
+
+		r.run("matrix", name + "/mul", 0, [&]()
+		{
+			M c = a * b;
+			do_not_optimize(c);
+		});
+
+		r.run("matrix", name + "/transpose", 0, [&]()
+		{
+			auto c = a.transpose();
+			do_not_optimize(c);
+		});
+
+		r.run("matrix", name + "/determinant", 0, [&]()
+		{
+			auto c = a.determinant();
+			do_not_optimize(c);
+		});
+
+		r.run("matrix", name + "/inverse", 0, [&]()
+		{
+			M c = a.inverse();
+			do_not_optimize(c);
+		});
+	}
+
+	template<class T>
+	static void bench_vector(runner& r, const std::string& suffix)
+	{
+		const math::vec3<T> a3 = random_vector<math::vec3<T>>(1);
+		const math::vec3<T> b3 = random_vector<math::vec3<T>>(2);
+		const math::vec4<T> a4 = random_vector<math::vec4<T>>(3);
+		const math::vec4<T> b4 = random_vector<math::vec4<T>>(4);
+		const math::mat4<T> m = random_matrix<math::mat4<T>>(5);
+
+		r.run("vector", "vec4" + suffix + "/add", 0, [&]()
+		{
+			math::vec4<T> c = a4 + b4;
+			do_not_optimize(c);
+		});
+
+		r.run("vector", "vec4" + suffix + "/dot", 0, [&]()
+		{
+			T c = a4.dot(b4);
+			do_not_optimize(c);
+		});
+
+		r.run("vector", "vec3" + suffix + "/cross", 0, [&]()
+		{
+			math::vec3<T> c = a3.cross(b3);
+			do_not_optimize(c);
+		});
+
+		r.run("vector", "vec3" + suffix + "/norm", 0, [&]()
+		{
+			math::vec3<T> c = a3.norm();
+			do_not_optimize(c);
+		});
+
+		r.run("vector", "vec4" + suffix + "/mul_mat4", 0, [&]()
+		{
+			math::vec4<T> c = a4 * m;
+			do_not_optimize(c);
+		});
+	}
+
+	// One operation transforms the whole batch of points
+	template<class T>
+	static void bench_transform(runner& r, const std::string& suffix)
+	{
+		const math::mat4<T> m = math::rotate_y(math::translate(math::mat4<T>::IDENTITY(), math::vec4<T>{ 1, 2, 3, 1 }), T(0.5));
+
+		std::vector<math::vec4<T>> in4(POINT_COUNT);
+		std::vector<math::vec4<T>> out4(POINT_COUNT);
+		std::vector<math::vec3<T>> in3(POINT_COUNT);
+		std::vector<math::vec3<T>> out3(POINT_COUNT);
+		std::vector<T> x(POINT_COUNT), y(POINT_COUNT), z(POINT_COUNT);
+		std::vector<T> out_x(POINT_COUNT), out_y(POINT_COUNT), out_z(POINT_COUNT);
+
+		for (size_t i = 0; i < POINT_COUNT; i++)
+		{
+			in4[i] = random_vector<math::vec4<T>>(i);
+			in3[i] = random_vector<math::vec3<T>>(i);
+
+			x[i] = in3[i][0];
+			y[i] = in3[i][1];
+			z[i] = in3[i][2];
+		}
+
+		const std::string count = std::to_string(POINT_COUNT);
+
+		r.run("transform", "vec4" + suffix + "/transform/" + count, 0, [&]()
+		{
+			math::transform(m, in4.data(), out4.data(), POINT_COUNT);
+			do_not_optimize(out4);
+		});
+
+		r.run("transform", "vec3" + suffix + "/transform_points/" + count, 0, [&]()
+		{
+			math::transform_points(m, in3.data(), out3.data(), POINT_COUNT);
+			do_not_optimize(out3);
+		});
+
+		r.run("transform", "vec3" + suffix + "/transform_points_soa/" + count, 0, [&]()
+		{
+			math::transform_points(m, x.data(), y.data(), z.data(), out_x.data(), out_y.data(), out_z.data(), POINT_COUNT);
+			do_not_optimize(out_x);
+		});
+	}
+
+	void run_matrix_benchmarks(runner& r)
+	{
+		bench_matrix<math::mat3f>(r, "mat3f");
+		bench_matrix<math::mat3d>(r, "mat3d");
+		bench_matrix<math::mat4f>(r, "mat4f");
+		bench_matrix<math::mat4d>(r, "mat4d");
+
+		bench_vector<float>(r, "f");
+		bench_vector<double>(r, "d");
+
+		bench_transform<float>(r, "f");
+		bench_transform<double>(r, "d");
+	}
+}
@@ -0,0 +1,388 @@
+#include "pch.h"
+
+#include <immintrin.h>
+
+#include "crypto/aes.h"
+
+namespace rb::crypto
+{
+	// AES using the AES-NI instruction set and GHASH using carry-less multiplication
+	// https://www.intel.com/content/dam/doc/white-paper/advanced-encryption-standard-new-instructions-set-paper.pdf
+	// https://www.intel.com/content/dam/www/public/us/en/documents/white-papers/carry-less-multiplication-instruction-in-gcm-mode-paper.pdf
+
+	static constexpr size_t PIPELINE = 8;
+
+	[[nodiscard]] static inline __m128i byte_swap(__m128i x) noexcept
+	{
+		return _mm_shuffle_epi8(x, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+	}
+
+	static inline void load_round_keys(const uint8_t* round_keys, size_t rounds, __m128i keys[15]) noexcept
+	{
+		for (size_t r = 0; r <= rounds; r++)
+			keys[r] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(round_keys + r * 16));
+	}
+
+	// The block loops are expanded with fold expressions over a local copy, so that all blocks stay in registers and their rounds interleave
+	template<size_t... I>
+	static inline void encrypt_xn_impl(const __m128i keys[15], size_t rounds, __m128i blocks[], std::index_sequence<I...>) noexcept
+	{
+		__m128i state[] = { _mm_xor_si128(blocks[I], keys[0])... };
+
+		for (size_t r = 1; r < rounds; r++)
+			((state[I] = _mm_aesenc_si128(state[I], keys[r])), ...);
+
+		((blocks[I] = _mm_aesenclast_si128(state[I], keys[rounds])), ...);
+	}
+
+	template<size_t... I>
+	static inline void decrypt_xn_impl(const __m128i keys[15], size_t rounds, __m128i blocks[], std::index_sequence<I...>) noexcept
+	{
+		__m128i state[] = { _mm_xor_si128(blocks[I], keys[0])... };
+
+		for (size_t r = 1; r < rounds; r++)
+			((state[I] = _mm_aesdec_si128(state[I], keys[r])), ...);
+
+		((blocks[I] = _mm_aesdeclast_si128(state[I], keys[rounds])), ...);
+	}
+
+	template<size_t N>
+	static inline void encrypt_xn(const __m128i keys[15], size_t rounds, __m128i blocks[N]) noexcept
+	{
+		encrypt_xn_impl(keys, rounds, blocks, std::make_index_sequence<N>{});
+	}
+
+	template<size_t N>
+	static inline void decrypt_xn(const __m128i keys[15], size_t rounds, __m128i blocks[N]) noexcept
+	{
+		decrypt_xn_impl(keys, rounds, blocks, std::make_index_sequence<N>{});
+	}
+
+	// Big-endian 128-bit counter block, incremented either as a whole or in its last 32 bits only
+	struct counter_block
+	{
+		uint64_t hi;
+		uint64_t lo;
+		bool inc32;
+
+		counter_block(const uint8_t counter[16], bool inc32) noexcept
+			: hi(bit::read_be<uint64_t>(counter)), lo(bit::read_be<uint64_t>(counter + 8)), inc32(inc32)
+		{
+		}
+
+		[[nodiscard]] __m128i next() noexcept
+		{
+			const __m128i block = byte_swap(_mm_set_epi64x(static_cast<long long>(hi), static_cast<long long>(lo)));
+
+			if (inc32)
+				lo = (lo & 0xFFFFFFFF00000000ull) | static_cast<uint32_t>(lo + 1);
+			else if (++lo == 0)
+				hi++;
+
+			return block;
+		}
+
+		void store(uint8_t counter[16]) const noexcept
+		{
+			bit::write_be(counter, hi);
+			bit::write_be(counter + 8, lo);
+		}
+	};
+
+	// 256-bit carry-less product of two byte-reflected field elements
+	static inline void clmul(__m128i a, __m128i b, __m128i& lo, __m128i& hi) noexcept
+	{
+		const __m128i mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+
+		lo = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x00), _mm_slli_si128(mid, 8));
+		hi = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x11), _mm_srli_si128(mid, 8));
+	}
+
+	// Reduces a 256-bit carry-less product modulo x^128 + x^7 + x^2 + x + 1
+	// The reduction is linear, so the sum of several products can be reduced at once
+	[[nodiscard]] static inline __m128i reduce(__m128i lo, __m128i hi) noexcept
+	{
+		// Shift the product left by one bit to account for the bit-reflected representation
+		__m128i carry_lo = _mm_srli_epi32(lo, 31);
+		__m128i carry_hi = _mm_srli_epi32(hi, 31);
+
+		lo = _mm_slli_epi32(lo, 1);
+		hi = _mm_slli_epi32(hi, 1);
+
+		const __m128i carry_mid = _mm_srli_si128(carry_lo, 12);
+		carry_hi = _mm_slli_si128(carry_hi, 4);
+		carry_lo = _mm_slli_si128(carry_lo, 4);
+
+		lo = _mm_or_si128(lo, carry_lo);
+		hi = _mm_or_si128(_mm_or_si128(hi, carry_hi), carry_mid);
+
+		// First phase of the reduction
+		__m128i temp = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)), _mm_slli_epi32(lo, 25));
+		const __m128i rest = _mm_srli_si128(temp, 4);
+		lo = _mm_xor_si128(lo, _mm_slli_si128(temp, 12));
+
+		// Second phase of the reduction
+		temp = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)), _mm_srli_epi32(lo, 7));
+		temp = _mm_xor_si128(temp, rest);
+
+		return _mm_xor_si128(hi, _mm_xor_si128(lo, temp));
+	}
+
+	[[nodiscard]] static inline __m128i gf_mul(__m128i a, __m128i b) noexcept
+	{
+		__m128i lo, hi;
+		clmul(a, b, lo, hi);
+		return reduce(lo, hi);
+	}
+
+	// Absorbs N byte-reflected blocks into y with a single reduction: y = (y + x[0]) * H^N + x[1] * H^(N - 1) + ... + x[N - 1] * H
+	template<size_t N, size_t... I>
+	[[nodiscard]] static inline __m128i ghash_xn_impl(const __m128i h[PIPELINE], __m128i y, const __m128i x[N], std::index_sequence<I...>) noexcept
+	{
+		__m128i lo[N], hi[N];
+
+		clmul(_mm_xor_si128(y, x[0]), h[N - 1], lo[0], hi[0]);
+		(clmul(x[I + 1], h[N - 2 - I], lo[I + 1], hi[I + 1]), ...);
+
+		((lo[0] = _mm_xor_si128(lo[0], lo[I + 1])), ...);
+		((hi[0] = _mm_xor_si128(hi[0], hi[I + 1])), ...);
+
+		return reduce(lo[0], hi[0]);
+	}
+
+	template<size_t N>
+	[[nodiscard]] static inline __m128i ghash_xn(const __m128i h[PIPELINE], __m128i y, const __m128i x[N]) noexcept
+	{
+		return ghash_xn_impl<N>(h, y, x, std::make_index_sequence<N - 1>{});
+	}
+
+	[[nodiscard]] static inline __m128i load_partial(const uint8_t* data, size_t size) noexcept
+	{
+		uint8_t block[16]{ 0 };
+		std::memcpy(block, data, size);
+		return _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+	}
+
+	static inline void store_partial(uint8_t* data, size_t size, __m128i value) noexcept
+	{
+		uint8_t block[16];
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(block), value);
+		std::memcpy(data, block, size);
+	}
+
+	void _aesni_inverse_round_keys(const uint8_t* round_keys, size_t rounds, uint8_t* inv_round_keys) noexcept
+	{
+		const __m128i* keys = reinterpret_cast<const __m128i*>(round_keys);
+		__m128i* inv_keys = reinterpret_cast<__m128i*>(inv_round_keys);
+
+		_mm_storeu_si128(inv_keys, _mm_loadu_si128(keys + rounds));
+
+		for (size_t r = 1; r < rounds; r++)
+			_mm_storeu_si128(inv_keys + r, _mm_aesimc_si128(_mm_loadu_si128(keys + rounds - r)));
+
+		_mm_storeu_si128(inv_keys + rounds, _mm_loadu_si128(keys));
+	}
+
+	void _aesni_encrypt_blocks(const uint8_t* round_keys, size_t rounds, const uint8_t* in, uint8_t* out, size_t count) noexcept
+	{
+		__m128i keys[15];
+		load_round_keys(round_keys, rounds, keys);
+
+		const __m128i* src = reinterpret_cast<const __m128i*>(in);
+		__m128i* dest = reinterpret_cast<__m128i*>(out);
+
+		for (; count >= PIPELINE; count -= PIPELINE, src += PIPELINE, dest += PIPELINE)
+		{
+			__m128i blocks[PIPELINE];
+
+			for (size_t i = 0; i < PIPELINE; i++)
+				blocks[i] = _mm_loadu_si128(src + i);
+
+			encrypt_xn<PIPELINE>(keys, rounds, blocks);
+
+			for (size_t i = 0; i < PIPELINE; i++)
+				_mm_storeu_si128(dest + i, blocks[i]);
+		}
+
+		for (; count > 0; count--, src++, dest++)
+		{
+			__m128i block = _mm_loadu_si128(src);
+			encrypt_xn<1>(keys, rounds, &block);
+			_mm_storeu_si128(dest, block);
+		}
+	}
+
+	void _aesni_decrypt_blocks(const uint8_t* inv_round_keys, size_t rounds, const uint8_t* in, uint8_t* out, size_t count) noexcept
+	{
+		__m128i keys[15];
+		load_round_keys(inv_round_keys, rounds, keys);
+
+		const __m128i* src = reinterpret_cast<const __m128i*>(in);
+		__m128i* dest = reinterpret_cast<__m128i*>(out);
+
+		for (; count >= PIPELINE; count -= PIPELINE, src += PIPELINE, dest += PIPELINE)
+		{
+			__m128i blocks[PIPELINE];
+
+			for (size_t i = 0; i < PIPELINE; i++)
+				blocks[i] = _mm_loadu_si128(src + i);
+
+			decrypt_xn<PIPELINE>(keys, rounds, blocks);
+
+			for (size_t i = 0; i < PIPELINE; i++)
+				_mm_storeu_si128(dest + i, blocks[i]);
+		}
+
+		for (; count > 0; count--, src++, dest++)
+		{
+			__m128i block = _mm_loadu_si128(src);
+			decrypt_xn<1>(keys, rounds, &block);
+			_mm_storeu_si128(dest, block);
+		}
+	}
+
+	void _aesni_ctr(const uint8_t* round_keys, size_t rounds, uint8_t counter[16], bool inc32, uint8_t* data, size_t size) noexcept
+	{
+		__m128i keys[15];
+		load_round_keys(round_keys, rounds, keys);
+
+		counter_block ctr(counter, inc32);
+		__m128i* block = reinterpret_cast<__m128i*>(data);
+
+		for (; size >= PIPELINE * 16; size -= PIPELINE * 16, block += PIPELINE)
+		{
+			__m128i stream[PIPELINE];
+
+			for (size_t i = 0; i < PIPELINE; i++)
+				stream[i] = ctr.next();
+
+			encrypt_xn<PIPELINE>(keys, rounds, stream);
+
+			for (size_t i = 0; i < PIPELINE; i++)
+				_mm_storeu_si128(block + i, _mm_xor_si128(_mm_loadu_si128(block + i), stream[i]));
+		}
+
+		for (; size > 0; size -= std::min<size_t>(size, 16), block++)
+		{
+			__m128i stream = ctr.next();
+			encrypt_xn<1>(keys, rounds, &stream);
+
+			if (size >= 16)
+				_mm_storeu_si128(block, _mm_xor_si128(_mm_loadu_si128(block), stream));
+			else
+			{
+				uint8_t* bytes = reinterpret_cast<uint8_t*>(block);
+				store_partial(bytes, size, _mm_xor_si128(load_partial(bytes, size), stream));
+			}
+		}
+
+		ctr.store(counter);
+	}
+
+	void _clmul_ghash_keys(const uint8_t h[16], uint8_t h_powers[8][16]) noexcept
+	{
+		const __m128i h1 = byte_swap(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h)));
+		__m128i power = h1;
+
+		for (size_t i = 0; i < PIPELINE; i++)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(h_powers[i]), power);
+			power = gf_mul(power, h1);
+		}
+	}
+
+	void _clmul_ghash(const uint8_t h_powers[8][16], uint8_t y[16], const uint8_t* data, size_t size) noexcept
+	{
+		__m128i h[PIPELINE];
+
+		for (size_t i = 0; i < PIPELINE; i++)
+			h[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h_powers[i]));
+
+		__m128i state = byte_swap(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y)));
+		const __m128i* block = reinterpret_cast<const __m128i*>(data);
+
+		for (; size >= PIPELINE * 16; size -= PIPELINE * 16, block += PIPELINE)
+		{
+			__m128i x[PIPELINE];
+
+			for (size_t i = 0; i < PIPELINE; i++)
+				x[i] = byte_swap(_mm_loadu_si128(block + i));
+
+			state = ghash_xn<PIPELINE>(h, state, x);
+		}
+
+		for (; size >= 16; size -= 16, block++)
+			state = gf_mul(_mm_xor_si128(state, byte_swap(_mm_loadu_si128(block))), h[0]);
+
+		if (size > 0)
+			state = gf_mul(_mm_xor_si128(state, byte_swap(load_partial(reinterpret_cast<const uint8_t*>(block), size))), h[0]);
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(y), byte_swap(state));
+	}
+
+	void _aesni_gcm(const uint8_t* round_keys, size_t rounds, const uint8_t h_powers[8][16], uint8_t counter[16], uint8_t y[16], uint8_t* data, size_t size, bool encrypt) noexcept
+	{
+		__m128i keys[15];
+		load_round_keys(round_keys, rounds, keys);
+
+		__m128i h[PIPELINE];
+
+		for (size_t i = 0; i < PIPELINE; i++)
+			h[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h_powers[i]));
+
+		counter_block ctr(counter, true);
+		__m128i state = byte_swap(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y)));
+		__m128i* block = reinterpret_cast<__m128i*>(data);
+
+		// Authentication always covers the ciphertext: it is hashed after encryption and before decryption
+		for (; size >= PIPELINE * 16; size -= PIPELINE * 16, block += PIPELINE)
+		{
+			__m128i stream[PIPELINE], x[PIPELINE];
+
+			for (size_t i = 0; i < PIPELINE; i++)
+				stream[i] = ctr.next();
+
+			encrypt_xn<PIPELINE>(keys, rounds, stream);
+
+			for (size_t i = 0; i < PIPELINE; i++)
+			{
+				const __m128i in = _mm_loadu_si128(block + i);
+				const __m128i out = _mm_xor_si128(in, stream[i]);
+
+				_mm_storeu_si128(block + i, out);
+				x[i] = byte_swap(encrypt ? out : in);
+			}
+
+			state = ghash_xn<PIPELINE>(h, state, x);
+		}
+
+		for (; size > 0; size -= std::min<size_t>(size, 16), block++)
+		{
+			__m128i stream = ctr.next();
+			encrypt_xn<1>(keys, rounds, &stream);
+
+			if (size >= 16)
+			{
+				const __m128i in = _mm_loadu_si128(block);
+				const __m128i out = _mm_xor_si128(in, stream);
+
+				_mm_storeu_si128(block, out);
+				state = gf_mul(_mm_xor_si128(state, byte_swap(encrypt ? out : in)), h[0]);
+			}
+			else
+			{
+				uint8_t* bytes = reinterpret_cast<uint8_t*>(block);
+				const __m128i in = load_partial(bytes, size);
+				__m128i out = _mm_xor_si128(in, stream);
+
+				store_partial(bytes, size, out);
+				out = load_partial(bytes, size);
+
+				state = gf_mul(_mm_xor_si128(state, byte_swap(encrypt ? out : in)), h[0]);
+			}
+		}
+
+		ctr.store(counter);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(y), byte_swap(state));
+	}
+}
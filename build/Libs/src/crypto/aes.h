@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstring>
 #include <vector>
 #include <algorithm>
 #include <sstream>
@@ -8,6 +9,8 @@
 #include "bit/endian.h"
 #include "bit/rotate.h"
 
+#include "intrin/cpu.h"
+
 #include "crypto/basic_cipher.h"
 
 namespace rb::crypto
@@ -50,333 +53,343 @@ namespace rb::crypto
 		{ 0x17, 0x2B, 0x04, 0x7E, 0xBA, 0x77, 0xD6, 0x26, 0xE1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0C, 0x7D }
 	};
 
-	template<cipher_mode M, size_t K, size_t B, size_t R>
-	class aes : public basic_cipher
+	// AES-NI and PCLMULQDQ implementation of 128-bit block operations, defined in aes.cpp
+	void _aesni_inverse_round_keys(const uint8_t* round_keys, size_t rounds, uint8_t* inv_round_keys) noexcept;
+	void _aesni_encrypt_blocks(const uint8_t* round_keys, size_t rounds, const uint8_t* in, uint8_t* out, size_t count) noexcept;
+	void _aesni_decrypt_blocks(const uint8_t* inv_round_keys, size_t rounds, const uint8_t* in, uint8_t* out, size_t count) noexcept;
+	void _aesni_ctr(const uint8_t* round_keys, size_t rounds, uint8_t counter[16], bool inc32, uint8_t* data, size_t size) noexcept;
+	void _clmul_ghash_keys(const uint8_t h[16], uint8_t h_powers[8][16]) noexcept;
+	void _clmul_ghash(const uint8_t h_powers[8][16], uint8_t y[16], const uint8_t* data, size_t size) noexcept;
+	void _aesni_gcm(const uint8_t* round_keys, size_t rounds, const uint8_t h_powers[8][16], uint8_t counter[16], uint8_t y[16], uint8_t* data, size_t size, bool encrypt) noexcept;
+
+	// Expanded key schedule, computed once and reused for any number of messages
+	// Operations on 128-bit blocks use AES-NI and PCLMULQDQ when the processor supports them
+	template<size_t K, size_t B, size_t R>
+	class aes_key
 	{
 	public:
-		static constexpr cipher_mode MODE = M;
-
 		static constexpr size_t KEY_SIZE = K * 32;
 		static constexpr size_t BLOCK_SIZE = B * 4 * 8;
 		static constexpr size_t ROUNDS = R;
 
-		static_assert(M == cipher_mode::ECB || 
-			M == cipher_mode::CBC || 
-			M == cipher_mode::PCBC, "cipher mode is not implemented");
-
 	public:
-		aes() noexcept
+		aes_key() noexcept
 		{
-			clear();
+			const uint8_t key[K * 4]{ 0 };
+			set_key(key, K * 4);
 		}
 
-		aes& write(const void* data, size_t size) noexcept override
+		aes_key(const void* key, size_t size) noexcept
 		{
-			std::copy_n(reinterpret_cast<const uint8_t*>(data), size, std::back_inserter(m_data));
-			return *this;
+			set_key(key, size);
 		}
 
-		size_t encrypt(const void* key, size_t size, void* dest) noexcept override
+		void set_key(const void* key, size_t size) noexcept
 		{
-			const size_t digest_size = m_data.size();
 			uint32_t w[B * (R + 1)];
 			uint8_t real_key[K * 4]{ 0 };
 
 			std::memcpy(real_key, key, std::min(size, K * 4));
 			key_expansion(real_key, w);
 
-			pad_data();
+			for (size_t i = 0; i < B * (R + 1); i++)
+				bit::write_be(m_round_keys + i * 4, w[i]);
 
-			if constexpr (M == cipher_mode::ECB)
-			{
-				for (size_t i = 0; i < m_data.size(); i += B * 4)
-					cipher(m_data.data() + i, reinterpret_cast<uint8_t*>(dest) + i, w);
-			}
-			else if constexpr (M == cipher_mode::CBC)
-			{
-				uint8_t v[B * 4]{ 0 };
-
-				for (size_t i = 0; i < digest_size; i += B * 4)
-				{
-					uint8_t in[B * 4];
-					std::memcpy(in, m_data.data() + i, B * 4);
+			m_aesni = B == 4 && intrin::cpu().aes;
+			m_clmul = m_aesni && intrin::cpu().pclmulqdq;
 
-					for (size_t j = 0; j < B * 4; j++)
-						in[j] ^= v[j];
-
-					cipher(in, v, w);
+			if (m_aesni)
+				_aesni_inverse_round_keys(m_round_keys, R, m_inv_round_keys);
 
-					std::memcpy(reinterpret_cast<uint8_t*>(dest) + i, v, B * 4);
-				}
-			}
-			else if constexpr (M == cipher_mode::PCBC)
+			if constexpr (B == 4)
 			{
-				uint8_t v[B * 4]{ 0 };
-
-				for (size_t i = 0; i < digest_size; i += B * 4)
-				{
-					uint8_t in[B * 4];
-					std::memcpy(in, m_data.data() + i, B * 4);
-
-					for (size_t j = 0; j < B * 4; j++)
-						in[j] ^= v[j];
+				const uint8_t zero[16]{ 0 };
+				encrypt_block(zero, m_h);
 
-					cipher(in, v, w);
+				if (m_clmul)
+					_clmul_ghash_keys(m_h, m_h_powers);
+			}
+		}
 
-					std::memcpy(reinterpret_cast<uint8_t*>(dest) + i, v, B * 4);
+		// Falls back to the portable implementation until the next `set_key`, even if AES-NI is available,
+		// so that tests can check both implementations on the same machine
+		void _disable_aesni() noexcept
+		{
+			m_aesni = false;
+			m_clmul = false;
+		}
 
-					for (size_t j = 0; j < B * 4; j++)
-						v[j] ^= m_data[i + j];
-				}
-			}
+		void encrypt_block(const void* in, void* out) const noexcept
+		{
+			encrypt_blocks(in, out, 1);
+		}
 
-			return m_data.size();
+		void decrypt_block(const void* in, void* out) const noexcept
+		{
+			decrypt_blocks(in, out, 1);
 		}
 
-		size_t decrypt(const void* key, size_t size, void* dest) noexcept override
+		void encrypt_blocks(const void* in, void* out, size_t count) const noexcept
 		{
-			const size_t digest_size = m_data.size();
-			uint32_t w[B * (R + 1)];
-			uint8_t real_key[K * 4]{ 0 };
+			const uint8_t* src = reinterpret_cast<const uint8_t*>(in);
+			uint8_t* dest = reinterpret_cast<uint8_t*>(out);
 
-			std::memcpy(real_key, key, std::min(size, K * 4));
-			key_expansion(real_key, w);
+			if (m_aesni)
+				_aesni_encrypt_blocks(m_round_keys, R, src, dest, count);
+			else
+				for (size_t i = 0; i < count; i++)
+					cipher(src + i * B * 4, dest + i * B * 4);
+		}
 
-			if constexpr (M == cipher_mode::ECB)
-			{
-				for (size_t i = 0; i < digest_size; i += B * 4)
-					inv_cipher(m_data.data() + i, reinterpret_cast<uint8_t*>(dest) + i, w);
-			}
-			else if constexpr (M == cipher_mode::CBC)
-			{
-				uint8_t v[B * 4]{ 0 };
+		void decrypt_blocks(const void* in, void* out, size_t count) const noexcept
+		{
+			const uint8_t* src = reinterpret_cast<const uint8_t*>(in);
+			uint8_t* dest = reinterpret_cast<uint8_t*>(out);
 
-				for (size_t i = 0; i < digest_size; i += B * 4)
-				{
-					uint8_t out[B * 4];
-					inv_cipher(m_data.data() + i, out, w);
+			if (m_aesni)
+				_aesni_decrypt_blocks(m_inv_round_keys, R, src, dest, count);
+			else
+				for (size_t i = 0; i < count; i++)
+					inv_cipher(src + i * B * 4, dest + i * B * 4);
+		}
 
-					for (size_t j = 0; j < B * 4; j++)
-						out[j] ^= v[j];
+		// Encrypts or decrypts data in place in counter mode
+		// The counter block is incremented as a big-endian integer and is left pointing past the last block used
+		void ctr_crypt(uint8_t counter[B * 4], void* data, size_t size) const noexcept
+		{
+			ctr(counter, false, reinterpret_cast<uint8_t*>(data), size);
+		}
 
-					std::memcpy(reinterpret_cast<uint8_t*>(dest) + i, out, B * 4);
-					std::memcpy(v, m_data.data() + i, B * 4);
-				}
-			}
-			else if constexpr (M == cipher_mode::PCBC)
-			{
-				uint8_t v[B * 4]{ 0 };
+		// Encrypts data in place in Galois/Counter Mode and writes the 16 byte authentication tag
+		void gcm_encrypt(const void* iv, size_t iv_size, const void* aad, size_t aad_size, void* data, size_t size, void* tag) const noexcept
+		{
+			static_assert(B == 4, "GCM requires 128-bit blocks");
 
-				for (size_t i = 0; i < digest_size; i += B * 4)
-				{
-					uint8_t out[B * 4];
-					inv_cipher(m_data.data() + i, out, w);
+			uint8_t* bytes = reinterpret_cast<uint8_t*>(data);
+			uint8_t j0[16], y[16], counter[16];
 
-					for (size_t j = 0; j < B * 4; j++)
-						out[j] ^= v[j];
+			gcm_init(iv, iv_size, aad, aad_size, j0, y);
 
-					std::memcpy(reinterpret_cast<uint8_t*>(dest) + i, out, B * 4);
+			std::memcpy(counter, j0, 16);
+			increment(counter, true);
 
-					for (size_t j = 0; j < B * 4; j++)
-						v[j] = out[j] ^ m_data[i + j];
-				}
+			if (m_clmul)
+				_aesni_gcm(m_round_keys, R, m_h_powers, counter, y, bytes, size, true);
+			else
+			{
+				ctr(counter, true, bytes, size);
+				ghash(y, bytes, size);
 			}
 
-			return digest_size;
+			gcm_tag(j0, y, aad_size, size, reinterpret_cast<uint8_t*>(tag));
 		}
 
-		[[nodiscard]] std::string hex_encrypt(const void* key, size_t size) noexcept override
+		// Decrypts data in place in Galois/Counter Mode
+		// If the authentication tag does not match, the data is zeroed and false is returned
+		[[nodiscard]] bool gcm_decrypt(const void* iv, size_t iv_size, const void* aad, size_t aad_size, void* data, size_t size, const void* tag) const noexcept
 		{
-			const size_t digest_size = padded_size();
-			uint8_t* digest = new uint8_t[digest_size];
-			encrypt(key, size, digest);
+			static_assert(B == 4, "GCM requires 128-bit blocks");
 
-			std::stringstream hex_digest;
+			uint8_t* bytes = reinterpret_cast<uint8_t*>(data);
+			uint8_t j0[16], y[16], counter[16], expected[16];
 
-			for (size_t i = 0; i < digest_size; i++)
-				hex_digest << std::setw(2) << std::setfill('0') << std::hex << static_cast<uint32_t>(digest[i]);
+			gcm_init(iv, iv_size, aad, aad_size, j0, y);
 
-			delete[] digest;
+			std::memcpy(counter, j0, 16);
+			increment(counter, true);
 
-			return hex_digest.str();
-		}
+			if (m_clmul)
+				_aesni_gcm(m_round_keys, R, m_h_powers, counter, y, bytes, size, false);
+			else
+			{
+				ghash(y, bytes, size);
+				ctr(counter, true, bytes, size);
+			}
 
-		[[nodiscard]] std::string hex_decrypt(const void* key, size_t size) noexcept override
-		{
-			const size_t digest_size = m_data.size();
-			uint8_t* digest = new uint8_t[digest_size];
-			decrypt(key, size, digest);
+			gcm_tag(j0, y, aad_size, size, expected);
 
-			std::stringstream hex_digest;
+			uint8_t diff = 0;
 
-			for (size_t i = 0; i < digest_size; i++)
-				hex_digest << std::setw(2) << std::setfill('0') << std::hex << static_cast<uint32_t>(digest[i]);
+			for (size_t i = 0; i < 16; i++)
+				diff |= expected[i] ^ reinterpret_cast<const uint8_t*>(tag)[i];
 
-			delete[] digest;
+			if (diff != 0)
+			{
+				std::memset(bytes, 0, size);
+				return false;
+			}
 
-			return hex_digest.str();
+			return true;
 		}
 
-		void clear() noexcept override
-		{
-			m_data.clear();
-			std::memset(m_state, 0, B * 4);
-		}
+	private:
+		uint8_t m_round_keys[(R + 1) * B * 4];
+		uint8_t m_inv_round_keys[(R + 1) * B * 4];
+		uint8_t m_h[16];
+		uint8_t m_h_powers[8][16];
+		bool m_aesni;
+		bool m_clmul;
 
-		aes& operator<<(char value) noexcept override
+		static void increment(uint8_t counter[B * 4], bool inc32) noexcept
 		{
-			m_data.push_back(value);
-			return *this;
+			for (size_t i = B * 4; i > (inc32 ? B * 4 - 4 : 0); i--)
+				if (++counter[i - 1] != 0)
+					break;
 		}
 
-		aes& operator<<(unsigned char value) noexcept override
+		void ctr(uint8_t counter[B * 4], bool inc32, uint8_t* data, size_t size) const noexcept
 		{
-			m_data.push_back(value);
-			return *this;
-		}
+			if (m_aesni)
+			{
+				_aesni_ctr(m_round_keys, R, counter, inc32, data, size);
+				return;
+			}
 
-		aes& operator<<(short value) noexcept override
-		{
-			uint8_t bytes[sizeof(short)];
-			bit::write_be(bytes, value);
-			write(bytes, sizeof(short));
-			return *this;
-		}
+			for (size_t i = 0; i < size; i += B * 4)
+			{
+				uint8_t stream[B * 4];
+				cipher(counter, stream);
+				increment(counter, inc32);
 
-		aes& operator<<(unsigned short value) noexcept override
-		{
-			uint8_t bytes[sizeof(unsigned short)];
-			bit::write_be(bytes, value);
-			write(bytes, sizeof(unsigned short));
-			return *this;
+				for (size_t j = 0; j < B * 4 && i + j < size; j++)
+					data[i + j] ^= stream[j];
+			}
 		}
 
-		aes& operator<<(int value) noexcept override
+		// Multiplication in GF(2^128) as defined by GCM
+		static void gf_mul(uint8_t x[16], const uint8_t h[16]) noexcept
 		{
-			uint8_t bytes[sizeof(int)];
-			bit::write_be(bytes, value);
-			write(bytes, sizeof(int));
-			return *this;
-		}
+			uint64_t z_hi = 0, z_lo = 0;
+			uint64_t v_hi = bit::read_be<uint64_t>(h);
+			uint64_t v_lo = bit::read_be<uint64_t>(h + 8);
 
-		aes& operator<<(unsigned int value) noexcept override
-		{
-			uint8_t bytes[sizeof(unsigned int)];
-			bit::write_be(bytes, value);
-			write(bytes, sizeof(unsigned int));
-			return *this;
-		}
+			for (size_t i = 0; i < 128; i++)
+			{
+				if ((x[i / 8] >> (7 - i % 8)) & 1)
+				{
+					z_hi ^= v_hi;
+					z_lo ^= v_lo;
+				}
 
-		aes& operator<<(long value) noexcept override
-		{
-			uint8_t bytes[sizeof(long)];
-			bit::write_be(bytes, value);
-			write(bytes, sizeof(long));
-			return *this;
-		}
+				const bool lsb = v_lo & 1;
 
-		aes& operator<<(unsigned long value) noexcept override
-		{
-			uint8_t bytes[sizeof(unsigned long)];
-			bit::write_be(bytes, value);
-			write(bytes, sizeof(unsigned long));
-			return *this;
-		}
+				v_lo = (v_lo >> 1) | (v_hi << 63);
+				v_hi >>= 1;
 
-		aes& operator<<(long long value) noexcept override
-		{
-			uint8_t bytes[sizeof(long long)];
-			bit::write_be(bytes, value);
-			write(bytes, sizeof(long long));
-			return *this;
-		}
+				if (lsb)
+					v_hi ^= 0xE100000000000000ull;
+			}
 
-		aes& operator<<(unsigned long long value) noexcept override
-		{
-			uint8_t bytes[sizeof(unsigned long long)];
-			bit::write_be(bytes, value);
-			write(bytes, sizeof(unsigned long long));
-			return *this;
+			bit::write_be(x, z_hi);
+			bit::write_be(x + 8, z_lo);
 		}
 
-		aes& operator<<(const std::string& str) noexcept override
+		void ghash(uint8_t y[16], const void* data, size_t size) const noexcept
 		{
-			write(str.data(), str.size());
-			return *this;
-		}
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
 
-	private:
-		std::vector<uint8_t> m_data;
-		uint8_t m_state[4][B];
+			if (m_clmul)
+			{
+				_clmul_ghash(m_h_powers, y, bytes, size);
+				return;
+			}
 
-		size_t padded_size()
+			for (size_t i = 0; i < size; i += 16)
+			{
+				for (size_t j = 0; j < 16 && i + j < size; j++)
+					y[j] ^= bytes[i + j];
+
+				gf_mul(y, m_h);
+			}
+		}
+
+		void gcm_init(const void* iv, size_t iv_size, const void* aad, size_t aad_size, uint8_t j0[16], uint8_t y[16]) const noexcept
 		{
-			size_t s = m_data.size();
+			if (iv_size == 12)
+			{
+				std::memcpy(j0, iv, 12);
+				bit::write_be(j0 + 12, uint32_t(1));
+			}
+			else
+			{
+				uint8_t lengths[16]{ 0 };
+				bit::write_be(lengths + 8, static_cast<uint64_t>(iv_size) * 8);
 
-			while (s % (B * 4) != 0)
-				s++;
+				std::memset(j0, 0, 16);
+				ghash(j0, iv, iv_size);
+				ghash(j0, lengths, 16);
+			}
 
-			return s;
+			std::memset(y, 0, 16);
+			ghash(y, aad, aad_size);
 		}
 
-		void pad_data()
+		void gcm_tag(const uint8_t j0[16], uint8_t y[16], size_t aad_size, size_t size, uint8_t tag[16]) const noexcept
 		{
-			m_data.insert(m_data.end(), padded_size() - m_data.size(), 0);
+			uint8_t lengths[16];
+			bit::write_be(lengths, static_cast<uint64_t>(aad_size) * 8);
+			bit::write_be(lengths + 8, static_cast<uint64_t>(size) * 8);
+
+			ghash(y, lengths, 16);
+			encrypt_block(j0, tag);
+
+			for (size_t i = 0; i < 16; i++)
+				tag[i] ^= y[i];
 		}
 
-		void sub_bytes()
+		static void sub_bytes(uint8_t state[4][B]) noexcept
 		{
 			for (size_t i = 0; i < 4; i++)
 			{
 				for (size_t j = 0; j < B; j++)
 				{
-					uint8_t r = (m_state[i][j] >> 4) & 0xF;
-					uint8_t c = m_state[i][j] & 0xF;
+					uint8_t r = (state[i][j] >> 4) & 0xF;
+					uint8_t c = state[i][j] & 0xF;
 
-					m_state[i][j] = S_BOX[r][c];
+					state[i][j] = S_BOX[r][c];
 				}
 			}
 		}
 
-		void inv_sub_bytes()
+		static void inv_sub_bytes(uint8_t state[4][B]) noexcept
 		{
 			for (size_t i = 0; i < 4; i++)
 			{
 				for (size_t j = 0; j < B; j++)
 				{
-					uint8_t r = (m_state[i][j] >> 4) & 0xF;
-					uint8_t c = m_state[i][j] & 0xF;
+					uint8_t r = (state[i][j] >> 4) & 0xF;
+					uint8_t c = state[i][j] & 0xF;
 
-					m_state[i][j] = S_BOX_INV[r][c];
+					state[i][j] = S_BOX_INV[r][c];
 				}
 			}
 		}
 
-		void shift_rows()
+		static void shift_rows(uint8_t state[4][B]) noexcept
 		{
 			for (size_t i = 1; i < 4; i++)
 			{
 				uint8_t temp[B];
-				std::memcpy(temp, m_state[i], B);
+				std::memcpy(temp, state[i], B);
 
 				for (size_t j = 0; j < B; j++)
-					m_state[i][j] = temp[(j + i) % B];
+					state[i][j] = temp[(j + i) % B];
 			}
 		}
 
-		void inv_shift_rows()
+		static void inv_shift_rows(uint8_t state[4][B]) noexcept
 		{
 			for (size_t i = 1; i < 4; i++)
 			{
 				uint8_t temp[B];
-				std::memcpy(temp, m_state[i], B);
+				std::memcpy(temp, state[i], B);
 
 				for (size_t j = 0; j < B; j++)
-					m_state[i][j] = temp[(B - i + j) % B];
+					state[i][j] = temp[(B - i + j) % B];
 			}
 		}
 
-		uint8_t xtime(uint8_t b)
+		static uint8_t xtime(uint8_t b) noexcept
 		{
 			if (b & 0x80)
 			{
@@ -389,7 +402,7 @@ namespace rb::crypto
 			return b;
 		}
 
-		uint8_t mul_bytes(uint8_t a, uint8_t b)
+		static uint8_t mul_bytes(uint8_t a, uint8_t b) noexcept
 		{
 			uint8_t result = 0;
 
@@ -411,44 +424,40 @@ namespace rb::crypto
 			return result;
 		}
 
-		void mix_columns()
+		static void mix_columns(uint8_t state[4][B]) noexcept
 		{
 			for (size_t i = 0; i < B; i++)
 			{
-				uint8_t temp[4] = { m_state[0][i], m_state[1][i], m_state[2][i], m_state[3][i] };
+				uint8_t temp[4] = { state[0][i], state[1][i], state[2][i], state[3][i] };
 
-				m_state[0][i] = mul_bytes(2, temp[0]) ^ mul_bytes(3, temp[1]) ^ temp[2] ^ temp[3];
-				m_state[1][i] = temp[0] ^ mul_bytes(2, temp[1]) ^ mul_bytes(3, temp[2]) ^ temp[3];
-				m_state[2][i] = temp[0] ^ temp[1] ^ mul_bytes(2, temp[2]) ^ mul_bytes(3, temp[3]);
-				m_state[3][i] = mul_bytes(3, temp[0]) ^ temp[1] ^ temp[2] ^ mul_bytes(2, temp[3]);
+				state[0][i] = mul_bytes(2, temp[0]) ^ mul_bytes(3, temp[1]) ^ temp[2] ^ temp[3];
+				state[1][i] = temp[0] ^ mul_bytes(2, temp[1]) ^ mul_bytes(3, temp[2]) ^ temp[3];
+				state[2][i] = temp[0] ^ temp[1] ^ mul_bytes(2, temp[2]) ^ mul_bytes(3, temp[3]);
+				state[3][i] = mul_bytes(3, temp[0]) ^ temp[1] ^ temp[2] ^ mul_bytes(2, temp[3]);
 			}
 		}
 
-		void inv_mix_columns()
+		static void inv_mix_columns(uint8_t state[4][B]) noexcept
 		{
 			for (size_t i = 0; i < B; i++)
 			{
-				uint8_t temp[4] = { m_state[0][i], m_state[1][i], m_state[2][i], m_state[3][i] };
+				uint8_t temp[4] = { state[0][i], state[1][i], state[2][i], state[3][i] };
 
-				m_state[0][i] = mul_bytes(14, temp[0]) ^ mul_bytes(11, temp[1]) ^ mul_bytes(13, temp[2]) ^ mul_bytes(9, temp[3]);
-				m_state[1][i] = mul_bytes(9, temp[0]) ^ mul_bytes(14, temp[1]) ^ mul_bytes(11, temp[2]) ^ mul_bytes(13, temp[3]);
-				m_state[2][i] = mul_bytes(13, temp[0]) ^ mul_bytes(9, temp[1]) ^ mul_bytes(14, temp[2]) ^ mul_bytes(11, temp[3]);
-				m_state[3][i] = mul_bytes(11, temp[0]) ^ mul_bytes(13, temp[1]) ^ mul_bytes(9, temp[2]) ^ mul_bytes(14, temp[3]);
+				state[0][i] = mul_bytes(14, temp[0]) ^ mul_bytes(11, temp[1]) ^ mul_bytes(13, temp[2]) ^ mul_bytes(9, temp[3]);
+				state[1][i] = mul_bytes(9, temp[0]) ^ mul_bytes(14, temp[1]) ^ mul_bytes(11, temp[2]) ^ mul_bytes(13, temp[3]);
+				state[2][i] = mul_bytes(13, temp[0]) ^ mul_bytes(9, temp[1]) ^ mul_bytes(14, temp[2]) ^ mul_bytes(11, temp[3]);
+				state[3][i] = mul_bytes(11, temp[0]) ^ mul_bytes(13, temp[1]) ^ mul_bytes(9, temp[2]) ^ mul_bytes(14, temp[3]);
 			}
 		}
 
-		void add_round_key(uint32_t keys[B])
+		static void add_round_key(uint8_t state[4][B], const uint8_t keys[B * 4]) noexcept
 		{
 			for (size_t i = 0; i < B; i++)
-			{
-				m_state[0][i] ^= (keys[i] >> 24) & 0xFF;
-				m_state[1][i] ^= (keys[i] >> 16) & 0xFF;
-				m_state[2][i] ^= (keys[i] >> 8) & 0xFF;
-				m_state[3][i] ^= keys[i] & 0xFF;
-			}
+				for (size_t j = 0; j < 4; j++)
+					state[j][i] ^= keys[i * 4 + j];
 		}
 
-		uint32_t sub_word(uint32_t w)
+		static uint32_t sub_word(uint32_t w) noexcept
 		{
 			uint32_t result = 0;
 
@@ -460,12 +469,12 @@ namespace rb::crypto
 			return result;
 		}
 
-		uint32_t rot_word(uint32_t w)
+		static uint32_t rot_word(uint32_t w) noexcept
 		{
 			return (w << 8) | (w >> 24);
 		}
 
-		void key_expansion(const uint8_t key[K * 4], uint32_t w[B * (R + 1)])
+		static void key_expansion(const uint8_t key[K * 4], uint32_t w[B * (R + 1)]) noexcept
 		{
 			uint32_t temp;
 			size_t i = 0;
@@ -495,58 +504,437 @@ namespace rb::crypto
 			}
 		}
 
-		void cipher(const uint8_t in[B * 4], uint8_t out[B * 4], uint32_t w[B * (R + 1)])
+		void cipher(const uint8_t in[B * 4], uint8_t out[B * 4]) const noexcept
 		{
+			uint8_t state[4][B];
+
 			for (size_t i = 0; i < 4; i++)
 				for (size_t j = 0; j < B; j++)
-					m_state[i][j] = in[j * 4 + i];
+					state[i][j] = in[j * 4 + i];
 
-			add_round_key(w);
+			add_round_key(state, m_round_keys);
 
 			for (size_t r = 1; r < R; r++)
 			{
-				sub_bytes();
-				shift_rows();
-				mix_columns();
-				add_round_key(w + (r * B));
+				sub_bytes(state);
+				shift_rows(state);
+				mix_columns(state);
+				add_round_key(state, m_round_keys + r * B * 4);
 			}
 
-			sub_bytes();
-			shift_rows();
-			add_round_key(w + (R * B));
+			sub_bytes(state);
+			shift_rows(state);
+			add_round_key(state, m_round_keys + R * B * 4);
 
 			for (size_t i = 0; i < 4; i++)
 				for (size_t j = 0; j < B; j++)
-					out[j * 4 + i] = m_state[i][j];
+					out[j * 4 + i] = state[i][j];
 		}
 
-		void inv_cipher(const uint8_t in[B * 4], uint8_t out[B * 4], uint32_t w[B * (R + 1)])
+		void inv_cipher(const uint8_t in[B * 4], uint8_t out[B * 4]) const noexcept
 		{
+			uint8_t state[4][B];
+
 			for (size_t i = 0; i < 4; i++)
 				for (size_t j = 0; j < B; j++)
-					m_state[i][j] = in[j * 4 + i];
+					state[i][j] = in[j * 4 + i];
 
-			add_round_key(w + (R * B));
+			add_round_key(state, m_round_keys + R * B * 4);
 
 			for (size_t r = R - 1; r > 0; r--)
 			{
-				inv_shift_rows();
-				inv_sub_bytes();
-				add_round_key(w + (r * B));
-				inv_mix_columns();
+				inv_shift_rows(state);
+				inv_sub_bytes(state);
+				add_round_key(state, m_round_keys + r * B * 4);
+				inv_mix_columns(state);
 			}
 
-			inv_shift_rows();
-			inv_sub_bytes();
-			add_round_key(w);
+			inv_shift_rows(state);
+			inv_sub_bytes(state);
+			add_round_key(state, m_round_keys);
 
 			for (size_t i = 0; i < 4; i++)
 				for (size_t j = 0; j < B; j++)
-					out[j * 4 + i] = m_state[i][j];
+					out[j * 4 + i] = state[i][j];
+		}
+	};
+
+	template<cipher_mode M, size_t K, size_t B, size_t R>
+	class aes : public basic_cipher
+	{
+	public:
+		static constexpr cipher_mode MODE = M;
+
+		static constexpr size_t KEY_SIZE = K * 32;
+		static constexpr size_t BLOCK_SIZE = B * 4 * 8;
+		static constexpr size_t TAG_SIZE = M == cipher_mode::GCM ? 128 : 0;
+		static constexpr size_t ROUNDS = R;
+
+		static_assert(M == cipher_mode::ECB || 
+			M == cipher_mode::CBC || 
+			M == cipher_mode::PCBC ||
+			M == cipher_mode::CTR ||
+			M == cipher_mode::GCM, "cipher mode is not implemented");
+
+		static_assert(M != cipher_mode::GCM || B == 4, "GCM requires 128-bit blocks");
+
+	public:
+		aes() noexcept
+			: m_key_data{ 0 }
+		{
+			clear();
+		}
+
+		aes& write(const void* data, size_t size) noexcept override
+		{
+			std::copy_n(reinterpret_cast<const uint8_t*>(data), size, std::back_inserter(m_data));
+			return *this;
+		}
+
+		// Sets the initialization vector of CBC and PCBC, the initial counter block of CTR or the nonce of GCM
+		aes& set_iv(const void* data, size_t size) noexcept
+		{
+			m_iv.assign(reinterpret_cast<const uint8_t*>(data), reinterpret_cast<const uint8_t*>(data) + size);
+
+			if constexpr (M != cipher_mode::GCM)
+				m_iv.resize(B * 4, 0);
+
+			return *this;
+		}
+
+		// Sets the additional authenticated data of GCM
+		aes& set_aad(const void* data, size_t size) noexcept
+		{
+			m_aad.assign(reinterpret_cast<const uint8_t*>(data), reinterpret_cast<const uint8_t*>(data) + size);
+			return *this;
+		}
+
+		size_t encrypt(const void* key, size_t size, void* dest) noexcept override
+		{
+			const aes_key<K, B, R>& w = expand_key(key, size);
+			uint8_t* out = reinterpret_cast<uint8_t*>(dest);
+
+			if constexpr (M == cipher_mode::CTR)
+			{
+				uint8_t counter[B * 4];
+				std::memcpy(counter, m_iv.data(), B * 4);
+
+				std::copy(m_data.begin(), m_data.end(), out);
+				w.ctr_crypt(counter, out, m_data.size());
+
+				return m_data.size();
+			}
+			else if constexpr (M == cipher_mode::GCM)
+			{
+				std::copy(m_data.begin(), m_data.end(), out);
+				w.gcm_encrypt(m_iv.data(), m_iv.size(), m_aad.data(), m_aad.size(), out, m_data.size(), out + m_data.size());
+
+				return m_data.size() + TAG_SIZE / 8;
+			}
+			else
+			{
+				const size_t digest_size = m_data.size();
+
+				pad_data();
+
+				if constexpr (M == cipher_mode::ECB)
+				{
+					w.encrypt_blocks(m_data.data(), out, m_data.size() / (B * 4));
+				}
+				else if constexpr (M == cipher_mode::CBC)
+				{
+					uint8_t v[B * 4];
+					std::memcpy(v, m_iv.data(), B * 4);
+
+					for (size_t i = 0; i < digest_size; i += B * 4)
+					{
+						uint8_t in[B * 4];
+						std::memcpy(in, m_data.data() + i, B * 4);
+
+						for (size_t j = 0; j < B * 4; j++)
+							in[j] ^= v[j];
+
+						w.encrypt_block(in, v);
+
+						std::memcpy(out + i, v, B * 4);
+					}
+				}
+				else if constexpr (M == cipher_mode::PCBC)
+				{
+					uint8_t v[B * 4];
+					std::memcpy(v, m_iv.data(), B * 4);
+
+					for (size_t i = 0; i < digest_size; i += B * 4)
+					{
+						uint8_t in[B * 4];
+						std::memcpy(in, m_data.data() + i, B * 4);
+
+						for (size_t j = 0; j < B * 4; j++)
+							in[j] ^= v[j];
+
+						w.encrypt_block(in, v);
+
+						std::memcpy(out + i, v, B * 4);
+
+						for (size_t j = 0; j < B * 4; j++)
+							v[j] ^= m_data[i + j];
+					}
+				}
+
+				return m_data.size();
+			}
+		}
+
+		size_t decrypt(const void* key, size_t size, void* dest) noexcept override
+		{
+			const aes_key<K, B, R>& w = expand_key(key, size);
+			const size_t digest_size = m_data.size();
+			uint8_t* out = reinterpret_cast<uint8_t*>(dest);
+
+			if constexpr (M == cipher_mode::CTR)
+			{
+				uint8_t counter[B * 4];
+				std::memcpy(counter, m_iv.data(), B * 4);
+
+				std::copy(m_data.begin(), m_data.end(), out);
+				w.ctr_crypt(counter, out, digest_size);
+			}
+			else if constexpr (M == cipher_mode::GCM)
+			{
+				if (digest_size < TAG_SIZE / 8)
+					return 0;
+
+				const size_t plain_size = digest_size - TAG_SIZE / 8;
+
+				std::copy_n(m_data.begin(), plain_size, out);
+
+				if (!w.gcm_decrypt(m_iv.data(), m_iv.size(), m_aad.data(), m_aad.size(), out, plain_size, m_data.data() + plain_size))
+					return 0;
+
+				return plain_size;
+			}
+			else if constexpr (M == cipher_mode::ECB)
+			{
+				w.decrypt_blocks(m_data.data(), out, digest_size / (B * 4));
+			}
+			else if constexpr (M == cipher_mode::CBC)
+			{
+				// Unlike encryption, CBC decryption of all blocks is independent and can be done at once
+				w.decrypt_blocks(m_data.data(), out, digest_size / (B * 4));
+
+				for (size_t i = 0; i < digest_size; i += B * 4)
+				{
+					const uint8_t* v = i == 0 ? m_iv.data() : m_data.data() + i - B * 4;
+
+					for (size_t j = 0; j < B * 4; j++)
+						out[i + j] ^= v[j];
+				}
+			}
+			else if constexpr (M == cipher_mode::PCBC)
+			{
+				uint8_t v[B * 4];
+				std::memcpy(v, m_iv.data(), B * 4);
+
+				for (size_t i = 0; i < digest_size; i += B * 4)
+				{
+					uint8_t temp[B * 4];
+					w.decrypt_block(m_data.data() + i, temp);
+
+					for (size_t j = 0; j < B * 4; j++)
+						temp[j] ^= v[j];
+
+					std::memcpy(out + i, temp, B * 4);
+
+					for (size_t j = 0; j < B * 4; j++)
+						v[j] = temp[j] ^ m_data[i + j];
+				}
+			}
+
+			return digest_size;
+		}
+
+		[[nodiscard]] std::string hex_encrypt(const void* key, size_t size) noexcept override
+		{
+			const size_t digest_size = encrypted_size();
+			uint8_t* digest = new uint8_t[digest_size];
+			encrypt(key, size, digest);
+
+			std::stringstream hex_digest;
+
+			for (size_t i = 0; i < digest_size; i++)
+				hex_digest << std::setw(2) << std::setfill('0') << std::hex << static_cast<uint32_t>(digest[i]);
+
+			delete[] digest;
+
+			return hex_digest.str();
+		}
+
+		[[nodiscard]] std::string hex_decrypt(const void* key, size_t size) noexcept override
+		{
+			uint8_t* digest = new uint8_t[m_data.size()];
+			const size_t digest_size = decrypt(key, size, digest);
+
+			std::stringstream hex_digest;
+
+			for (size_t i = 0; i < digest_size; i++)
+				hex_digest << std::setw(2) << std::setfill('0') << std::hex << static_cast<uint32_t>(digest[i]);
+
+			delete[] digest;
+
+			return hex_digest.str();
+		}
+
+		void clear() noexcept override
+		{
+			m_data.clear();
+			m_aad.clear();
+			m_iv.assign(M == cipher_mode::GCM ? 12 : B * 4, 0);
+		}
+
+		aes& operator<<(char value) noexcept override
+		{
+			m_data.push_back(value);
+			return *this;
+		}
+
+		aes& operator<<(unsigned char value) noexcept override
+		{
+			m_data.push_back(value);
+			return *this;
+		}
+
+		aes& operator<<(short value) noexcept override
+		{
+			uint8_t bytes[sizeof(short)];
+			bit::write_be(bytes, value);
+			write(bytes, sizeof(short));
+			return *this;
+		}
+
+		aes& operator<<(unsigned short value) noexcept override
+		{
+			uint8_t bytes[sizeof(unsigned short)];
+			bit::write_be(bytes, value);
+			write(bytes, sizeof(unsigned short));
+			return *this;
+		}
+
+		aes& operator<<(int value) noexcept override
+		{
+			uint8_t bytes[sizeof(int)];
+			bit::write_be(bytes, value);
+			write(bytes, sizeof(int));
+			return *this;
+		}
+
+		aes& operator<<(unsigned int value) noexcept override
+		{
+			uint8_t bytes[sizeof(unsigned int)];
+			bit::write_be(bytes, value);
+			write(bytes, sizeof(unsigned int));
+			return *this;
+		}
+
+		aes& operator<<(long value) noexcept override
+		{
+			uint8_t bytes[sizeof(long)];
+			bit::write_be(bytes, value);
+			write(bytes, sizeof(long));
+			return *this;
+		}
+
+		aes& operator<<(unsigned long value) noexcept override
+		{
+			uint8_t bytes[sizeof(unsigned long)];
+			bit::write_be(bytes, value);
+			write(bytes, sizeof(unsigned long));
+			return *this;
+		}
+
+		aes& operator<<(long long value) noexcept override
+		{
+			uint8_t bytes[sizeof(long long)];
+			bit::write_be(bytes, value);
+			write(bytes, sizeof(long long));
+			return *this;
+		}
+
+		aes& operator<<(unsigned long long value) noexcept override
+		{
+			uint8_t bytes[sizeof(unsigned long long)];
+			bit::write_be(bytes, value);
+			write(bytes, sizeof(unsigned long long));
+			return *this;
+		}
+
+		aes& operator<<(const std::string& str) noexcept override
+		{
+			write(str.data(), str.size());
+			return *this;
+		}
+
+
+	private:
+		std::vector<uint8_t> m_data;
+		std::vector<uint8_t> m_iv;
+		std::vector<uint8_t> m_aad;
+		aes_key<K, B, R> m_key;
+		uint8_t m_key_data[K * 4];
+
+		// Returns the key schedule of the given key, which is only expanded again if the key has changed
+		const aes_key<K, B, R>& expand_key(const void* key, size_t size) noexcept
+		{
+			uint8_t real_key[K * 4]{ 0 };
+			std::memcpy(real_key, key, std::min(size, K * 4));
+
+			if (std::memcmp(real_key, m_key_data, K * 4) != 0)
+			{
+				std::memcpy(m_key_data, real_key, K * 4);
+				m_key.set_key(real_key, K * 4);
+			}
+
+			return m_key;
+		}
+
+		size_t encrypted_size()
+		{
+			if constexpr (M == cipher_mode::CTR)
+				return m_data.size();
+			else if constexpr (M == cipher_mode::GCM)
+				return m_data.size() + TAG_SIZE / 8;
+			else
+				return padded_size();
+		}
+
+		size_t padded_size()
+		{
+			size_t s = m_data.size();
+
+			while (s % (B * 4) != 0)
+				s++;
+
+			return s;
+		}
+
+		void pad_data()
+		{
+			m_data.insert(m_data.end(), padded_size() - m_data.size(), 0);
 		}
 	};
 
 	using aes_128 = aes<cipher_mode::PCBC, 4, 4, 10>;
 	using aes_192 = aes<cipher_mode::PCBC, 6, 4, 12>;
 	using aes_256 = aes<cipher_mode::PCBC, 8, 4, 14>;
+
+	using aes_128_ctr = aes<cipher_mode::CTR, 4, 4, 10>;
+	using aes_192_ctr = aes<cipher_mode::CTR, 6, 4, 12>;
+	using aes_256_ctr = aes<cipher_mode::CTR, 8, 4, 14>;
+
+	using aes_128_gcm = aes<cipher_mode::GCM, 4, 4, 10>;
+	using aes_192_gcm = aes<cipher_mode::GCM, 6, 4, 12>;
+	using aes_256_gcm = aes<cipher_mode::GCM, 8, 4, 14>;
+
+	using aes_128_key = aes_key<4, 4, 10>;
+	using aes_192_key = aes_key<6, 4, 12>;
+	using aes_256_key = aes_key<8, 4, 14>;
 }
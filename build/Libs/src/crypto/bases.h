@@ -56,7 +56,7 @@ namespace rb::crypto
 		 * \param str String to be checked.
 		 * \return True if string is valid, false otherwise.
 		 */
-		static [[nodiscard]] bool check(const std::string& str) noexcept
+		[[nodiscard]] static bool check(const std::string& str) noexcept
 		{
 			return std::all_of(str.begin(), str.end(), [&](char c) { return std::find(CHARS.begin(), CHARS.end(), c) != CHARS.end(); });
 		}
@@ -68,7 +68,7 @@ namespace rb::crypto
 		 * \param size Size of memory range to be encoded.
 		 * \return Encoded string.
 		 */
-		static [[nodiscard]] std::string encode(const void* src, size_t size) noexcept
+		[[nodiscard]] static std::string encode(const void* src, size_t size) noexcept
 		{
 			const uint8_t* data = reinterpret_cast<const uint8_t*>(src);
 
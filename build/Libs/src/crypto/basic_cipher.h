@@ -6,7 +6,7 @@ namespace rb::crypto
 {
 	enum class cipher_mode
 	{
-		ECB, CBC, PCBC, CFB, OFB, CTR
+		ECB, CBC, PCBC, CFB, OFB, CTR, GCM
 	};
 
 	class basic_cipher
@@ -1,10 +1,12 @@
 #pragma once
 
-#include <deque>
+#include <cstring>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
 
+#include "bit/endian.h"
+
 #include "crypto/basic_hash.h"
 
 namespace rb::crypto
@@ -23,7 +25,7 @@ namespace rb::crypto
 		static constexpr size_t BLOCK_SIZE = R;
 		static constexpr size_t DIGEST_SIZE = H;
 
-		static_assert(R + C == 1600 && R % 8 == 0);
+		static_assert(R + C == 1600 && R % 64 == 0);
 
 	public:
 		basic_sponge() noexcept
@@ -31,25 +33,87 @@ namespace rb::crypto
 			clear();
 		}
 
+		// Input is absorbed as soon as it arrives, only the position within the current block is kept.
+		// Input written after squeezing has started is ignored until `clear` is called.
 		basic_sponge& write(const void* data, size_t size) noexcept override
 		{
-			std::copy_n(reinterpret_cast<const uint8_t*>(data), size, std::back_inserter(m_data));
+			if (m_squeezing)
+				return *this;
+
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+			uint8_t* state = reinterpret_cast<uint8_t*>(m_state);
+
+			if (m_offset > 0)
+			{
+				const size_t count = std::min(size, BYTE_RATE - m_offset);
+
+				for (size_t i = 0; i < count; i++)
+					state[m_offset + i] ^= bytes[i];
+
+				m_offset += count;
+				bytes += count;
+				size -= count;
+
+				if (m_offset < BYTE_RATE)
+					return *this;
+
+				(*F)(state, STATE_SIZE);
+				m_offset = 0;
+			}
+
+			for (; size >= BYTE_RATE; bytes += BYTE_RATE, size -= BYTE_RATE)
+			{
+				for (size_t i = 0; i < BYTE_RATE / 8; i++)
+					m_state[i] ^= bit::read_le<uint64_t>(bytes + i * 8);
+
+				(*F)(state, STATE_SIZE);
+			}
+
+			for (size_t i = 0; i < size; i++)
+				state[i] ^= bytes[i];
+
+			m_offset = size;
+
 			return *this;
 		}
 
+		// Squeezes the next `size` bytes of output, the input is padded on the first call.
+		// Consecutive calls continue the same output stream, so XOFs like SHAKE can be read in pieces.
+		// The output is squeezed from a copy of the state, the absorbed input is kept for `digest`.
+		void squeeze(void* dest, size_t size) noexcept
+		{
+			if (!m_squeezing)
+			{
+				std::memcpy(m_output, m_state, sizeof(m_state));
+				pad(reinterpret_cast<uint8_t*>(m_output), m_offset);
+
+				m_output_offset = 0;
+				m_squeezing = true;
+			}
+
+			squeeze(reinterpret_cast<uint8_t*>(m_output), m_output_offset, reinterpret_cast<uint8_t*>(dest), size);
+		}
+
+		// Finalizes a copy of the absorbed state, so more data can be written afterwards
+		// and the digest does not depend on what has been squeezed
 		void digest(void* dest) noexcept override
 		{
-			process_data();
-			std::memcpy(dest, m_hash, DIGEST_SIZE / 8);
+			uint64_t state[STATE_SIZE / 64];
+			std::memcpy(state, m_state, sizeof(m_state));
+			pad(reinterpret_cast<uint8_t*>(state), m_offset);
+
+			size_t offset = 0;
+			squeeze(reinterpret_cast<uint8_t*>(state), offset, reinterpret_cast<uint8_t*>(dest), DIGEST_SIZE / 8);
 		}
 
 		[[nodiscard]] std::string hex_digest() noexcept override
 		{
-			process_data();
+			uint8_t hash[DIGEST_SIZE / 8];
+			digest(hash);
 
 			std::stringstream hex_digest;
 
-			for (uint8_t b : m_hash)
+			for (uint8_t b : hash)
 				hex_digest << std::setw(2) << std::setfill('0') << std::hex << static_cast<uint32_t>(b);
 
 			return hex_digest.str();
@@ -57,19 +121,21 @@ namespace rb::crypto
 
 		void clear() noexcept override
 		{
-			m_data.clear();
-			std::memset(m_hash, 0, DIGEST_SIZE / 8);
+			std::memset(m_state, 0, sizeof(m_state));
+			m_offset = 0;
+			m_output_offset = 0;
+			m_squeezing = false;
 		}
 
 		basic_sponge& operator<<(char value) noexcept override
 		{
-			m_data.push_back(value);
+			write(&value, 1);
 			return *this;
 		}
 
 		basic_sponge& operator<<(unsigned char value) noexcept override
 		{
-			m_data.push_back(value);
+			write(&value, 1);
 			return *this;
 		}
 
@@ -158,49 +224,45 @@ namespace rb::crypto
 		}
 
 	private:
-		std::deque<uint8_t> m_data;
-		uint8_t m_hash[DIGEST_SIZE / 8];
+		// Absorbed input
+		uint64_t m_state[STATE_SIZE / 64];
+		size_t m_offset;
 
-		void process_data() noexcept
-		{
-			uint8_t state[STATE_SIZE / 8] = { 0 };
-			uint32_t blockSize = 0;
+		// Padded state the output is squeezed from
+		uint64_t m_output[STATE_SIZE / 64];
+		size_t m_output_offset;
+		bool m_squeezing;
 
-			while (m_data.size() > 0)
-			{
-				blockSize = std::min(m_data.size(), BYTE_RATE);
-
-				for (size_t i = 0; i < blockSize; i++)
-				{
-					state[i] ^= m_data.front();
-					m_data.pop_front();
-				}
-
-				if (blockSize == BYTE_RATE)
-					(*F)(state, STATE_SIZE);
-			}
-
-			state[blockSize] ^= D;
+		static void pad(uint8_t* state, size_t offset) noexcept
+		{
+			state[offset] ^= D;
 
-			if ((D & 0x80) != 0 && blockSize == BYTE_RATE - 1)
+			if ((D & 0x80) != 0 && offset == BYTE_RATE - 1)
 				(*F)(state, STATE_SIZE);
 
 			state[BYTE_RATE - 1] ^= 0x80;
 
 			(*F)(state, STATE_SIZE);
+		}
 
-			size_t out_len = DIGEST_SIZE / 8;
-
-			while (out_len > 0)
+		// Copies `size` bytes of output starting at `offset` within the current block of a padded state
+		static void squeeze(uint8_t* state, size_t& offset, uint8_t* out, size_t size) noexcept
+		{
+			while (size > 0)
 			{
-				blockSize = std::min(out_len, BYTE_RATE);
+				if (offset == BYTE_RATE)
+				{
+					(*F)(state, STATE_SIZE);
+					offset = 0;
+				}
 
-				std::memcpy(&m_hash[DIGEST_SIZE / 8 - out_len], state, blockSize);
+				const size_t count = std::min(size, BYTE_RATE - offset);
 
-				out_len -= blockSize;
+				std::memcpy(out, state + offset, count);
 
-				if (out_len > 0)
-					(*F)(state, STATE_SIZE);
+				offset += count;
+				out += count;
+				size -= count;
 			}
 		}
 	};
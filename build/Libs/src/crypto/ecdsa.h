@@ -1,20 +1,29 @@
 #pragma once
 
+#include <array>
 #include <tuple>
-#include <utility>
+#include <vector>
 #include <random>
+#include <utility>
+#include <iterator>
+#include <algorithm>
 #include <type_traits>
 
 #include "math/bigint.h"
+#include "math/montgomery.h"
 #include "crypto/sha2.h"
 
+#include "thread/parallel.h"
+
 namespace rb::crypto
 {
 	using namespace rb::math::literals;
 
 	struct ec_secp192k1
 	{
-		using hash_type = typename rb::crypto::sha2_256;
+		using hash_type = rb::crypto::sha2_256;
+
+		static inline constexpr size_t BIT_SIZE = 192;
 
 		static inline const rb::math::bigint p = "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFEE37"_bigint;
 		static inline const rb::math::bigint a = "000000000000000000000000000000000000000000000000"_bigint;
@@ -28,7 +37,9 @@ namespace rb::crypto
 
 	struct ec_secp192r1
 	{
-		using hash_type = typename rb::crypto::sha2_256;
+		using hash_type = rb::crypto::sha2_256;
+
+		static inline constexpr size_t BIT_SIZE = 192;
 
 		static inline const rb::math::bigint p = "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFFFFFFFFFFFF"_bigint;
 		static inline const rb::math::bigint a = "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFFFFFFFFFFFC"_bigint;
@@ -42,7 +53,9 @@ namespace rb::crypto
 
 	struct ec_secp224k1
 	{
-		using hash_type = typename rb::crypto::sha2_256;
+		using hash_type = rb::crypto::sha2_256;
+
+		static inline constexpr size_t BIT_SIZE = 224;
 
 		static inline const rb::math::bigint p = "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFE56D"_bigint;
 		static inline const rb::math::bigint a = "00000000000000000000000000000000000000000000000000000000"_bigint;
@@ -56,7 +69,9 @@ namespace rb::crypto
 
 	struct ec_secp224r1
 	{
-		using hash_type = typename rb::crypto::sha2_256;
+		using hash_type = rb::crypto::sha2_256;
+
+		static inline constexpr size_t BIT_SIZE = 224;
 
 		static inline const rb::math::bigint p = "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF000000000000000000000001"_bigint;
 		static inline const rb::math::bigint a = "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFFFFFFFFFFFFFFFFFFFE"_bigint;
@@ -70,7 +85,9 @@ namespace rb::crypto
 
 	struct ec_secp256k1
 	{
-		using hash_type = typename rb::crypto::sha2_256;
+		using hash_type = rb::crypto::sha2_256;
+
+		static inline constexpr size_t BIT_SIZE = 256;
 
 		static inline const rb::math::bigint p = "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F"_bigint;
 		static inline const rb::math::bigint a = "0000000000000000000000000000000000000000000000000000000000000000"_bigint;
@@ -84,7 +101,9 @@ namespace rb::crypto
 
 	struct ec_secp256r1
 	{
-		using hash_type = typename rb::crypto::sha2_256;
+		using hash_type = rb::crypto::sha2_256;
+
+		static inline constexpr size_t BIT_SIZE = 256;
 
 		static inline const rb::math::bigint p = "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF"_bigint;
 		static inline const rb::math::bigint a = "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFC"_bigint;
@@ -98,7 +117,9 @@ namespace rb::crypto
 
 	struct ec_secp384r1
 	{
-		using hash_type = typename rb::crypto::sha2_256;
+		using hash_type = rb::crypto::sha2_256;
+
+		static inline constexpr size_t BIT_SIZE = 384;
 
 		static inline const rb::math::bigint p = "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFFFF0000000000000000FFFFFFFF"_bigint;
 		static inline const rb::math::bigint a = "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFFFF0000000000000000FFFFFFFC"_bigint;
@@ -112,7 +133,9 @@ namespace rb::crypto
 
 	struct ec_secp521r1
 	{
-		using hash_type = typename rb::crypto::sha2_256;
+		using hash_type = rb::crypto::sha2_256;
+
+		static inline constexpr size_t BIT_SIZE = 521;
 
 		static inline const rb::math::bigint p = "01FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"_bigint;
 		static inline const rb::math::bigint a = "01FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFC"_bigint;
@@ -128,28 +151,81 @@ namespace rb::crypto
 	class ECDSA
 	{
 	public:
-		using params = typename C;
+		using params = C;
 		
 		using hash_type = typename params::hash_type;
 
-		using int_type = typename rb::math::bigint;
+		using int_type = rb::math::bigint;
 		
 	private:
-		using affine_point_type = typename std::tuple<int_type, int_type>;
-		using jacobian_point_type = typename std::tuple<int_type, int_type, int_type>;
+		using affine_point_type = std::tuple<int_type, int_type>;
 		
 	public:
-		using private_key_type = typename int_type;
-		using public_key_type = typename affine_point_type;
-		using key_pair_type = typename std::tuple<private_key_type, public_key_type>;
+		using private_key_type = int_type;
+		using public_key_type = affine_point_type;
+		using key_pair_type = std::tuple<private_key_type, public_key_type>;
 
-		using signature_type = typename std::tuple<int_type, int_type>;
+		using signature_type = std::tuple<int_type, int_type>;
 
 	private:
-		static inline affine_point_type AFFINE_INFINITY = { 0, 0 };
-		static inline jacobian_point_type JACOBIAN_INFINITY = { 1, 1, 0 };
-		
-		static inline affine_point_type GENERATOR = { params::Gx, params::Gy };
+		static inline constexpr size_t LIMB_SIZE = (params::BIT_SIZE + 63) / 64;
+
+		using field_type = rb::math::montgomery_field<LIMB_SIZE>;
+		using element_type = typename field_type::element_type;
+
+		// Coordinates are kept in Montgomery representation, the point at infinity has Z = 0
+		struct field_affine_point
+		{
+			element_type x, y;
+		};
+
+		struct field_jacobian_point
+		{
+			element_type x, y, z;
+		};
+
+		// Selects the doubling formula matching the `a` coefficient of the curve
+		enum class curve_shape
+		{
+			A_ZERO,
+			A_MINUS_THREE,
+			A_GENERIC
+		};
+
+		struct curve_type
+		{
+			field_type fp; // Coordinates modulo p
+			field_type fn; // Scalars modulo n
+
+			element_type p;
+			element_type n;
+
+			element_type a;
+			element_type b;
+
+			curve_shape shape;
+
+			field_affine_point g;
+		};
+
+		// Window width of the fixed-base table used for k * G, every window holds the odd multiples 1, 3, ..., 2^w - 1
+		static inline constexpr size_t WINDOW_WIDTH = 4;
+		static inline constexpr size_t WINDOW_SIZE = size_t(1) << (WINDOW_WIDTH - 1);
+
+		// Window widths of the non-adjacent forms of u1 and u2 during verification
+		static inline constexpr size_t GENERATOR_WNAF_WIDTH = 8;
+		static inline constexpr size_t POINT_WNAF_WIDTH = 5;
+
+		static inline constexpr size_t WNAF_SIZE = LIMB_SIZE * 64 + 1;
+
+		struct generator_table_type
+		{
+			// window[i * WINDOW_SIZE + j] = (2 * j + 1) * 2^(WINDOW_WIDTH * i) * G
+			std::vector<field_affine_point> window;
+
+			// odd[i] = (2 * i + 1) * G
+			std::vector<field_affine_point> odd;
+		};
 		
 	public:
 		ECDSA() noexcept = delete;
@@ -157,305 +233,594 @@ namespace rb::crypto
 		ECDSA(ECDSA&&) noexcept = delete;
 
 	private:
-		// Calculate modular multiplicative inverse (a * a^-1 = 1 (mod n)) using the Extended Euclidean Algorithm
-		// https://en.wikipedia.org/wiki/Extended_Euclidean_algorithm
-		[[nodiscard]] static int_type inverse(int_type a, const int_type& n) noexcept
+		[[nodiscard]] static element_type _to_limbs(const int_type& x) noexcept
+		{
+			element_type limbs{ 0 };
+			const uint8_t* bytes = x.data();
+
+			for (size_t i = 0; i < std::min(x.size(), LIMB_SIZE * 8); i++)
+				limbs[i / 8] |= static_cast<uint64_t>(bytes[i]) << (i % 8 * 8);
+
+			return limbs;
+		}
+
+		[[nodiscard]] static int_type _from_limbs(const element_type& limbs) noexcept
+		{
+			uint8_t bytes[LIMB_SIZE * 8];
+
+			for (size_t i = 0; i < LIMB_SIZE * 8; i++)
+				bytes[i] = static_cast<uint8_t>(limbs[i / 8] >> (i % 8 * 8));
+
+			return int_type(bytes, LIMB_SIZE * 8);
+		}
+
+		[[nodiscard]] static curve_type _make_curve() noexcept
 		{
-			int_type t = int_type::ZERO(), newt = int_type::ONE();
-			int_type r = n, newr = a;
-			int_type q, oldt, oldr;
+			curve_type curve;
+
+			curve.p = _to_limbs(params::p);
+			curve.n = _to_limbs(params::n);
+
+			curve.fp = field_type(curve.p);
+			curve.fn = field_type(curve.n);
+
+			curve.a = curve.fp.to_montgomery(_to_limbs(params::a));
+			curve.b = curve.fp.to_montgomery(_to_limbs(params::b));
 
-			while (!newr.is_zero())
+			if (params::a.is_zero())
+				curve.shape = curve_shape::A_ZERO;
+			else if (params::a == params::p - int_type(3))
+				curve.shape = curve_shape::A_MINUS_THREE;
+			else
+				curve.shape = curve_shape::A_GENERIC;
+
+			curve.g = { curve.fp.to_montgomery(_to_limbs(params::Gx)), curve.fp.to_montgomery(_to_limbs(params::Gy)) };
+
+			return curve;
+		}
+
+		// Field constants are derived from the curve parameters on first use
+		[[nodiscard]] static const curve_type& _curve() noexcept
+		{
+			static const curve_type curve = _make_curve();
+			return curve;
+		}
+
+	private:
+		[[nodiscard]] static field_affine_point _point_negate(const field_affine_point& p) noexcept
+		{
+			return { p.x, _curve().fp.neg(p.y) };
+		}
+
+		[[nodiscard]] static field_jacobian_point _point_negate(const field_jacobian_point& p) noexcept
+		{
+			return { p.x, _curve().fp.neg(p.y), p.z };
+		}
+
+		// Prime curve jacobian point doubling
+		// https://hyperelliptic.org/EFD/g1p/auto-shortw-jacobian.html
+		[[nodiscard]] static field_jacobian_point _point_double(const field_jacobian_point& p) noexcept
+		{
+			const curve_type& curve = _curve();
+			const field_type& f = curve.fp;
+
+			if (field_type::is_zero(p.z))
+				return p;
+
+			field_jacobian_point r;
+
+			if (curve.shape == curve_shape::A_ZERO)
+			{
+				// dbl-2009-l
+				const element_type a = f.sqr(p.x);
+				const element_type b = f.sqr(p.y);
+				const element_type c = f.sqr(b);
+
+				element_type d = f.sub(f.sub(f.sqr(f.add(p.x, b)), a), c);
+				d = f.add(d, d);
+
+				const element_type e = f.add(f.add(a, a), a);
+
+				element_type c8 = f.add(c, c);
+				c8 = f.add(c8, c8);
+				c8 = f.add(c8, c8);
+
+				r.x = f.sub(f.sqr(e), f.add(d, d));
+				r.y = f.sub(f.mul(e, f.sub(d, r.x)), c8);
+				r.z = f.mul(p.y, p.z);
+				r.z = f.add(r.z, r.z);
+			}
+			else if (curve.shape == curve_shape::A_MINUS_THREE)
 			{
-				q = r / newr;
-
-				oldt = t;
-				t = newt;
-				newt = oldt - q * newt;
-				
-				oldr = r;
-				r = newr;
-				newr = oldr - q * newr;
+				// dbl-2001-b
+				const element_type delta = f.sqr(p.z);
+				const element_type gamma = f.sqr(p.y);
+				const element_type beta = f.mul(p.x, gamma);
+
+				element_type alpha = f.mul(f.sub(p.x, delta), f.add(p.x, delta));
+				alpha = f.add(f.add(alpha, alpha), alpha);
+
+				element_type beta4 = f.add(beta, beta);
+				beta4 = f.add(beta4, beta4);
+
+				element_type gamma8 = f.sqr(gamma);
+				gamma8 = f.add(gamma8, gamma8);
+				gamma8 = f.add(gamma8, gamma8);
+				gamma8 = f.add(gamma8, gamma8);
+
+				r.x = f.sub(f.sqr(alpha), f.add(beta4, beta4));
+				r.y = f.sub(f.mul(alpha, f.sub(beta4, r.x)), gamma8);
+				r.z = f.sub(f.sub(f.sqr(f.add(p.y, p.z)), gamma), delta);
 			}
+			else
+			{
+				// dbl-2007-bl
+				const element_type xx = f.sqr(p.x);
+				const element_type yy = f.sqr(p.y);
+				const element_type yyyy = f.sqr(yy);
+				const element_type zz = f.sqr(p.z);
+
+				element_type s = f.sub(f.sub(f.sqr(f.add(p.x, yy)), xx), yyyy);
+				s = f.add(s, s);
 
-			if (r > int_type::ONE())
-				return int_type::ZERO();
+				const element_type m = f.add(f.add(f.add(xx, xx), xx), f.mul(curve.a, f.sqr(zz)));
 
-			if (t < int_type::ZERO())
-				t = t + n;
+				element_type yyyy8 = f.add(yyyy, yyyy);
+				yyyy8 = f.add(yyyy8, yyyy8);
+				yyyy8 = f.add(yyyy8, yyyy8);
 
-			return t;
+				r.x = f.sub(f.sqr(m), f.add(s, s));
+				r.y = f.sub(f.mul(m, f.sub(s, r.x)), yyyy8);
+				r.z = f.sub(f.sub(f.sqr(f.add(p.y, p.z)), yy), zz);
+			}
+
+			return r;
 		}
 
-		// Modulo using Barret reduction
-		// https://en.wikipedia.org/wiki/Barrett_reduction
-		// https://www.nayuki.io/page/barrett-reduction-algorithm
-		[[nodiscard]] static int_type mod_p(int_type x)
+		// Prime curve jacobian point addition (add-2007-bl)
+		// https://hyperelliptic.org/EFD/g1p/auto-shortw-jacobian.html
+		[[nodiscard]] static field_jacobian_point _point_add(const field_jacobian_point& p, const field_jacobian_point& q) noexcept
 		{
-			static const int_type k = params::p.bits();
-			static const int_type p_sqr = params::p * params::p;
-			static const int_type k2 = k << 1;
-			static const int_type r = (int_type::ONE() << k2) / params::p;
+			const field_type& f = _curve().fp;
+
+			if (field_type::is_zero(p.z))
+				return q;
+
+			if (field_type::is_zero(q.z))
+				return p;
+
+			const element_type z1z1 = f.sqr(p.z);
+			const element_type z2z2 = f.sqr(q.z);
+
+			const element_type u1 = f.mul(p.x, z2z2);
+			const element_type u2 = f.mul(q.x, z1z1);
+
+			const element_type s1 = f.mul(f.mul(p.y, q.z), z2z2);
+			const element_type s2 = f.mul(f.mul(q.y, p.z), z1z1);
+
+			const element_type h = f.sub(u2, u1);
+			element_type r = f.sub(s2, s1);
 
-			bool negative = false;
-			if (x.sign() < 0)
+			if (field_type::is_zero(h))
 			{
-				negative = true;
-				x = -x;
-			}
+				if (field_type::is_zero(r))
+					return _point_double(p);
 
-			if (x >= p_sqr)
-				return x % params::p;
+				return field_jacobian_point{};
+			}
 
-			int_type t = x - ((x * r) >> k2) * params::p;
+			r = f.add(r, r);
 
-			if (t >= params::p)
-				t -= params::p;
+			const element_type i = f.sqr(f.add(h, h));
+			const element_type j = f.mul(h, i);
+			const element_type v = f.mul(u1, i);
+			const element_type s1j = f.mul(s1, j);
 
-			if (negative)
-				t = params::p - t;
+			field_jacobian_point result;
+			result.x = f.sub(f.sub(f.sqr(r), j), f.add(v, v));
+			result.y = f.sub(f.mul(r, f.sub(v, result.x)), f.add(s1j, s1j));
+			result.z = f.mul(f.sub(f.sub(f.sqr(f.add(p.z, q.z)), z1z1), z2z2), h);
 
-			return t;
+			return result;
 		}
 
-		// Modulo using Barret reduction
-		// https://en.wikipedia.org/wiki/Barrett_reduction
-		// https://www.nayuki.io/page/barrett-reduction-algorithm
-		[[nodiscard]] static int_type mod_n(int_type x)
+		// Prime curve mixed jacobian-affine point addition (madd-2007-bl)
+		// https://hyperelliptic.org/EFD/g1p/auto-shortw-jacobian.html
+		[[nodiscard]] static field_jacobian_point _point_add(const field_jacobian_point& p, const field_affine_point& q) noexcept
 		{
-			static const int_type k = params::n.bits();
-			static const int_type n_sqr = params::n * params::n;
-			static const int_type k2 = k << 1;
-			static const int_type r = (int_type::ONE() << k2) / params::n;
+			const field_type& f = _curve().fp;
+
+			if (field_type::is_zero(p.z))
+				return { q.x, q.y, f.one() };
+
+			const element_type z1z1 = f.sqr(p.z);
+
+			const element_type u2 = f.mul(q.x, z1z1);
+			const element_type s2 = f.mul(f.mul(q.y, p.z), z1z1);
+
+			const element_type h = f.sub(u2, p.x);
+			element_type r = f.sub(s2, p.y);
 
-			bool negative = false;
-			if (x.sign() < 0)
+			if (field_type::is_zero(h))
 			{
-				negative = true;
-				x = -x;
+				if (field_type::is_zero(r))
+					return _point_double(p);
+
+				return field_jacobian_point{};
 			}
 
-			if (x >= n_sqr)
-				return x % params::n;
+			r = f.add(r, r);
+
+			const element_type hh = f.sqr(h);
 
-			int_type t = x - ((x * r) >> k2) * params::n;
+			element_type i = f.add(hh, hh);
+			i = f.add(i, i);
 
-			if (t >= params::n)
-				t -= params::n;
+			const element_type j = f.mul(h, i);
+			const element_type v = f.mul(p.x, i);
+			const element_type y1j = f.mul(p.y, j);
 
-			if (negative)
-				t = params::n - t;
+			field_jacobian_point result;
+			result.x = f.sub(f.sub(f.sqr(r), j), f.add(v, v));
+			result.y = f.sub(f.mul(r, f.sub(v, result.x)), f.add(y1j, y1j));
+			result.z = f.sub(f.sub(f.sqr(f.add(p.z, h)), z1z1), hh);
 
-			return t;
+			return result;
 		}
 
-	private:
-		// Convert point from affine to jacobian coordinates
-		// https://crypto.stackexchange.com/questions/19598/how-can-convert-affine-to-jacobian-coordinates
-		[[nodiscard]] static jacobian_point_type point_affine_to_jacobian(const affine_point_type& p) noexcept
+		// Convert point from jacobian to affine coordinates, the point must not be at infinity
+		[[nodiscard]] static field_affine_point _to_affine(const field_jacobian_point& p) noexcept
 		{
-			if (p == AFFINE_INFINITY)
-				return JACOBIAN_INFINITY;
+			const field_type& f = _curve().fp;
+
+			const element_type z_inv = f.inverse(p.z);
+			const element_type z_inv_sqr = f.sqr(z_inv);
+
+			return { f.mul(p.x, z_inv_sqr), f.mul(p.y, f.mul(z_inv_sqr, z_inv)) };
+		}
+
+		// Convert many points at once sharing a single inversion (Montgomery's trick)
+		// https://en.wikipedia.org/wiki/Modular_multiplicative_inverse#Multiple_inverses
+		[[nodiscard]] static std::vector<field_affine_point> _to_affine(const std::vector<field_jacobian_point>& points)
+		{
+			const field_type& f = _curve().fp;
+
+			std::vector<element_type> prefix(points.size());
+			element_type acc = f.one();
+
+			for (size_t i = 0; i < points.size(); i++)
+			{
+				prefix[i] = acc;
+				acc = f.mul(acc, points[i].z);
+			}
+
+			acc = f.inverse(acc);
 
-			return { std::get<0>(p), std::get<1>(p), int_type::ONE() };
+			std::vector<field_affine_point> result(points.size());
+
+			for (size_t i = points.size(); i-- > 0;)
+			{
+				const element_type z_inv = f.mul(acc, prefix[i]);
+				const element_type z_inv_sqr = f.sqr(z_inv);
+
+				acc = f.mul(acc, points[i].z);
+
+				result[i] = { f.mul(points[i].x, z_inv_sqr), f.mul(points[i].y, f.mul(z_inv_sqr, z_inv)) };
+			}
+
+			return result;
 		}
 
-		// Convert point from jacobian to affine coordinates
-		// https://crypto.stackexchange.com/questions/19598/how-can-convert-affine-to-jacobian-coordinates
-		[[nodiscard]] static affine_point_type point_jacobian_to_affine(const jacobian_point_type& p) noexcept
+		[[nodiscard]] static bool _is_on_curve(const field_affine_point& p) noexcept
 		{
-			if (p == JACOBIAN_INFINITY)
-				return AFFINE_INFINITY;
+			const curve_type& curve = _curve();
+			const field_type& f = curve.fp;
 
-			int_type z_sqr = mod_p(std::get<2>(p) * std::get<2>(p));
+			// y^2 = x^3 + a * x + b
+			const element_type lhs = f.sqr(p.y);
+			const element_type rhs = f.add(f.mul(f.add(f.sqr(p.x), curve.a), p.x), curve.b);
 
-			return {
-				mod_p(std::get<0>(p) * inverse(z_sqr, params::p)),
-				mod_p(std::get<1>(p) * inverse(mod_p(z_sqr * std::get<2>(p)), params::p))
-			};
+			return lhs == rhs;
 		}
 
 	private:
-		// Prime curve affine point addition
-		// https://en.wikibooks.org/wiki/Cryptography/Prime_Curve/Affine_Coordinates
-		[[nodiscard]] static affine_point_type point_add(const affine_point_type& p, const affine_point_type& q) noexcept
+		[[nodiscard]] static generator_table_type _make_generator_table()
 		{
-			if (p == AFFINE_INFINITY)
-				return q;
+			const curve_type& curve = _curve();
+			const field_jacobian_point g = { curve.g.x, curve.g.y, curve.fp.one() };
 
-			if (q == AFFINE_INFINITY)
-				return p;
+			generator_table_type table;
+
+			// Fixed windows, every window of the scalar selects one point and no doubling is needed
+			std::vector<field_jacobian_point> points;
+			points.reserve(_generator_windows() * WINDOW_SIZE);
 
-			if (std::get<0>(p) == std::get<0>(q))
+			field_jacobian_point base = g;
+
+			for (size_t i = 0; i < _generator_windows(); i++)
 			{
-				if (std::get<1>(p) != std::get<1>(q))
-					return AFFINE_INFINITY;
+				const field_jacobian_point base2 = _point_double(base);
+				field_jacobian_point acc = base;
 
-				return point_double(p);
+				for (size_t j = 0; j < WINDOW_SIZE; j++)
+				{
+					points.push_back(acc);
+					acc = _point_add(acc, base2);
+				}
+
+				for (size_t j = 0; j < WINDOW_WIDTH; j++)
+					base = _point_double(base);
 			}
 
-			int_type lambda;
-			lambda = (std::get<1>(q) - std::get<1>(p)) % params::p;
-			lambda = (lambda * inverse((std::get<0>(q) - std::get<0>(p)) % params::p, params::p)) % params::p;
+			table.window = _to_affine(points);
+
+			// Odd multiples for the width-w NAF of u1
+			points.clear();
 
-			int_type x = (lambda * lambda - std::get<0>(p) - std::get<0>(q)) % params::p;
-			int_type y = (lambda * (std::get<0>(p) - x) - std::get<1>(p)) % params::p;
+			const field_jacobian_point g2 = _point_double(g);
+			field_jacobian_point acc = g;
 
-			return { x, y };
+			for (size_t i = 0; i < (size_t(1) << (GENERATOR_WNAF_WIDTH - 2)); i++)
+			{
+				points.push_back(acc);
+				acc = _point_add(acc, g2);
+			}
+
+			table.odd = _to_affine(points);
+
+			return table;
 		}
 
-		// Prime curve affine point doubling
-		// https://en.wikibooks.org/wiki/Cryptography/Prime_Curve/Affine_Coordinates
-		[[nodiscard]] static affine_point_type point_double(const affine_point_type& p) noexcept
+		// Precomputed multiples of the generator, built on first use
+		[[nodiscard]] static const generator_table_type& _generator_table()
 		{
-			if (std::get<1>(p).is_zero())
-				return AFFINE_INFINITY;
+			static const generator_table_type table = _make_generator_table();
+			return table;
+		}
 
-			int_type lambda;
-			lambda = (std::get<0>(p) * std::get<0>(p)) % params::p;
-			lambda = ((lambda << int_type::ONE()) + lambda + params::a) % params::p;
-			lambda = (lambda * inverse(std::get<1>(p) << int_type::ONE(), params::p)) % params::p;
+		// Number of windows of the signed recoding of scalars below 2n
+		[[nodiscard]] static size_t _generator_windows() noexcept
+		{
+			return (rb::math::_limbs_bits(_curve().n.data(), LIMB_SIZE) + WINDOW_WIDTH) / WINDOW_WIDTH;
+		}
 
-			int_type x = (lambda * lambda - (std::get<0>(p) << int_type::ONE())) % params::p;
-			int_type y = (lambda * (std::get<0>(p) - x) - std::get<1>(p)) % params::p;
+		// All ones if `a == b`, zero otherwise, without branching
+		[[nodiscard]] static uint64_t _equal_mask(uint64_t a, uint64_t b) noexcept
+		{
+			return uint64_t(0) - (((a ^ b) - 1) >> 63);
+		}
+
+		[[nodiscard]] static element_type _select(uint64_t mask, const element_type& a, const element_type& b) noexcept
+		{
+			element_type r;
+
+			for (size_t i = 0; i < LIMB_SIZE; i++)
+				r[i] = (a[i] & mask) | (b[i] & ~mask);
 
-			return { x, y };
+			return r;
 		}
 
-		// Prime curve affine point multiplication by scalar using the Montgomery ladder method
-		// https://en.wikipedia.org/wiki/Elliptic_curve_point_multiplication
-		[[nodiscard]] static affine_point_type point_multiply(int_type d, const affine_point_type& p) noexcept
+		// Fixed-base scalar multiplication k * G for secret scalars, runs in constant time
+		// The scalar is made odd by adding n if needed and recoded into odd signed digits in [-15, 15],
+		// so every window adds a point. The point is selected by scanning the whole window with masks
+		// and negated with a mask, so neither the control flow nor the memory addresses depend on k.
+		// The partial sums stay below the magnitude of the added multiple, so the exceptional cases of
+		// the addition can only be reached with negligible probability in the last windows.
+		// https://eprint.iacr.org/2015/1060.pdf
+		[[nodiscard]] static field_jacobian_point _multiply_generator(const element_type& k) noexcept
 		{
-			affine_point_type r0 = AFFINE_INFINITY;
-			affine_point_type r1 = p;
-			int32_t m = static_cast<int32_t>(d.bits());
+			const curve_type& curve = _curve();
+			const field_type& f = curve.fp;
+			const generator_table_type& table = _generator_table();
+			const size_t windows = _generator_windows();
+
+			// k' = k if k is odd, k + n otherwise
+			uint64_t k_odd[LIMB_SIZE + 1];
+			uint64_t k_plus_n[LIMB_SIZE + 1];
 
-			for (int32_t i = m - 1; i >= 0; i--)
+			k_plus_n[LIMB_SIZE] = rb::math::_limbs_add(k_plus_n, k.data(), LIMB_SIZE, curve.n.data(), LIMB_SIZE);
+
+			const uint64_t even = (k[0] & 1) - 1;
+
+			for (size_t i = 0; i < LIMB_SIZE; i++)
+				k_odd[i] = (k[i] & ~even) | (k_plus_n[i] & even);
+
+			k_odd[LIMB_SIZE] = k_plus_n[LIMB_SIZE] & even;
+
+			field_jacobian_point r{};
+
+			for (size_t i = 0; i < windows; i++)
 			{
-				if ((d.data()[i / 8] >> (i % 8)) & 1)
+				// Bits [4i, 4i + 5) of k', the windows and the bit positions do not depend on k
+				const size_t bit = i * WINDOW_WIDTH;
+				uint64_t bits = k_odd[bit / 64] >> (bit % 64);
+
+				if (bit % 64 > 64 - WINDOW_WIDTH - 1 && bit / 64 < LIMB_SIZE)
+					bits |= k_odd[bit / 64 + 1] << (64 - bit % 64);
+
+				// digit = (bits | 1) - 16 of the lower windows, the last window is the odd remainder
+				const int64_t digit = i + 1 < windows
+					? static_cast<int64_t>((bits & 0x1E) | 1) - (int64_t(1) << WINDOW_WIDTH)
+					: static_cast<int64_t>(bits | 1);
+
+				const uint64_t negative = static_cast<uint64_t>(digit >> 63);
+				const uint64_t index = ((static_cast<uint64_t>(digit) ^ negative) - negative) >> 1;
+
+				field_affine_point p{};
+
+				for (size_t j = 0; j < WINDOW_SIZE; j++)
 				{
-					r0 = point_add(r0, r1);
-					r1 = point_double(r1);
+					const uint64_t mask = _equal_mask(j, index);
+					const field_affine_point& entry = table.window[i * WINDOW_SIZE + j];
+
+					for (size_t l = 0; l < LIMB_SIZE; l++)
+					{
+						p.x[l] |= entry.x[l] & mask;
+						p.y[l] |= entry.y[l] & mask;
+					}
 				}
-				else
+
+				p.y = _select(negative, f.neg(p.y), p.y);
+
+				r = i == 0 ? field_jacobian_point{ p.x, p.y, f.one() } : _point_add(r, p);
+			}
+
+			return r;
+		}
+
+		// Width-w non-adjacent form, every non-zero digit is odd and followed by at least w - 1 zeros
+		// https://en.wikipedia.org/wiki/Elliptic_curve_point_multiplication#w-ary_non-adjacent_form_(wNAF)_method
+		template<size_t W>
+		[[nodiscard]] static size_t _wnaf(const element_type& k, int8_t* naf) noexcept
+		{
+			uint64_t d[LIMB_SIZE + 1] = { 0 };
+			std::copy(k.begin(), k.end(), d);
+
+			size_t size = 0;
+
+			while (rb::math::_limbs_size(d, LIMB_SIZE + 1) != 0)
+			{
+				int32_t digit = 0;
+
+				if (d[0] & 1)
 				{
-					r1 = point_add(r0, r1);
-					r0 = point_double(r0);
+					digit = static_cast<int32_t>(d[0] & ((1U << W) - 1));
+
+					if (digit >= (1 << (W - 1)))
+						digit -= 1 << W;
+
+					const uint64_t delta = static_cast<uint64_t>(digit < 0 ? -digit : digit);
+
+					if (digit > 0)
+						rb::math::_limbs_sub(d, d, LIMB_SIZE + 1, &delta, 1);
+					else
+						rb::math::_limbs_add(d, d, LIMB_SIZE + 1, &delta, 1);
 				}
+
+				naf[size++] = static_cast<int8_t>(digit);
+				rb::math::_limbs_shr(d, d, LIMB_SIZE + 1, 1);
 			}
 
-			return r0;
+			return size;
 		}
 
-	private:
-		// Prime curve jacobian point addition
-		// https://en.wikibooks.org/wiki/Cryptography/Prime_Curve/Jacobian_Coordinates
-		[[nodiscard]] static jacobian_point_type point_add(const jacobian_point_type& p, const jacobian_point_type& q) noexcept
+		// Computes u1 * G + u2 * Q with interleaved width-w NAFs sharing one chain of doublings (Shamir's trick)
+		// https://www.hyperelliptic.org/tanja/conf/summerschool08/slides/Speed2.pdf
+		[[nodiscard]] static field_jacobian_point _multiply_add_generator(const element_type& u1, const element_type& u2, const field_jacobian_point& q) noexcept
 		{
-			if (p == JACOBIAN_INFINITY)
-				return q;
+			const generator_table_type& table = _generator_table();
 
-			if (q == JACOBIAN_INFINITY)
-				return p;
+			int8_t naf1[WNAF_SIZE]{ 0 };
+			int8_t naf2[WNAF_SIZE]{ 0 };
+
+			const size_t size1 = _wnaf<GENERATOR_WNAF_WIDTH>(u1, naf1);
+			const size_t size2 = _wnaf<POINT_WNAF_WIDTH>(u2, naf2);
+
+			// Odd multiples of Q
+			field_jacobian_point q_odd[size_t(1) << (POINT_WNAF_WIDTH - 2)];
+			const field_jacobian_point q2 = _point_double(q);
 
-			int_type qz_sqr = mod_p(std::get<2>(q) * std::get<2>(q)); // Z2^2
-			int_type u1 = mod_p(std::get<0>(p) * qz_sqr); // U1 = X1 * Z2^2
+			q_odd[0] = q;
 
-			int_type pz_sqr = mod_p(std::get<2>(p) * std::get<2>(p)); // Z1^2
-			int_type u2 = mod_p(std::get<0>(q) * pz_sqr); // U2 = X2 * Z1^2
+			for (size_t i = 1; i < std::size(q_odd); i++)
+				q_odd[i] = _point_add(q_odd[i - 1], q2);
 
-			int_type s1 = mod_p(mod_p(std::get<1>(p) * qz_sqr) * std::get<2>(q)); // S1 = Y1 * Z2^3
-			int_type s2 = mod_p(mod_p(std::get<1>(q) * pz_sqr) * std::get<2>(p)); // S2 = Y2 * Z1^3
+			field_jacobian_point r{};
 
-			if (u1 == u2)
+			for (size_t i = std::max(size1, size2); i-- > 0;)
 			{
-				if (s1 != s2)
-					return JACOBIAN_INFINITY;
-				
-				return point_double(p);
-			}
+				r = _point_double(r);
 
-			int_type h = mod_p(u2 - u1); // H = U2 - U1
-			int_type r = mod_p(s2 - s1); // R = S2 - S1
+				if (naf1[i] > 0)
+					r = _point_add(r, table.odd[naf1[i] / 2]);
+				else if (naf1[i] < 0)
+					r = _point_add(r, _point_negate(table.odd[-naf1[i] / 2]));
 
-			int_type h_sqr = mod_p(h * h); // H^2
-			int_type h_cb = mod_p(h_sqr * h); // H^3
-			
-			int_type x = mod_p(mod_p(r * r) - h_cb - mod_p(mod_p(u1 << 1) * h_sqr)); // X3 = R^2 - H^3 - 2 * U1 * H^2
-			int_type y = mod_p(mod_p(r * mod_p(mod_p(u1 * h_sqr - x))) - mod_p(s1 * h_cb)); // Y3 = R * (U1 * H^2 - X3) - S1 * H^3
-			int_type z = mod_p(mod_p(h * std::get<2>(p)) * std::get<2>(q)); // Z3 = H * Z1 * Z2
+				if (naf2[i] > 0)
+					r = _point_add(r, q_odd[naf2[i] / 2]);
+				else if (naf2[i] < 0)
+					r = _point_add(r, _point_negate(q_odd[-naf2[i] / 2]));
+			}
 
-			return { x, y, z };
+			return r;
 		}
 
-		// Prime curve jacobian point doubling
-		// https://en.wikibooks.org/wiki/Cryptography/Prime_Curve/Jacobian_Coordinates
-		[[nodiscard]] static jacobian_point_type point_double(const jacobian_point_type& p) noexcept
+	private:
+		// Random scalar in the range [1, n - 1]
+		[[nodiscard]] static element_type _random_scalar() noexcept
 		{
-			if (std::get<1>(p).is_zero())
-				return JACOBIAN_INFINITY;
+			static thread_local std::random_device rand;
+
+			const curve_type& curve = _curve();
+
+			const size_t bits = rb::math::_limbs_bits(curve.n.data(), LIMB_SIZE);
+			const size_t top = (bits - 1) / 64;
+			const uint64_t top_mask = bits % 64 == 0 ? ~uint64_t(0) : (uint64_t(1) << (bits % 64)) - 1;
+
+			while (true)
+			{
+				element_type k{ 0 };
 
-			int_type s = mod_p(mod_p(std::get<0>(p) * mod_p(std::get<1>(p) * std::get<1>(p))) << 2); // S = 4 * X * Y^2
+				for (size_t i = 0; i <= top * 2 + 1; i++)
+					k[i / 2] |= static_cast<uint64_t>(rand()) << (i % 2 * 32);
 
-			int_type z_qd = mod_p(std::get<2>(p) * std::get<2>(p)); // Z^4
-			z_qd = mod_p(z_qd * z_qd);
+				k[top] &= top_mask;
 
-			int_type m = mod_p(mod_p(mod_p(std::get<0>(p) * std::get<0>(p)) * 3) + mod_p(params::a * z_qd)); // M = 3 * X^2 + a * Z^4
+				if (!field_type::is_zero(k) && rb::math::_limbs_cmp(k.data(), curve.n.data(), LIMB_SIZE) < 0)
+					return k;
+			}
+		}
 
-			int_type x = mod_p(mod_p(m * m) - mod_p(s << 1)); // X' = M^2 - 2 * S
+		// Message digest interpreted as a little-endian integer modulo n
+		[[nodiscard]] static element_type _hash_to_scalar(const void* data, size_t size) noexcept
+		{
+			uint8_t digest[hash_type::DIGEST_SIZE / 8];
 
-			int_type y_qd = mod_p(std::get<1>(p) * std::get<1>(p)); // Y^4
-			y_qd = mod_p(y_qd * y_qd);
+			hash_type hash;
+			hash.write(data, size);
+			hash.digest(digest);
 
-			int_type y = mod_p(mod_p(m * (s - x)) - mod_p(y_qd << 3)); // Y' = M * (S - X') - 8 * Y^4
+			return _to_limbs(int_type(digest, hash_type::DIGEST_SIZE / 8) % params::n);
+		}
+
+		// Reduces an x-coordinate (below p) modulo n
+		[[nodiscard]] static element_type _reduce_scalar(element_type x) noexcept
+		{
+			const curve_type& curve = _curve();
 
-			int_type z = mod_p(mod_p(std::get<1>(p) * std::get<2>(p)) << 1); // Z' = 2 * Y * Z
-			
-			return { x, y, z };
+			while (rb::math::_limbs_cmp(x.data(), curve.n.data(), LIMB_SIZE) >= 0)
+				rb::math::_limbs_sub(x.data(), x.data(), LIMB_SIZE, curve.n.data(), LIMB_SIZE);
+
+			return x;
 		}
 
-		// Prime curve jacobian point multiplication by scalar
-		// https://en.wikibooks.org/wiki/Cryptography/Prime_Curve/Jacobian_Coordinates
-		[[nodiscard]] static jacobian_point_type point_multiply(const int_type& d, const jacobian_point_type& p) noexcept
+		// Checks x(R) mod n = r without converting R to affine coordinates, i.e. X = (r + i * n) * Z^2 for r + i * n < p
+		[[nodiscard]] static bool _check_x(const field_jacobian_point& R, element_type r) noexcept
 		{
-			jacobian_point_type  r0 = JACOBIAN_INFINITY;
-			jacobian_point_type  r1 = p;
-			int32_t m = static_cast<int32_t>(d.bits());
+			const curve_type& curve = _curve();
+			const element_type z_sqr = curve.fp.sqr(R.z);
 
-			for (int32_t i = m - 1; i >= 0; i--)
+			while (rb::math::_limbs_cmp(r.data(), curve.p.data(), LIMB_SIZE) < 0)
 			{
-				if ((d >> i).data()[0] & 1)
-				{
-					r0 = point_add(r0, r1);
-					r1 = point_double(r1);
-				}
-				else
-				{
-					r1 = point_add(r0, r1);
-					r0 = point_double(r0);
-				}
+				if (curve.fp.mul(curve.fp.to_montgomery(r), z_sqr) == R.x)
+					return true;
+
+				if (rb::math::_limbs_add(r.data(), r.data(), LIMB_SIZE, curve.n.data(), LIMB_SIZE) != 0)
+					break;
 			}
 
-			return r0;
+			return false;
 		}
 
 	public:
 		[[nodiscard]] static key_pair_type generate_key_pair() noexcept
 		{
-			static jacobian_point_type JACOBIAN_GENERATOR = point_affine_to_jacobian(GENERATOR);
-			static std::random_device rand;
-
-			int_type d = params::n;
+			const field_type& f = _curve().fp;
 
-			for (size_t i = 0; i < d.size(); i++)
-				d.data()[i] = static_cast<uint8_t>(rand() % 0x100U);
+			const element_type d = _random_scalar();
+			const field_affine_point Q = _to_affine(_multiply_generator(d));
 
-			d = (d % (params::n - int_type::ONE())) + int_type::ONE();
-
-			jacobian_point_type jQ = point_multiply(d, JACOBIAN_GENERATOR);
-			affine_point_type aQ = point_jacobian_to_affine(jQ);
-
-			return { d, aQ };
+			return { _from_limbs(d), { _from_limbs(f.from_montgomery(Q.x)), _from_limbs(f.from_montgomery(Q.y)) } };
 		}
 
 	public:
@@ -463,44 +828,39 @@ namespace rb::crypto
 		// https://www.secg.org/sec1-v2.pdf
 		[[nodiscard]] static signature_type sign(const private_key_type& d, const void* data, size_t size) noexcept
 		{
-			int_type r, s;
+			const curve_type& curve = _curve();
+			const field_type& fn = curve.fn;
+
+			const element_type e = _hash_to_scalar(data, size);
+			const element_type d_mont = fn.to_montgomery(_to_limbs(d));
 
-			uint8_t digest[hash_type::DIGEST_SIZE / 8];
-			
-			hash_type hash;
-			hash.write(data, size);
-			hash.digest(digest);
-			
-			int_type e = int_type(digest, hash_type::DIGEST_SIZE / 8);
-			
 			while (true)
 			{
-				const key_pair_type secret = generate_key_pair();
-
-				const private_key_type& k = std::get<0>(secret);
-				const public_key_type& R = std::get<1>(secret);
+				const element_type k = _random_scalar();
+				const field_affine_point R = _to_affine(_multiply_generator(k));
 
-				r = mod_n(std::get<0>(R));
+				const element_type r = _reduce_scalar(curve.fp.from_montgomery(R.x));
 
-				if (r.is_zero())
+				if (field_type::is_zero(r))
 					continue;
 
-				s = mod_n(inverse(k, params::n) * (e + mod_n(r * d)));
+				// Multiplying a regular integer by a Montgomery one yields a regular integer
+				const element_type k_inv = fn.inverse(fn.to_montgomery(k));
+				const element_type s = fn.mul(fn.add(e, fn.mul(r, d_mont)), k_inv);
 
-				if (s.is_zero())
+				if (field_type::is_zero(s))
 					continue;
 
-				break;
+				return { _from_limbs(r), _from_limbs(s) };
 			}
-
-			return { r, s };
 		}
 
 		// Signature verification algorithm
 		// https://www.secg.org/sec1-v2.pdf
 		[[nodiscard]] static bool verify(const public_key_type& Q, const signature_type& S, const void* data, size_t size) noexcept
 		{
-			static jacobian_point_type JACOBIAN_GENERATOR = point_affine_to_jacobian(GENERATOR);
+			const curve_type& curve = _curve();
+			const field_type& fn = curve.fn;
 
 			const int_type& r = std::get<0>(S);
 			const int_type& s = std::get<1>(S);
@@ -511,28 +871,46 @@ namespace rb::crypto
 			if (s < int_type::ONE() || s > params::n - int_type::ONE())
 				return false;
 
-			uint8_t digest[hash_type::DIGEST_SIZE / 8];
+			const int_type& Qx = std::get<0>(Q);
+			const int_type& Qy = std::get<1>(Q);
 
-			hash_type hash;
-			hash.write(data, size);
-			hash.digest(digest);
+			if (Qx < int_type::ZERO() || Qx >= params::p || Qy < int_type::ZERO() || Qy >= params::p)
+				return false;
+
+			const field_jacobian_point jQ = { curve.fp.to_montgomery(_to_limbs(Qx)), curve.fp.to_montgomery(_to_limbs(Qy)), curve.fp.one() };
 
-			int_type e = int_type(digest, hash_type::DIGEST_SIZE / 8);
+			if (!_is_on_curve({ jQ.x, jQ.y }))
+				return false;
 
-			const int_type inv_s = inverse(s, params::n);
-			int_type u1 = mod_n(e * inv_s);
-			int_type u2 = mod_n(r * inv_s);
+			const element_type e = _hash_to_scalar(data, size);
+			const element_type r_limbs = _to_limbs(r);
 
-			jacobian_point_type U1 = point_multiply(u1, JACOBIAN_GENERATOR);
-			jacobian_point_type U2 = point_multiply(u2, point_affine_to_jacobian(Q));
-			affine_point_type R = point_jacobian_to_affine(point_add(U1, U2));
+			const element_type s_inv = fn.inverse(fn.to_montgomery(_to_limbs(s)));
+			const element_type u1 = fn.mul(e, s_inv);
+			const element_type u2 = fn.mul(r_limbs, s_inv);
 
-			if (R == AFFINE_INFINITY)
+			const field_jacobian_point R = _multiply_add_generator(u1, u2, jQ);
+
+			if (field_type::is_zero(R.z))
 				return false;
 
-			int_type v = mod_n(std::get<0>(R));
+			return _check_x(R, r_limbs);
+		}
+
+		// Verifies `count` signatures on `thread_count` threads, see `thread::parallel_for`
+		static void verify_many(const public_key_type* keys, const signature_type* signatures, const void* const* data, const size_t* sizes, size_t count, bool* results, size_t thread_count = 0) noexcept
+		{
+			if (count == 0)
+				return;
+
+			// Build the shared tables before the workers start
+			static_cast<void>(_generator_table());
 
-			return v == r;
+			thread::parallel_for(count, thread_count, [&](size_t first, size_t last)
+			{
+				for (size_t i = first; i < last; i++)
+					results[i] = verify(keys[i], signatures[i], data[i], sizes[i]);
+			});
 		}
 	};
 
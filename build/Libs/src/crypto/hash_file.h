@@ -0,0 +1,32 @@
+#pragma once
+
+#include <filesystem>
+
+#include "data/mapped_file.h"
+
+namespace rb::crypto
+{
+	// Hashes the contents of a file with H and writes the digest to `dest`, returns false if the file cannot be read
+	// The file is memory mapped and its pages are written to the hash directly, so whole blocks are
+	// compressed in place without being copied. `hash` may be a keyed hash such as `hmac_context`.
+	template<class H>
+	[[nodiscard]] bool hash_file(const std::filesystem::path& path, void* dest, H hash = H()) noexcept
+	{
+		data::mapped_file file;
+
+		if (!file.open(path))
+			return false;
+
+		const bool read = file.read(0, file.size(), [&](const uint8_t* data, size_t size)
+		{
+			hash.write(data, size);
+		});
+
+		if (!read)
+			return false;
+
+		hash.digest(dest);
+
+		return true;
+	}
+}
@@ -2,15 +2,222 @@
 
 #include <vector>
 #include <memory>
+#include <cstring>
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 
 #include "bit/endian.h"
 
+#include "crypto/basic_hash.h"
 #include "crypto/basic_keyed_hash.h"
 
 namespace rb::crypto
 {
+	// HMAC with a fixed key, the hash states after absorbing K ^ ipad and K ^ opad are computed once,
+	// so a MAC only costs the message blocks and one outer block
+	// https://datatracker.ietf.org/doc/html/rfc2104
+	template<class H>
+	class hmac_context : public basic_hash
+	{
+	public:
+		static constexpr size_t BLOCK_SIZE = H::BLOCK_SIZE;
+		static constexpr size_t DIGEST_SIZE = H::DIGEST_SIZE;
+
+	public:
+		hmac_context() noexcept
+		{
+			set_key(nullptr, 0);
+		}
+
+		hmac_context(const void* key, size_t size) noexcept
+		{
+			set_key(key, size);
+		}
+
+		// Replaces the key and discards any written data
+		void set_key(const void* key, size_t size) noexcept
+		{
+			uint8_t real_key[BLOCK_SIZE / 8]{ 0 };
+
+			if (size > BLOCK_SIZE / 8)
+			{
+				H hash;
+				hash.write(key, size);
+				hash.digest(real_key);
+			}
+			else if (size > 0)
+				std::memcpy(real_key, key, size);
+
+			uint8_t pad[BLOCK_SIZE / 8];
+
+			for (size_t i = 0; i < BLOCK_SIZE / 8; i++)
+				pad[i] = real_key[i] ^ 0x36;
+
+			m_inner_key.clear();
+			m_inner_key.write(pad, BLOCK_SIZE / 8);
+
+			for (size_t i = 0; i < BLOCK_SIZE / 8; i++)
+				pad[i] = real_key[i] ^ 0x5C;
+
+			m_outer_key.clear();
+			m_outer_key.write(pad, BLOCK_SIZE / 8);
+
+			m_inner = m_inner_key;
+		}
+
+		// MAC of `data` alone, ignores and keeps the written data
+		void mac(const void* data, size_t size, void* dest) const noexcept
+		{
+			H inner = m_inner_key;
+			inner.write(data, size);
+
+			finish(inner, dest);
+		}
+
+		hmac_context& write(const void* data, size_t size) noexcept override
+		{
+			m_inner.write(data, size);
+			return *this;
+		}
+
+		void digest(void* dest) noexcept override
+		{
+			finish(m_inner, dest);
+		}
+
+		[[nodiscard]] std::string hex_digest() noexcept override
+		{
+			uint8_t hash[DIGEST_SIZE / 8];
+			digest(hash);
+
+			std::stringstream hex_digest;
+
+			for (uint8_t b : hash)
+				hex_digest << std::setw(2) << std::setfill('0') << std::hex << static_cast<uint32_t>(b);
+
+			return hex_digest.str();
+		}
+
+		// Discards the written data, the key is kept
+		void clear() noexcept override
+		{
+			m_inner = m_inner_key;
+		}
+
+		hmac_context& operator<<(char value) noexcept override
+		{
+			write(&value, 1);
+			return *this;
+		}
+
+		hmac_context& operator<<(unsigned char value) noexcept override
+		{
+			write(&value, 1);
+			return *this;
+		}
+
+		hmac_context& operator<<(short value) noexcept override
+		{
+			uint8_t bytes[sizeof(short)];
+			bit::write_be(bytes, value);
+			write(bytes, sizeof(short));
+			return *this;
+		}
+
+		hmac_context& operator<<(unsigned short value) noexcept override
+		{
+			uint8_t bytes[sizeof(unsigned short)];
+			bit::write_be(bytes, value);
+			write(bytes, sizeof(unsigned short));
+			return *this;
+		}
+
+		hmac_context& operator<<(int value) noexcept override
+		{
+			uint8_t bytes[sizeof(int)];
+			bit::write_be(bytes, value);
+			write(bytes, sizeof(int));
+			return *this;
+		}
+
+		hmac_context& operator<<(unsigned int value) noexcept override
+		{
+			uint8_t bytes[sizeof(unsigned int)];
+			bit::write_be(bytes, value);
+			write(bytes, sizeof(unsigned int));
+			return *this;
+		}
+
+		hmac_context& operator<<(long value) noexcept override
+		{
+			uint8_t bytes[sizeof(long)];
+			bit::write_be(bytes, value);
+			write(bytes, sizeof(long));
+			return *this;
+		}
+
+		hmac_context& operator<<(unsigned long value) noexcept override
+		{
+			uint8_t bytes[sizeof(unsigned long)];
+			bit::write_be(bytes, value);
+			write(bytes, sizeof(unsigned long));
+			return *this;
+		}
+
+		hmac_context& operator<<(long long value) noexcept override
+		{
+			uint8_t bytes[sizeof(long long)];
+			bit::write_be(bytes, value);
+			write(bytes, sizeof(long long));
+			return *this;
+		}
+
+		hmac_context& operator<<(unsigned long long value) noexcept override
+		{
+			uint8_t bytes[sizeof(unsigned long long)];
+			bit::write_be(bytes, value);
+			write(bytes, sizeof(unsigned long long));
+			return *this;
+		}
+
+		hmac_context& operator<<(const std::string& str) noexcept override
+		{
+			write(str.data(), str.size());
+			return *this;
+		}
+
+		[[nodiscard]] std::string operator()(const void* data, size_t size) noexcept override
+		{
+			clear();
+			write(data, size);
+			return hex_digest();
+		}
+
+		[[nodiscard]] std::string operator()(const std::string& str) noexcept override
+		{
+			clear();
+			write(str.data(), str.size());
+			return hex_digest();
+		}
+
+	private:
+		H m_inner_key;
+		H m_outer_key;
+		H m_inner;
+
+		// `H::digest` finalizes a copy, so `inner` is left as it is
+		void finish(H& inner, void* dest) const noexcept
+		{
+			uint8_t inner_hash[DIGEST_SIZE / 8];
+			inner.digest(inner_hash);
+
+			H outer = m_outer_key;
+			outer.write(inner_hash, DIGEST_SIZE / 8);
+			outer.digest(dest);
+		}
+	};
+
 	template<class H>
 	class hmac : public basic_keyed_hash
 	{
@@ -142,37 +349,9 @@ namespace rb::crypto
 
 		void process_data(const uint8_t* key, size_t size) noexcept
 		{
-			uint8_t real_key[BLOCK_SIZE / 8]{ 0 };
-
-			if (size > BLOCK_SIZE / 8)
-			{
-				H hash;
-				hash.write(key, size);
-				hash.digest(real_key);
-			}
-			else if (size < BLOCK_SIZE / 8)
-				std::memcpy(real_key, key, size);
-
-			uint8_t o_key_pad[BLOCK_SIZE / 8];
-			uint8_t i_key_pad[BLOCK_SIZE / 8];
-
-			for (size_t i = 0; i < BLOCK_SIZE / 8; i++)
-			{
-				o_key_pad[i] = real_key[i] ^ 0x5C;
-				i_key_pad[i] = real_key[i] ^ 0x36;
-			}
-
-			uint8_t i_hash[DIGEST_SIZE / 8];
-
-			H hash;
-			hash.write(i_key_pad, BLOCK_SIZE / 8);
-			hash.write(m_data.data(), m_data.size());
-			hash.digest(i_hash);
-			hash.clear();
-
-			hash.write(o_key_pad, BLOCK_SIZE / 8);
-			hash.write(i_hash, DIGEST_SIZE / 8);
-			hash.digest(m_hash);
+			hmac_context<H> context(key, size);
+			context.write(m_data.data(), m_data.size());
+			context.digest(m_hash);
 		}
 	};
 }
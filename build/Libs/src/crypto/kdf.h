@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstring>
+#include <algorithm>
+
+#include "bit/endian.h"
+
+#include "crypto/hmac.h"
+
+#include "thread/parallel.h"
+
+namespace rb::crypto
+{
+	// Computes block `index` of PBKDF2, only the first `size` bytes are written to `dest`
+	template<class H>
+	void _pbkdf2_block(const hmac_context<H>& prf, const void* salt, size_t salt_size, size_t iterations, uint32_t index, uint8_t* dest, size_t size) noexcept
+	{
+		constexpr size_t DIGEST_BYTES = H::DIGEST_SIZE / 8;
+
+		uint8_t u[DIGEST_BYTES];
+		uint8_t t[DIGEST_BYTES];
+
+		uint8_t counter[4];
+		bit::write_be(counter, index);
+
+		// U_1 = PRF(P, S || INT(i))
+		hmac_context<H> first = prf;
+		first.write(salt, salt_size).write(counter, sizeof(counter));
+		first.digest(u);
+
+		std::memcpy(t, u, DIGEST_BYTES);
+
+		// U_j = PRF(P, U_{j - 1}), every iteration only hashes U from the precomputed key midstates
+		for (size_t j = 1; j < iterations; j++)
+		{
+			prf.mac(u, DIGEST_BYTES, u);
+
+			for (size_t k = 0; k < DIGEST_BYTES; k++)
+				t[k] ^= u[k];
+		}
+
+		std::memcpy(dest, t, size);
+	}
+
+	// PBKDF2 with HMAC-H as the pseudorandom function
+	// The output blocks are independent and are computed on `thread_count` threads, see `thread::parallel_for`
+	// https://datatracker.ietf.org/doc/html/rfc8018#section-5.2
+	template<class H>
+	void pbkdf2_hmac(const void* password, size_t password_size, const void* salt, size_t salt_size, size_t iterations, void* dest, size_t dest_size, size_t thread_count = 0) noexcept
+	{
+		constexpr size_t DIGEST_BYTES = H::DIGEST_SIZE / 8;
+
+		if (dest_size == 0)
+			return;
+
+		const hmac_context<H> prf(password, password_size);
+
+		uint8_t* out = reinterpret_cast<uint8_t*>(dest);
+
+		const size_t count = (dest_size + DIGEST_BYTES - 1) / DIGEST_BYTES;
+
+		thread::parallel_for(count, thread_count, [&](size_t first, size_t last)
+		{
+			for (size_t i = first; i < last; i++)
+			{
+				const size_t size = std::min(DIGEST_BYTES, dest_size - i * DIGEST_BYTES);
+				_pbkdf2_block(prf, salt, salt_size, iterations, static_cast<uint32_t>(i + 1), out + i * DIGEST_BYTES, size);
+			}
+		});
+	}
+
+	// HKDF-Extract, writes `H::DIGEST_SIZE / 8` bytes of pseudorandom key to `prk`
+	// https://datatracker.ietf.org/doc/html/rfc5869
+	template<class H>
+	void hkdf_extract(const void* salt, size_t salt_size, const void* ikm, size_t ikm_size, void* prk) noexcept
+	{
+		// An empty salt is the same key as `DIGEST_SIZE` zero bytes, since HMAC pads keys with zeros
+		const hmac_context<H> prf(salt, salt_size);
+		prf.mac(ikm, ikm_size, prk);
+	}
+
+	// HKDF-Expand, returns `false` if more than 255 blocks of output are requested
+	template<class H>
+	[[nodiscard]] bool hkdf_expand(const void* prk, size_t prk_size, const void* info, size_t info_size, void* dest, size_t dest_size) noexcept
+	{
+		constexpr size_t DIGEST_BYTES = H::DIGEST_SIZE / 8;
+
+		if (dest_size > 255 * DIGEST_BYTES)
+			return false;
+
+		hmac_context<H> prf(prk, prk_size);
+
+		uint8_t* out = reinterpret_cast<uint8_t*>(dest);
+
+		uint8_t t[DIGEST_BYTES];
+		size_t t_size = 0;
+
+		// T(i) = HMAC(PRK, T(i - 1) || info || i)
+		for (uint8_t i = 1; dest_size > 0; i++)
+		{
+			prf.clear();
+			prf.write(t, t_size).write(info, info_size).write(&i, 1);
+			prf.digest(t);
+
+			t_size = DIGEST_BYTES;
+
+			const size_t size = std::min(dest_size, DIGEST_BYTES);
+			std::memcpy(out, t, size);
+
+			out += size;
+			dest_size -= size;
+		}
+
+		return true;
+	}
+
+	// HKDF-Extract followed by HKDF-Expand
+	template<class H>
+	[[nodiscard]] bool hkdf(const void* salt, size_t salt_size, const void* ikm, size_t ikm_size, const void* info, size_t info_size, void* dest, size_t dest_size) noexcept
+	{
+		uint8_t prk[H::DIGEST_SIZE / 8];
+		hkdf_extract<H>(salt, salt_size, ikm, ikm_size, prk);
+
+		return hkdf_expand<H>(prk, sizeof(prk), info, info_size, dest, dest_size);
+	}
+}
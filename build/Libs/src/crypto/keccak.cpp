@@ -1,86 +1,518 @@
 #include "pch.h"
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "bit/endian.h"
+
 #include "crypto/keccak.h"
 
-#define read_lane(s, x, y) reinterpret_cast<uint64_t*>(s)[(x) + 5 * (y)]
-#define write_lane(s, x, y, v) reinterpret_cast<uint64_t*>(s)[(x) + 5 * (y)] = (v)
-#define xor_lane(s, x, y, d) reinterpret_cast<uint64_t*>(s)[(x) + 5 * (y)] ^= (d)
+#include "thread/parallel.h"
 
 namespace rb::crypto
 {
-	int LFSR86540(uint8_t* LFSR)
+	static const uint64_t ROUND_CONSTANTS[24] = {
+		0x0000000000000001ull, 0x0000000000008082ull, 0x800000000000808Aull, 0x8000000080008000ull,
+		0x000000000000808Bull, 0x0000000080000001ull, 0x8000000080008081ull, 0x8000000000008009ull,
+		0x000000000000008Aull, 0x0000000000000088ull, 0x0000000080008009ull, 0x000000008000000Aull,
+		0x000000008000808Bull, 0x800000000000008Bull, 0x8000000000008089ull, 0x8000000000008003ull,
+		0x8000000000008002ull, 0x8000000000000080ull, 0x000000000000800Aull, 0x800000008000000Aull,
+		0x8000000080008081ull, 0x8000000000008080ull, 0x0000000080000001ull, 0x8000000080008008ull
+	};
+
+	// The lanes are kept in locals and the steps of a round are written out with the rho offsets and the
+	// pi permutation applied, so nothing but the round constant is looked up at run time
+	void keccak_p1600(uint64_t state[25], size_t rounds) noexcept
 	{
-		int result = ((*LFSR) & 0x01) != 0;
+		uint64_t a[25];
+		std::copy_n(state, 25, a);
+
+		for (size_t r = 24 - rounds; r < 24; r++)
+		{
+			// Theta
+			const uint64_t c0 = a[0] ^ a[5] ^ a[10] ^ a[15] ^ a[20];
+			const uint64_t c1 = a[1] ^ a[6] ^ a[11] ^ a[16] ^ a[21];
+			const uint64_t c2 = a[2] ^ a[7] ^ a[12] ^ a[17] ^ a[22];
+			const uint64_t c3 = a[3] ^ a[8] ^ a[13] ^ a[18] ^ a[23];
+			const uint64_t c4 = a[4] ^ a[9] ^ a[14] ^ a[19] ^ a[24];
+
+			const uint64_t d0 = c4 ^ bit::rotl(c1, 1);
+			const uint64_t d1 = c0 ^ bit::rotl(c2, 1);
+			const uint64_t d2 = c1 ^ bit::rotl(c3, 1);
+			const uint64_t d3 = c2 ^ bit::rotl(c4, 1);
+			const uint64_t d4 = c3 ^ bit::rotl(c0, 1);
+
+			// Rho and pi
+			const uint64_t b0 = a[0] ^ d0;
+			const uint64_t b1 = bit::rotl(a[6] ^ d1, 44);
+			const uint64_t b2 = bit::rotl(a[12] ^ d2, 43);
+			const uint64_t b3 = bit::rotl(a[18] ^ d3, 21);
+			const uint64_t b4 = bit::rotl(a[24] ^ d4, 14);
+			const uint64_t b5 = bit::rotl(a[3] ^ d3, 28);
+			const uint64_t b6 = bit::rotl(a[9] ^ d4, 20);
+			const uint64_t b7 = bit::rotl(a[10] ^ d0, 3);
+			const uint64_t b8 = bit::rotl(a[16] ^ d1, 45);
+			const uint64_t b9 = bit::rotl(a[22] ^ d2, 61);
+			const uint64_t b10 = bit::rotl(a[1] ^ d1, 1);
+			const uint64_t b11 = bit::rotl(a[7] ^ d2, 6);
+			const uint64_t b12 = bit::rotl(a[13] ^ d3, 25);
+			const uint64_t b13 = bit::rotl(a[19] ^ d4, 8);
+			const uint64_t b14 = bit::rotl(a[20] ^ d0, 18);
+			const uint64_t b15 = bit::rotl(a[4] ^ d4, 27);
+			const uint64_t b16 = bit::rotl(a[5] ^ d0, 36);
+			const uint64_t b17 = bit::rotl(a[11] ^ d1, 10);
+			const uint64_t b18 = bit::rotl(a[17] ^ d2, 15);
+			const uint64_t b19 = bit::rotl(a[23] ^ d3, 56);
+			const uint64_t b20 = bit::rotl(a[2] ^ d2, 62);
+			const uint64_t b21 = bit::rotl(a[8] ^ d3, 55);
+			const uint64_t b22 = bit::rotl(a[14] ^ d4, 39);
+			const uint64_t b23 = bit::rotl(a[15] ^ d0, 41);
+			const uint64_t b24 = bit::rotl(a[21] ^ d1, 2);
+
+			// Chi and iota
+			a[0] = b0 ^ (~b1 & b2) ^ ROUND_CONSTANTS[r];
+			a[1] = b1 ^ (~b2 & b3);
+			a[2] = b2 ^ (~b3 & b4);
+			a[3] = b3 ^ (~b4 & b0);
+			a[4] = b4 ^ (~b0 & b1);
+			a[5] = b5 ^ (~b6 & b7);
+			a[6] = b6 ^ (~b7 & b8);
+			a[7] = b7 ^ (~b8 & b9);
+			a[8] = b8 ^ (~b9 & b5);
+			a[9] = b9 ^ (~b5 & b6);
+			a[10] = b10 ^ (~b11 & b12);
+			a[11] = b11 ^ (~b12 & b13);
+			a[12] = b12 ^ (~b13 & b14);
+			a[13] = b13 ^ (~b14 & b10);
+			a[14] = b14 ^ (~b10 & b11);
+			a[15] = b15 ^ (~b16 & b17);
+			a[16] = b16 ^ (~b17 & b18);
+			a[17] = b17 ^ (~b18 & b19);
+			a[18] = b18 ^ (~b19 & b15);
+			a[19] = b19 ^ (~b15 & b16);
+			a[20] = b20 ^ (~b21 & b22);
+			a[21] = b21 ^ (~b22 & b23);
+			a[22] = b22 ^ (~b23 & b24);
+			a[23] = b23 ^ (~b24 & b20);
+			a[24] = b24 ^ (~b20 & b21);
+		}
 
-		if (((*LFSR) & 0x80) != 0)
-			(*LFSR) = ((*LFSR) << 1) ^ 0x71;
+		std::copy_n(a, 25, state);
+	}
+
+#if defined(__AVX2__)
+	template<int R>
+	[[nodiscard]] static inline __m256i rotl_x4(__m256i x) noexcept
+	{
+		if constexpr (R == 8)
+			return _mm256_shuffle_epi8(x, _mm256_setr_epi8(
+				7, 0, 1, 2, 3, 4, 5, 6, 15, 8, 9, 10, 11, 12, 13, 14,
+				7, 0, 1, 2, 3, 4, 5, 6, 15, 8, 9, 10, 11, 12, 13, 14));
+		else if constexpr (R == 56)
+			return _mm256_shuffle_epi8(x, _mm256_setr_epi8(
+				1, 2, 3, 4, 5, 6, 7, 0, 9, 10, 11, 12, 13, 14, 15, 8,
+				1, 2, 3, 4, 5, 6, 7, 0, 9, 10, 11, 12, 13, 14, 15, 8));
 		else
-			(*LFSR) <<= 1;
+			return _mm256_or_si256(_mm256_slli_epi64(x, R), _mm256_srli_epi64(x, 64 - R));
+	}
+
+	// Same round as `keccak_p1600`, every 64-bit AVX2 lane belongs to a different state
+	void keccak_p1600_x4(uint64_t state[25][4], size_t rounds) noexcept
+	{
+		__m256i a[25];
+
+		for (size_t i = 0; i < 25; i++)
+			a[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[i]));
+
+		for (size_t r = 24 - rounds; r < 24; r++)
+		{
+			// Theta
+			const __m256i c0 = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(a[0], a[5]), _mm256_xor_si256(a[10], a[15])), a[20]);
+			const __m256i c1 = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(a[1], a[6]), _mm256_xor_si256(a[11], a[16])), a[21]);
+			const __m256i c2 = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(a[2], a[7]), _mm256_xor_si256(a[12], a[17])), a[22]);
+			const __m256i c3 = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(a[3], a[8]), _mm256_xor_si256(a[13], a[18])), a[23]);
+			const __m256i c4 = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(a[4], a[9]), _mm256_xor_si256(a[14], a[19])), a[24]);
 
-		return result;
+			const __m256i d0 = _mm256_xor_si256(c4, rotl_x4<1>(c1));
+			const __m256i d1 = _mm256_xor_si256(c0, rotl_x4<1>(c2));
+			const __m256i d2 = _mm256_xor_si256(c1, rotl_x4<1>(c3));
+			const __m256i d3 = _mm256_xor_si256(c2, rotl_x4<1>(c4));
+			const __m256i d4 = _mm256_xor_si256(c3, rotl_x4<1>(c0));
+
+			// Rho and pi
+			const __m256i b0 = _mm256_xor_si256(a[0], d0);
+			const __m256i b1 = rotl_x4<44>(_mm256_xor_si256(a[6], d1));
+			const __m256i b2 = rotl_x4<43>(_mm256_xor_si256(a[12], d2));
+			const __m256i b3 = rotl_x4<21>(_mm256_xor_si256(a[18], d3));
+			const __m256i b4 = rotl_x4<14>(_mm256_xor_si256(a[24], d4));
+			const __m256i b5 = rotl_x4<28>(_mm256_xor_si256(a[3], d3));
+			const __m256i b6 = rotl_x4<20>(_mm256_xor_si256(a[9], d4));
+			const __m256i b7 = rotl_x4<3>(_mm256_xor_si256(a[10], d0));
+			const __m256i b8 = rotl_x4<45>(_mm256_xor_si256(a[16], d1));
+			const __m256i b9 = rotl_x4<61>(_mm256_xor_si256(a[22], d2));
+			const __m256i b10 = rotl_x4<1>(_mm256_xor_si256(a[1], d1));
+			const __m256i b11 = rotl_x4<6>(_mm256_xor_si256(a[7], d2));
+			const __m256i b12 = rotl_x4<25>(_mm256_xor_si256(a[13], d3));
+			const __m256i b13 = rotl_x4<8>(_mm256_xor_si256(a[19], d4));
+			const __m256i b14 = rotl_x4<18>(_mm256_xor_si256(a[20], d0));
+			const __m256i b15 = rotl_x4<27>(_mm256_xor_si256(a[4], d4));
+			const __m256i b16 = rotl_x4<36>(_mm256_xor_si256(a[5], d0));
+			const __m256i b17 = rotl_x4<10>(_mm256_xor_si256(a[11], d1));
+			const __m256i b18 = rotl_x4<15>(_mm256_xor_si256(a[17], d2));
+			const __m256i b19 = rotl_x4<56>(_mm256_xor_si256(a[23], d3));
+			const __m256i b20 = rotl_x4<62>(_mm256_xor_si256(a[2], d2));
+			const __m256i b21 = rotl_x4<55>(_mm256_xor_si256(a[8], d3));
+			const __m256i b22 = rotl_x4<39>(_mm256_xor_si256(a[14], d4));
+			const __m256i b23 = rotl_x4<41>(_mm256_xor_si256(a[15], d0));
+			const __m256i b24 = rotl_x4<2>(_mm256_xor_si256(a[21], d1));
+
+			// Chi and iota
+			a[0] = _mm256_xor_si256(_mm256_xor_si256(b0, _mm256_andnot_si256(b1, b2)), _mm256_set1_epi64x(static_cast<long long>(ROUND_CONSTANTS[r])));
+			a[1] = _mm256_xor_si256(b1, _mm256_andnot_si256(b2, b3));
+			a[2] = _mm256_xor_si256(b2, _mm256_andnot_si256(b3, b4));
+			a[3] = _mm256_xor_si256(b3, _mm256_andnot_si256(b4, b0));
+			a[4] = _mm256_xor_si256(b4, _mm256_andnot_si256(b0, b1));
+			a[5] = _mm256_xor_si256(b5, _mm256_andnot_si256(b6, b7));
+			a[6] = _mm256_xor_si256(b6, _mm256_andnot_si256(b7, b8));
+			a[7] = _mm256_xor_si256(b7, _mm256_andnot_si256(b8, b9));
+			a[8] = _mm256_xor_si256(b8, _mm256_andnot_si256(b9, b5));
+			a[9] = _mm256_xor_si256(b9, _mm256_andnot_si256(b5, b6));
+			a[10] = _mm256_xor_si256(b10, _mm256_andnot_si256(b11, b12));
+			a[11] = _mm256_xor_si256(b11, _mm256_andnot_si256(b12, b13));
+			a[12] = _mm256_xor_si256(b12, _mm256_andnot_si256(b13, b14));
+			a[13] = _mm256_xor_si256(b13, _mm256_andnot_si256(b14, b10));
+			a[14] = _mm256_xor_si256(b14, _mm256_andnot_si256(b10, b11));
+			a[15] = _mm256_xor_si256(b15, _mm256_andnot_si256(b16, b17));
+			a[16] = _mm256_xor_si256(b16, _mm256_andnot_si256(b17, b18));
+			a[17] = _mm256_xor_si256(b17, _mm256_andnot_si256(b18, b19));
+			a[18] = _mm256_xor_si256(b18, _mm256_andnot_si256(b19, b15));
+			a[19] = _mm256_xor_si256(b19, _mm256_andnot_si256(b15, b16));
+			a[20] = _mm256_xor_si256(b20, _mm256_andnot_si256(b21, b22));
+			a[21] = _mm256_xor_si256(b21, _mm256_andnot_si256(b22, b23));
+			a[22] = _mm256_xor_si256(b22, _mm256_andnot_si256(b23, b24));
+			a[23] = _mm256_xor_si256(b23, _mm256_andnot_si256(b24, b20));
+			a[24] = _mm256_xor_si256(b24, _mm256_andnot_si256(b20, b21));
+		}
+
+		for (size_t i = 0; i < 25; i++)
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(state[i]), a[i]);
+	}
+#else
+	void keccak_p1600_x4(uint64_t state[25][4], size_t rounds) noexcept
+	{
+		for (size_t j = 0; j < 4; j++)
+		{
+			uint64_t lanes[25];
+
+			for (size_t i = 0; i < 25; i++)
+				lanes[i] = state[i][j];
+
+			keccak_p1600(lanes, rounds);
+
+			for (size_t i = 0; i < 25; i++)
+				state[i][j] = lanes[i];
+		}
+	}
+#endif
+
+	void keccak_f1600_perm(uint8_t* state, size_t /*size*/) noexcept
+	{
+		keccak_p1600(reinterpret_cast<uint64_t*>(state), 24);
 	}
 
-	void keccak_f1600_perm(uint8_t* state, size_t size) noexcept
+	// Keccak-p[1600, 12] used by TurboSHAKE and KangarooTwelve
+	static void keccak_p1600_12_perm(uint8_t* state, size_t /*size*/) noexcept
 	{
-		uint8_t LFSRstate = 0x01;
+		keccak_p1600(reinterpret_cast<uint64_t*>(state), 12);
+	}
+
+	// Sponge parameters of the leaves of a tree hash, sizes are in bytes
+	struct leaf_params
+	{
+		size_t rate;
+		uint8_t domain;
+		size_t rounds;
+		size_t digest_size;
+	};
+
+	// Minimum number of 4-leaf groups given to each thread, smaller jobs are not worth a thread
+	static constexpr size_t GROUPS_PER_THREAD = 8;
 
-		for (size_t r = 0; r < 24; r++)
+	// Pads the last (partial) block of a leaf into `block`, which must be zeroed
+	static void pad_leaf(const leaf_params& params, const uint8_t* data, size_t size, uint8_t* block) noexcept
+	{
+		std::memcpy(block, data, size);
+
+		block[size] ^= params.domain;
+		block[params.rate - 1] ^= 0x80;
+	}
+
+	static void hash_leaf(const leaf_params& params, const uint8_t* data, size_t size, uint8_t* dest) noexcept
+	{
+		uint64_t state[25]{ 0 };
+		uint8_t block[200]{ 0 };
+
+		for (; size >= params.rate; data += params.rate, size -= params.rate)
 		{
-			{
-				uint64_t c[5] = { 0 }, d = 0;
+			for (size_t i = 0; i < params.rate / 8; i++)
+				state[i] ^= bit::read_le<uint64_t>(data + i * 8);
 
-				for (size_t x = 0; x < 5; x++)
-					c[x] = read_lane(state, x, 0) ^ read_lane(state, x, 1) ^
-					read_lane(state, x, 2) ^ read_lane(state, x, 3) ^ read_lane(state, x, 4);
+			keccak_p1600(state, params.rounds);
+		}
 
-				for (size_t x = 0; x < 5; x++)
-				{
-					d = c[(x + 4) % 5] ^ bit::rotl(c[(x + 1) % 5], 1);
+		pad_leaf(params, data, size, block);
 
-					for (size_t y = 0; y < 5; y++)
-						xor_lane(state, x, y, d);
-				}
-			}
+		for (size_t i = 0; i < params.rate / 8; i++)
+			state[i] ^= bit::read_le<uint64_t>(block + i * 8);
 
-			{
-				size_t x = 1, y = 0;
-				uint64_t current = read_lane(state, x, y);
+		keccak_p1600(state, params.rounds);
 
-				for (size_t t = 0; t < 24; t++)
-				{
-					uint32_t r = ((t + 1) * (t + 2) / 2) % 64;
-					uint32_t y_ = (2 * x + 3 * y) % 5;
+		for (size_t i = 0; i < params.digest_size / 8; i++)
+			bit::write_le(dest + i * 8, state[i]);
+	}
 
-					x = y;
-					y = y_;
+	// Hashes four leaves of the same size in the lanes of `keccak_p1600_x4`
+	static void hash_leaves_x4(const leaf_params& params, const uint8_t* const data[4], size_t size, uint8_t* const dest[4]) noexcept
+	{
+		uint64_t state[25][4]{};
+		uint8_t blocks[4][200]{};
 
-					uint64_t temp = read_lane(state, x, y);
-					write_lane(state, x, y, bit::rotl(current, r));
-					current = temp;
-				}
-			}
+		size_t offset = 0;
 
+		for (; offset + params.rate <= size; offset += params.rate)
+		{
+			for (size_t i = 0; i < params.rate / 8; i++)
+				for (size_t j = 0; j < 4; j++)
+					state[i][j] ^= bit::read_le<uint64_t>(data[j] + offset + i * 8);
+
+			keccak_p1600_x4(state, params.rounds);
+		}
+
+		for (size_t j = 0; j < 4; j++)
+			pad_leaf(params, data[j] + offset, size - offset, blocks[j]);
+
+		for (size_t i = 0; i < params.rate / 8; i++)
+			for (size_t j = 0; j < 4; j++)
+				state[i][j] ^= bit::read_le<uint64_t>(blocks[j] + i * 8);
+
+		keccak_p1600_x4(state, params.rounds);
+
+		for (size_t i = 0; i < params.digest_size / 8; i++)
+			for (size_t j = 0; j < 4; j++)
+				bit::write_le(dest[j] + i * 8, state[i][j]);
+	}
+
+	// Writes the digest of leaf i to `dest + i * params.digest_size`. Groups of four leaves with matching sizes
+	// go through the 4-way permutation, the groups are split between the threads.
+	static void hash_leaves(const leaf_params& params, const uint8_t* const* data, const size_t* sizes, size_t count, uint8_t* dest, size_t thread_count) noexcept
+	{
+		if (count == 0)
+			return;
+
+		const size_t groups = (count + 3) / 4;
+
+		thread::parallel_for(groups, thread_count, [&](size_t first, size_t last)
+		{
+			for (size_t g = first; g < last; g++)
 			{
-				uint64_t temp[5] = { 0 };
+				const size_t i = g * 4;
 
-				for (size_t y = 0; y < 5; y++)
+				if (i + 4 <= count && sizes[i] == sizes[i + 1] && sizes[i] == sizes[i + 2] && sizes[i] == sizes[i + 3])
 				{
-					for (size_t x = 0; x < 5; x++)
-						temp[x] = read_lane(state, x, y);
+					uint8_t* const out[4] = {
+						dest + (i + 0) * params.digest_size,
+						dest + (i + 1) * params.digest_size,
+						dest + (i + 2) * params.digest_size,
+						dest + (i + 3) * params.digest_size
+					};
 
-					for (size_t x = 0; x < 5; x++)
-						write_lane(state, x, y, temp[x] ^ ((~temp[(x + 1) % 5]) & temp[(x + 2) % 5]));
+					hash_leaves_x4(params, data + i, sizes[i], out);
+				}
+				else
+				{
+					for (size_t j = i; j < std::min(i + 4, count); j++)
+						hash_leaf(params, data[j], sizes[j], dest + j * params.digest_size);
 				}
 			}
+		}, GROUPS_PER_THREAD);
+	}
 
-			{
-				for (size_t j = 0; j < 7; j++) {
-					uint32_t bit_pos = (1 << j) - 1;
+	// left_encode from NIST SP 800-185, `dest` must hold 9 bytes
+	static size_t left_encode(uint64_t value, uint8_t* dest) noexcept
+	{
+		size_t n = 1;
 
-					if (LFSR86540(&LFSRstate))
-						xor_lane(state, 0, 0, 1ull << bit_pos);
-				}
-			}
+		while (n < 8 && (value >> (n * 8)) != 0)
+			n++;
+
+		dest[0] = static_cast<uint8_t>(n);
+
+		for (size_t i = 0; i < n; i++)
+			dest[1 + i] = static_cast<uint8_t>(value >> ((n - 1 - i) * 8));
+
+		return n + 1;
+	}
+
+	// right_encode from NIST SP 800-185, `dest` must hold 9 bytes
+	static size_t right_encode(uint64_t value, uint8_t* dest) noexcept
+	{
+		size_t n = 1;
+
+		while (n < 8 && (value >> (n * 8)) != 0)
+			n++;
+
+		for (size_t i = 0; i < n; i++)
+			dest[i] = static_cast<uint8_t>(value >> ((n - 1 - i) * 8));
+
+		dest[n] = static_cast<uint8_t>(n);
+
+		return n + 1;
+	}
+
+	// length_encode from KangarooTwelve, zero is encoded without any value bytes
+	static size_t length_encode(uint64_t value, uint8_t* dest) noexcept
+	{
+		size_t n = 0;
+
+		while (n < 8 && (value >> (n * 8)) != 0)
+			n++;
+
+		for (size_t i = 0; i < n; i++)
+			dest[i] = static_cast<uint8_t>(value >> ((n - 1 - i) * 8));
+
+		dest[n] = static_cast<uint8_t>(n);
+
+		return n + 1;
+	}
+
+	template<size_t R>
+	static void parallel_hash(const void* data, size_t size, size_t block_size, void* dest, size_t dest_size, const std::string& customization, size_t thread_count) noexcept
+	{
+		using cshake = basic_sponge<R, 1600 - R, 0x04, (1600 - R) / 2, &keccak_f1600_perm>;
+
+		static const std::string FUNCTION_NAME = "ParallelHash";
+
+		// Every block is hashed with cSHAKE without a name or customization, which is plain SHAKE
+		const leaf_params params{ R / 8, 0x1F, 24, (1600 - R) / 8 };
+
+		const uint8_t* message = reinterpret_cast<const uint8_t*>(data);
+
+		block_size = std::max<size_t>(block_size, 1);
+
+		const size_t count = (size + block_size - 1) / block_size;
+
+		std::vector<const uint8_t*> leaves(count);
+		std::vector<size_t> sizes(count);
+		std::vector<uint8_t> digests(count * params.digest_size);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			leaves[i] = message + i * block_size;
+			sizes[i] = std::min(block_size, size - i * block_size);
+		}
+
+		hash_leaves(params, leaves.data(), sizes.data(), count, digests.data(), thread_count);
+
+		cshake sponge;
+		uint8_t encoded[9];
+
+		// bytepad(encode_string(N) || encode_string(S), rate)
+		size_t prefix_size = left_encode(R / 8, encoded);
+		sponge.write(encoded, prefix_size);
+
+		size_t encoded_size = left_encode(FUNCTION_NAME.size() * 8, encoded);
+		sponge.write(encoded, encoded_size).write(FUNCTION_NAME.data(), FUNCTION_NAME.size());
+		prefix_size += encoded_size + FUNCTION_NAME.size();
+
+		encoded_size = left_encode(customization.size() * 8, encoded);
+		sponge.write(encoded, encoded_size).write(customization.data(), customization.size());
+		prefix_size += encoded_size + customization.size();
+
+		static const uint8_t zeros[R / 8]{ 0 };
+		sponge.write(zeros, (R / 8 - prefix_size % (R / 8)) % (R / 8));
+
+		encoded_size = left_encode(block_size, encoded);
+		sponge.write(encoded, encoded_size).write(digests.data(), digests.size());
+
+		encoded_size = right_encode(count, encoded);
+		sponge.write(encoded, encoded_size);
+
+		encoded_size = right_encode(dest_size * 8, encoded);
+		sponge.write(encoded, encoded_size);
+
+		sponge.squeeze(dest, dest_size);
+	}
+
+	void parallel_hash128(const void* data, size_t size, size_t block_size, void* dest, size_t dest_size, const std::string& customization, size_t thread_count) noexcept
+	{
+		parallel_hash<1344>(data, size, block_size, dest, dest_size, customization, thread_count);
+	}
+
+	void parallel_hash256(const void* data, size_t size, size_t block_size, void* dest, size_t dest_size, const std::string& customization, size_t thread_count) noexcept
+	{
+		parallel_hash<1088>(data, size, block_size, dest, dest_size, customization, thread_count);
+	}
+
+	void kangaroo_twelve(const void* data, size_t size, void* dest, size_t dest_size, const std::string& customization, size_t thread_count) noexcept
+	{
+		static constexpr size_t CHUNK_SIZE = 8192;
+
+		const leaf_params params{ 168, 0x0B, 12, 32 };
+
+		const uint8_t* message = reinterpret_cast<const uint8_t*>(data);
+
+		uint8_t encoded[9];
+		const size_t suffix_size = length_encode(customization.size(), encoded);
+
+		// S = M || C || length_encode(|C|)
+		const size_t total = size + customization.size() + suffix_size;
+
+		if (total <= CHUNK_SIZE)
+		{
+			basic_sponge<1344, 256, 0x07, 256, &keccak_p1600_12_perm> sponge;
+			sponge.write(message, size).write(customization.data(), customization.size()).write(encoded, suffix_size);
+			sponge.squeeze(dest, dest_size);
+			return;
 		}
+
+		// Chunks that lie entirely within the message are read in place, the rest of S is copied
+		const size_t count = (total + CHUNK_SIZE - 1) / CHUNK_SIZE;
+		const size_t in_place = size / CHUNK_SIZE;
+
+		std::vector<uint8_t> tail(total - in_place * CHUNK_SIZE);
+
+		std::memcpy(tail.data(), message + in_place * CHUNK_SIZE, size - in_place * CHUNK_SIZE);
+		std::memcpy(tail.data() + size - in_place * CHUNK_SIZE, customization.data(), customization.size());
+		std::memcpy(tail.data() + tail.size() - suffix_size, encoded, suffix_size);
+
+		const auto chunk = [&](size_t i)
+		{
+			return i < in_place ? message + i * CHUNK_SIZE : tail.data() + (i - in_place) * CHUNK_SIZE;
+		};
+
+		std::vector<const uint8_t*> leaves(count - 1);
+		std::vector<size_t> sizes(count - 1);
+		std::vector<uint8_t> chaining_values((count - 1) * params.digest_size);
+
+		for (size_t i = 1; i < count; i++)
+		{
+			leaves[i - 1] = chunk(i);
+			sizes[i - 1] = std::min(CHUNK_SIZE, total - i * CHUNK_SIZE);
+		}
+
+		hash_leaves(params, leaves.data(), sizes.data(), count - 1, chaining_values.data(), thread_count);
+
+		static const uint8_t first_marker[8] = { 0x03, 0, 0, 0, 0, 0, 0, 0 };
+		static const uint8_t last_marker[2] = { 0xFF, 0xFF };
+
+		basic_sponge<1344, 256, 0x06, 256, &keccak_p1600_12_perm> sponge;
+		sponge.write(chunk(0), CHUNK_SIZE).write(first_marker, sizeof(first_marker));
+		sponge.write(chaining_values.data(), chaining_values.size());
+
+		const size_t count_size = length_encode(count - 1, encoded);
+		sponge.write(encoded, count_size).write(last_marker, sizeof(last_marker));
+
+		sponge.squeeze(dest, dest_size);
 	}
 }
@@ -1,11 +1,20 @@
 #pragma once
 
+#include <string>
+
 #include "bit/rotate.h"
 
 #include "crypto/basic_sponge.h"
 
 namespace rb::crypto
 {
+	// Keccak-p[1600, rounds], the last `rounds` rounds of Keccak-f[1600]
+	// https://keccak.team/keccak_specs_summary.html
+	void keccak_p1600(uint64_t state[25], size_t rounds = 24) noexcept;
+
+	// Keccak-p[1600, rounds] of four independent states at once, `state[i][j]` is lane i of state j
+	void keccak_p1600_x4(uint64_t state[25][4], size_t rounds = 24) noexcept;
+
 	void keccak_f1600_perm(uint8_t* state, size_t size) noexcept;
 
 	template<size_t H>
@@ -18,4 +27,18 @@ namespace rb::crypto
 	using sha3_256 = basic_sponge<1088, 512, 0x06, 256, &keccak_f1600_perm>;
 	using sha3_384 = basic_sponge<832, 768, 0x06, 384, &keccak_f1600_perm>;
 	using sha3_512 = basic_sponge<576, 1024, 0x06, 512, &keccak_f1600_perm>;
+
+	// Tree hashes, the leaves are hashed four at a time with `keccak_p1600_x4` on `thread_count` threads,
+	// see `thread::parallel_for`. `size` and `dest_size` are in bytes.
+
+	// ParallelHash128 from NIST SP 800-185 with blocks of `block_size` bytes
+	// https://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-185.pdf
+	void parallel_hash128(const void* data, size_t size, size_t block_size, void* dest, size_t dest_size, const std::string& customization = {}, size_t thread_count = 0) noexcept;
+
+	// ParallelHash256 from NIST SP 800-185 with blocks of `block_size` bytes
+	void parallel_hash256(const void* data, size_t size, size_t block_size, void* dest, size_t dest_size, const std::string& customization = {}, size_t thread_count = 0) noexcept;
+
+	// KangarooTwelve, hashes 8 KiB chunks with the 12 round TurboSHAKE128
+	// https://www.rfc-editor.org/rfc/rfc9861
+	void kangaroo_twelve(const void* data, size_t size, void* dest, size_t dest_size, const std::string& customization = {}, size_t thread_count = 0) noexcept;
 }
@@ -24,31 +24,32 @@ namespace rb::crypto
 
 	void md5::pad_data() noexcept
 	{
-		uint64_t size = m_data.size() * 8ull;
+		const uint64_t size = m_size * 8ull;
 
-		m_data.push_back(0x80);
+		m_block[m_block_size++] = 0x80;
 
-		while ((m_data.size() % 64) != 56)
-			m_data.push_back(0);
+		if (m_block_size > 56)
+		{
+			std::memset(m_block + m_block_size, 0, 64 - m_block_size);
+			process_data(m_block, 1);
+			m_block_size = 0;
+		}
 
-		m_data.push_back(size & 0xFF); size >>= 8;
-		m_data.push_back(size & 0xFF); size >>= 8;
-		m_data.push_back(size & 0xFF); size >>= 8;
-		m_data.push_back(size & 0xFF); size >>= 8;
-		m_data.push_back(size & 0xFF); size >>= 8;
-		m_data.push_back(size & 0xFF); size >>= 8;
-		m_data.push_back(size & 0xFF); size >>= 8;
-		m_data.push_back(size & 0xFF);
+		std::memset(m_block + m_block_size, 0, 56 - m_block_size);
+		bit::write_le(m_block + 56, size);
+
+		process_data(m_block, 1);
+		m_block_size = 0;
 	}
 
-	void md5::process_data() noexcept
+	void md5::process_data(const uint8_t* data, size_t count) noexcept
 	{
-		for (size_t i = 0; i < m_data.size() / 64; i++)
+		for (size_t i = 0; i < count; i++, data += 64)
 		{
 			uint32_t M[16] = { 0 };
 			
 			for (size_t j = 0; j < 16; j++)
-				M[j] = m_data[j * 4] | (m_data[j * 4 + 1] << 8) | (m_data[j * 4 + 2] << 16) | (m_data[j * 4 + 3] << 24);
+				M[j] = bit::read_le<uint32_t>(data + j * 4);
 
 			uint32_t a = m_hash[0];
 			uint32_t b = m_hash[1];
@@ -100,29 +101,53 @@ namespace rb::crypto
 
 	md5& md5::write(const void* data, size_t size) noexcept
 	{
-		std::copy_n(reinterpret_cast<const uint8_t*>(data), size, std::back_inserter(m_data));
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+
+		m_size += size;
+
+		if (m_block_size > 0)
+		{
+			const size_t count = std::min(size, 64 - m_block_size);
+
+			std::memcpy(m_block + m_block_size, bytes, count);
+			m_block_size += count;
+			bytes += count;
+			size -= count;
+
+			if (m_block_size < 64)
+				return *this;
+
+			process_data(m_block, 1);
+			m_block_size = 0;
+		}
+
+		process_data(bytes, size / 64);
+
+		m_block_size = size % 64;
+		std::memcpy(m_block, bytes + size - m_block_size, m_block_size);
+
 		return *this;
 	}
 
 	void md5::digest(void* dest) noexcept
 	{
-		pad_data();
-		process_data();
+		md5 temp = *this;
+		temp.pad_data();
 
 		uint32_t* dest_u32 = reinterpret_cast<uint32_t*>(dest);
 
-		for (uint32_t h : m_hash)
+		for (uint32_t h : temp.m_hash)
 			bit::write_le(dest_u32++, h);
 	}
 
 	std::string md5::hex_digest() noexcept
 	{
-		pad_data();
-		process_data();
+		md5 temp = *this;
+		temp.pad_data();
 
 		std::stringstream hex_digest;
 		
-		for (uint32_t h : m_hash)
+		for (uint32_t h : temp.m_hash)
 		{
 			hex_digest << std::setw(2) << std::setfill('0') << std::hex << (h & 0xFF);
 			hex_digest << std::setw(2) << std::setfill('0') << std::hex << ((h >> 8) & 0xFF);
@@ -135,7 +160,8 @@ namespace rb::crypto
 
 	void md5::clear() noexcept
 	{
-		m_data.clear();
+		m_block_size = 0;
+		m_size = 0;
 
 		m_hash[0] = 0x67452301;
 		m_hash[1] = 0xEFCDAB89;
@@ -145,13 +171,13 @@ namespace rb::crypto
 
 	md5& md5::operator<<(char value) noexcept
 	{
-		m_data.push_back(value);
+		write(&value, 1);
 		return *this;
 	}
 
 	md5& md5::operator<<(unsigned char value) noexcept
 	{
-		m_data.push_back(value);
+		write(&value, 1);
 		return *this;
 	}
 
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <vector>
+#include <cstring>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
@@ -49,10 +49,12 @@ namespace rb::crypto
 		[[nodiscard]] std::string operator()(const std::string& str) noexcept override;
 
 	private:
-		std::vector<uint8_t> m_data;
+		uint8_t m_block[BLOCK_SIZE / 8];
+		size_t m_block_size;
+		uint64_t m_size;
 		uint32_t m_hash[4];
 
 		void pad_data() noexcept;
-		void process_data() noexcept;
+		void process_data(const uint8_t* data, size_t count) noexcept;
 	};
 }
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <filesystem>
+
+#include "data/mapped_file.h"
+#include "thread/parallel.h"
+
+namespace rb::crypto
+{
+	// Merkle tree over fixed-size chunks of a message, built from any hash H
+	// The chunks are hashed in parallel and every chunk digest is kept, so that a changed chunk can be
+	// found by comparing leaves and the root can be updated by rehashing only the path above it.
+	// Leaves are H(0x00 || chunk) and nodes are H(0x01 || left || right), a node without a sibling is
+	// moved up unchanged and an empty message has the root H(), like the Merkle Tree Hash of RFC 6962.
+	// https://datatracker.ietf.org/doc/html/rfc6962#section-2.1
+	template<class H>
+	class merkle_tree
+	{
+	public:
+		static constexpr size_t DIGEST_SIZE = H::DIGEST_SIZE;
+		static constexpr size_t DEFAULT_CHUNK_SIZE = size_t(1) << 20;
+
+	public:
+		// `hash` is copied for every node, so it may be a keyed hash such as `hmac_context`
+		explicit merkle_tree(size_t chunk_size = DEFAULT_CHUNK_SIZE, const H& hash = H()) noexcept
+			: m_chunk_size(std::max<size_t>(chunk_size, 1)), m_hash(hash)
+		{
+			clear();
+		}
+
+		// Builds the tree of `size` bytes of `data`, the chunks are hashed on `thread_count` threads, see `thread::parallel_for`
+		void build(const void* data, size_t size, size_t thread_count = 0) noexcept
+		{
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+
+			build_leaves(size, thread_count, [&](uint64_t offset, uint64_t count, const auto& f)
+			{
+				f(bytes + offset, static_cast<size_t>(count));
+				return true;
+			});
+		}
+
+		// Builds the tree of a memory mapped file, returns false if the file cannot be read
+		[[nodiscard]] bool build_file(const std::filesystem::path& path, size_t thread_count = 0) noexcept
+		{
+			data::mapped_file file;
+
+			if (!file.open(path))
+			{
+				clear();
+				return false;
+			}
+
+			return build_leaves(file.size(), thread_count, [&](uint64_t offset, uint64_t count, const auto& f)
+			{
+				return file.read(offset, count, f);
+			});
+		}
+
+		// Forgets every chunk, leaving the tree of an empty message
+		void clear() noexcept
+		{
+			m_size = 0;
+			m_levels.assign(1, {});
+		}
+
+		// Writes the `DIGEST_SIZE / 8` byte root to `dest`
+		void root(void* dest) const noexcept
+		{
+			if (leaf_count() == 0)
+			{
+				H hash = m_hash;
+				hash.digest(dest);
+				return;
+			}
+
+			std::memcpy(dest, m_levels.back().data(), DIGEST_SIZE / 8);
+		}
+
+		[[nodiscard]] std::string hex_root() const noexcept
+		{
+			uint8_t hash[DIGEST_SIZE / 8];
+			root(hash);
+
+			return hex(hash);
+		}
+
+		[[nodiscard]] size_t chunk_size() const noexcept { return m_chunk_size; }
+
+		// Size of the message in bytes
+		[[nodiscard]] uint64_t size() const noexcept { return m_size; }
+
+		[[nodiscard]] size_t leaf_count() const noexcept { return m_levels.front().size() / (DIGEST_SIZE / 8); }
+
+		// Digest of chunk `index`, `DIGEST_SIZE / 8` bytes long
+		[[nodiscard]] const uint8_t* leaf(size_t index) const noexcept
+		{
+			return m_levels.front().data() + index * (DIGEST_SIZE / 8);
+		}
+
+		[[nodiscard]] std::string hex_leaf(size_t index) const noexcept
+		{
+			return hex(leaf(index));
+		}
+
+		// Returns true if `data` hashes to the digest of chunk `index`
+		[[nodiscard]] bool verify_chunk(size_t index, const void* data, size_t size) const noexcept
+		{
+			if (index >= leaf_count())
+				return false;
+
+			uint8_t hash[DIGEST_SIZE / 8];
+			hash_leaf(data, size, hash);
+
+			return std::memcmp(hash, leaf(index), sizeof(hash)) == 0;
+		}
+
+		// Replaces the contents of chunk `index` and rehashes the nodes above it, returns false if there is no such chunk
+		// The chunk keeps its position, so only the last chunk may change its size.
+		[[nodiscard]] bool update_chunk(size_t index, const void* data, size_t size) noexcept
+		{
+			if (index >= leaf_count() || size == 0 || size > m_chunk_size || (index + 1 < leaf_count() && size != m_chunk_size))
+				return false;
+
+			if (index + 1 == leaf_count())
+				m_size = static_cast<uint64_t>(index) * m_chunk_size + size;
+
+			hash_leaf(data, size, m_levels.front().data() + index * (DIGEST_SIZE / 8));
+
+			for (size_t level = 1; level < m_levels.size(); level++)
+			{
+				index /= 2;
+				hash_node(level, index);
+			}
+
+			return true;
+		}
+
+	private:
+		size_t m_chunk_size;
+		uint64_t m_size;
+
+		H m_hash;
+
+		// Digests of every level from the leaves to the root, tightly packed
+		std::vector<std::vector<uint8_t>> m_levels;
+
+		void hash_leaf(const void* data, size_t size, uint8_t* dest) const noexcept
+		{
+			const uint8_t prefix = 0x00;
+
+			H hash = m_hash;
+			hash.write(&prefix, 1).write(data, size);
+			hash.digest(dest);
+		}
+
+		// Computes node `index` of `level` from its children on the level below
+		void hash_node(size_t level, size_t index) noexcept
+		{
+			constexpr size_t DIGEST_BYTES = DIGEST_SIZE / 8;
+
+			const std::vector<uint8_t>& children = m_levels[level - 1];
+			uint8_t* node = m_levels[level].data() + index * DIGEST_BYTES;
+
+			if ((2 * index + 2) * DIGEST_BYTES > children.size())
+			{
+				std::memcpy(node, children.data() + 2 * index * DIGEST_BYTES, DIGEST_BYTES);
+				return;
+			}
+
+			const uint8_t prefix = 0x01;
+
+			H hash = m_hash;
+			hash.write(&prefix, 1).write(children.data() + 2 * index * DIGEST_BYTES, 2 * DIGEST_BYTES);
+			hash.digest(node);
+		}
+
+		// Hashes every chunk of a `size` byte message, `read(offset, count, f)` has to call `f(data, size)`
+		// on consecutive pieces of the bytes [offset, offset + count) and return false on failure
+		template<class R>
+		bool build_leaves(uint64_t size, size_t thread_count, const R& read) noexcept
+		{
+			constexpr size_t DIGEST_BYTES = DIGEST_SIZE / 8;
+
+			const size_t count = static_cast<size_t>((size + m_chunk_size - 1) / m_chunk_size);
+
+			m_size = size;
+			m_levels.assign(1, std::vector<uint8_t>(count * DIGEST_BYTES));
+
+			if (count == 0)
+				return true;
+
+			std::atomic<bool> success = true;
+
+			// Every thread reads its chunks as one sequential range, a chunk may span several pieces
+			thread::parallel_for(count, thread_count, [&](size_t first, size_t last)
+			{
+				const uint64_t begin = static_cast<uint64_t>(first) * m_chunk_size;
+				const uint64_t end = std::min<uint64_t>(static_cast<uint64_t>(last) * m_chunk_size, size);
+
+				const uint8_t prefix = 0x00;
+
+				size_t index = first;
+				uint64_t remaining = std::min<uint64_t>(m_chunk_size, size - begin);
+
+				H hash = m_hash;
+				hash.write(&prefix, 1);
+
+				const auto f = [&](const uint8_t* data, size_t data_size)
+				{
+					while (data_size > 0)
+					{
+						const size_t n = static_cast<size_t>(std::min<uint64_t>(data_size, remaining));
+
+						hash.write(data, n);
+
+						data += n;
+						data_size -= n;
+						remaining -= n;
+
+						if (remaining > 0)
+							continue;
+
+						hash.digest(m_levels.front().data() + index * DIGEST_BYTES);
+
+						index++;
+						remaining = std::min<uint64_t>(m_chunk_size, size - std::min<uint64_t>(static_cast<uint64_t>(index) * m_chunk_size, size));
+
+						hash = m_hash;
+						hash.write(&prefix, 1);
+					}
+				};
+
+				if (!read(begin, end - begin, f))
+					success = false;
+			});
+
+			if (!success)
+			{
+				clear();
+				return false;
+			}
+
+			for (size_t level = 1, nodes = count; nodes > 1; level++)
+			{
+				nodes = (nodes + 1) / 2;
+				m_levels.emplace_back(nodes * DIGEST_BYTES);
+
+				for (size_t i = 0; i < nodes; i++)
+					hash_node(level, i);
+			}
+
+			return true;
+		}
+
+		[[nodiscard]] static std::string hex(const uint8_t* hash) noexcept
+		{
+			std::stringstream hex_digest;
+
+			for (size_t i = 0; i < DIGEST_SIZE / 8; i++)
+				hex_digest << std::setw(2) << std::setfill('0') << std::hex << static_cast<uint32_t>(hash[i]);
+
+			return hex_digest.str();
+		}
+	};
+}
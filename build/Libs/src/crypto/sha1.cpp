@@ -1,36 +1,201 @@
 #include "pch.h"
 
+#include <immintrin.h>
+
+#include "intrin/cpu.h"
+
 #include "crypto/sha1.h"
 
 namespace rb::crypto
 {
+	// Performs 20 rounds (5 groups of 4) of SHA-1 with the round function and constant selected by F
+	template<int F>
+	static inline void rounds_shani(__m128i& abcd, __m128i& e, __m128i& prev, __m128i w[4], size_t first) noexcept
+	{
+		for (size_t j = first; j < first + 5; j++)
+		{
+			if (j >= 4)
+			{
+				// W[t] = rotl(W[t - 3] ^ W[t - 8] ^ W[t - 14] ^ W[t - 16], 1)
+				__m128i temp = _mm_sha1msg1_epu32(w[j & 3], w[(j + 1) & 3]);
+				temp = _mm_xor_si128(temp, w[(j + 2) & 3]);
+				w[j & 3] = _mm_sha1msg2_epu32(temp, w[(j + 3) & 3]);
+			}
+
+			e = j == 0 ? _mm_add_epi32(e, w[0]) : _mm_sha1nexte_epu32(prev, w[j & 3]);
+			prev = abcd;
+			abcd = _mm_sha1rnds4_epu32(abcd, e, F);
+		}
+	}
+
+	// SHA-1 compression using the Intel SHA extensions
+	// https://www.intel.com/content/www/us/en/developer/articles/technical/intel-sha-extensions.html
+	static void process_data_shani(uint32_t hash[5], const uint8_t* data, size_t count) noexcept
+	{
+		const __m128i mask = _mm_set_epi64x(0x0001020304050607ull, 0x08090A0B0C0D0E0Full);
+
+		__m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hash)), 0x1B);
+		__m128i e = _mm_set_epi32(static_cast<int>(hash[4]), 0, 0, 0);
+
+		for (size_t i = 0; i < count; i++, data += 64)
+		{
+			const __m128i abcd_save = abcd;
+			const __m128i e_save = e;
+
+			__m128i w[4], prev = abcd;
+
+			for (size_t j = 0; j < 4; j++)
+				w[j] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + j * 16)), mask);
+
+			rounds_shani<0>(abcd, e, prev, w, 0);
+			rounds_shani<1>(abcd, e, prev, w, 5);
+			rounds_shani<2>(abcd, e, prev, w, 10);
+			rounds_shani<3>(abcd, e, prev, w, 15);
+
+			e = _mm_sha1nexte_epu32(prev, e_save);
+			abcd = _mm_add_epi32(abcd, abcd_save);
+		}
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(hash), _mm_shuffle_epi32(abcd, 0x1B));
+		hash[4] = static_cast<uint32_t>(_mm_extract_epi32(e, 3));
+	}
+
+	template<int R>
+	[[nodiscard]] static inline __m256i rotl_x8(__m256i x) noexcept
+	{
+		return _mm256_or_si256(_mm256_slli_epi32(x, R), _mm256_srli_epi32(x, 32 - R));
+	}
+
+	// Loads 8 consecutive big-endian words from 8 blocks and transposes them, so that w[i] holds word i of every lane
+	static void load_words_x8(const uint8_t* const blocks[8], size_t offset, __m256i w[8]) noexcept
+	{
+		const __m256i mask = _mm256_setr_epi8(
+			3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+			3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+		__m256i r[8], t[8];
+
+		for (size_t i = 0; i < 8; i++)
+			r[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks[i] + offset));
+
+		for (size_t i = 0; i < 8; i += 2)
+		{
+			t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+			t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+		}
+
+		for (size_t i = 0; i < 8; i += 4)
+		{
+			r[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+			r[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+			r[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+			r[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+		}
+
+		for (size_t i = 0; i < 4; i++)
+		{
+			w[i] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r[i], r[i + 4], 0x20), mask);
+			w[i + 4] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r[i], r[i + 4], 0x31), mask);
+		}
+	}
+
+	// SHA-1 compression of 8 independent blocks, one per 32-bit AVX2 lane
+	// state[i] holds word i of every lane's hash
+	static void process_data_x8(uint32_t state[5][8], const uint8_t* const blocks[8]) noexcept
+	{
+		__m256i w[16];
+
+		load_words_x8(blocks, 0, w);
+		load_words_x8(blocks, 32, w + 8);
+
+		__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[0]));
+		__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[1]));
+		__m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[2]));
+		__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[3]));
+		__m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[4]));
+
+		for (size_t j = 0; j < 80; j++)
+		{
+			if (j >= 16)
+			{
+				__m256i temp = _mm256_xor_si256(_mm256_xor_si256(w[(j - 3) & 15], w[(j - 8) & 15]), _mm256_xor_si256(w[(j - 14) & 15], w[j & 15]));
+				w[j & 15] = rotl_x8<1>(temp);
+			}
+
+			__m256i f, k;
+
+			if (j >= 60)
+			{
+				f = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+				k = _mm256_set1_epi32(static_cast<int>(0xCA62C1D6));
+			}
+			else if (j >= 40)
+			{
+				f = _mm256_or_si256(_mm256_and_si256(b, c), _mm256_and_si256(d, _mm256_or_si256(b, c)));
+				k = _mm256_set1_epi32(static_cast<int>(0x8F1BBCDC));
+			}
+			else if (j >= 20)
+			{
+				f = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+				k = _mm256_set1_epi32(static_cast<int>(0x6ED9EBA1));
+			}
+			else
+			{
+				f = _mm256_xor_si256(d, _mm256_and_si256(b, _mm256_xor_si256(c, d)));
+				k = _mm256_set1_epi32(static_cast<int>(0x5A827999));
+			}
+
+			__m256i temp = _mm256_add_epi32(_mm256_add_epi32(rotl_x8<5>(a), f), _mm256_add_epi32(_mm256_add_epi32(e, k), w[j & 15]));
+			e = d;
+			d = c;
+			c = rotl_x8<30>(b);
+			b = a;
+			a = temp;
+		}
+
+		const __m256i result[5] = { a, b, c, d, e };
+
+		for (size_t i = 0; i < 5; i++)
+		{
+			__m256i* p = reinterpret_cast<__m256i*>(state[i]);
+			_mm256_storeu_si256(p, _mm256_add_epi32(_mm256_loadu_si256(p), result[i]));
+		}
+	}
+
 	void sha1::pad_data() noexcept
 	{
-		uint64_t size = m_data.size() * 8ull;
+		const uint64_t size = m_size * 8ull;
 
-		m_data.push_back(0x80);
+		m_block[m_block_size++] = 0x80;
 
-		while ((m_data.size() % 64) != 56)
-			m_data.push_back(0);
+		if (m_block_size > 56)
+		{
+			std::memset(m_block + m_block_size, 0, 64 - m_block_size);
+			process_data(m_block, 1);
+			m_block_size = 0;
+		}
 
-		m_data.push_back((size >> 56) & 0xFF);
-		m_data.push_back((size >> 48) & 0xFF);
-		m_data.push_back((size >> 40) & 0xFF);
-		m_data.push_back((size >> 32) & 0xFF);
-		m_data.push_back((size >> 24) & 0xFF);
-		m_data.push_back((size >> 16) & 0xFF);
-		m_data.push_back((size >> 8) & 0xFF);
-		m_data.push_back(size & 0xFF);
+		std::memset(m_block + m_block_size, 0, 56 - m_block_size);
+		bit::write_be(m_block + 56, size);
+
+		process_data(m_block, 1);
+		m_block_size = 0;
 	}
 
-	void sha1::process_data() noexcept
+	void sha1::process_data(const uint8_t* data, size_t count) noexcept
 	{
-		for (size_t i = 0; i < m_data.size() / 64; i++)
+		if (intrin::cpu().sha)
+		{
+			process_data_shani(m_hash, data, count);
+			return;
+		}
+
+		for (size_t i = 0; i < count; i++, data += 64)
 		{
 			uint32_t w[80] = { 0 };
 			
 			for (size_t j = 0; j < 16; j++)
-				w[j] = m_data[j * 4 + 3] | (m_data[j * 4 + 2] << 8) | (m_data[j * 4 + 1] << 16) | (m_data[j * 4] << 24);
+				w[j] = bit::read_be<uint32_t>(data + j * 4);
 
 			for (size_t j = 16; j < 80; j++)
 				w[j] = bit::rotl(w[j - 3] ^ w[j - 8] ^ w[j - 14] ^ w[j - 16], 1);
@@ -88,29 +253,53 @@ namespace rb::crypto
 
 	sha1& sha1::write(const void* data, size_t size) noexcept
 	{
-		std::copy_n(reinterpret_cast<const uint8_t*>(data), size, std::back_inserter(m_data));
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+
+		m_size += size;
+
+		if (m_block_size > 0)
+		{
+			const size_t count = std::min(size, 64 - m_block_size);
+
+			std::memcpy(m_block + m_block_size, bytes, count);
+			m_block_size += count;
+			bytes += count;
+			size -= count;
+
+			if (m_block_size < 64)
+				return *this;
+
+			process_data(m_block, 1);
+			m_block_size = 0;
+		}
+
+		process_data(bytes, size / 64);
+
+		m_block_size = size % 64;
+		std::memcpy(m_block, bytes + size - m_block_size, m_block_size);
+
 		return *this;
 	}
 	
 	void sha1::digest(void* dest) noexcept
 	{
-		pad_data();
-		process_data();
+		sha1 temp = *this;
+		temp.pad_data();
 
 		uint32_t* dest_u32 = reinterpret_cast<uint32_t*>(dest);
 
-		for (uint32_t h : m_hash)
+		for (uint32_t h : temp.m_hash)
 			bit::write_be(dest_u32++, h);
 	}
 
 	std::string sha1::hex_digest() noexcept
 	{
-		pad_data();
-		process_data();
+		sha1 temp = *this;
+		temp.pad_data();
 
 		std::stringstream hex_digest;
 		
-		for (uint32_t h : m_hash)
+		for (uint32_t h : temp.m_hash)
 			hex_digest << std::setw(8) << std::setfill('0') << std::hex << h;
 
 		return hex_digest.str();
@@ -118,7 +307,8 @@ namespace rb::crypto
 
 	void sha1::clear() noexcept
 	{
-		m_data.clear();
+		m_block_size = 0;
+		m_size = 0;
 
 		m_hash[0] = 0x67452301;
 		m_hash[1] = 0xEFCDAB89;
@@ -129,13 +319,13 @@ namespace rb::crypto
 	
 	sha1& sha1::operator<<(char value) noexcept
 	{
-		m_data.push_back(value);
+		write(&value, 1);
 		return *this;
 	}
 
 	sha1& sha1::operator<<(unsigned char value) noexcept
 	{
-		m_data.push_back(value);
+		write(&value, 1);
 		return *this;
 	}
 
@@ -222,4 +412,114 @@ namespace rb::crypto
 		write(str.data(), str.size());
 		return hex_digest();
 	}
+
+	void sha1::hash_many(const void* const* msgs, const size_t* lens, size_t n, uint8_t* out) noexcept
+	{
+		if (intrin::cpu().sha)
+		{
+			sha1 hash;
+
+			for (size_t i = 0; i < n; i++)
+			{
+				hash.clear();
+				hash.write(msgs[i], lens[i]);
+				hash.digest(out + i * (DIGEST_SIZE / 8));
+			}
+
+			return;
+		}
+
+		_hash_many_x8(msgs, lens, n, out);
+	}
+
+	void sha1::_hash_many_x8(const void* const* msgs, const size_t* lens, size_t n, uint8_t* out) noexcept
+	{
+		// Every lane hashes one message at a time. A message is read in place up to its last full block,
+		// then from a padded copy of its tail. When a lane finishes, it picks up the next message.
+		struct lane
+		{
+			size_t job;
+			const uint8_t* data;
+			size_t full_blocks;
+			size_t total_blocks;
+			size_t next_block;
+			uint8_t tail[128];
+		};
+
+		static const uint8_t zero_block[64]{ 0 };
+		const sha1 initial;
+
+		uint32_t state[5][8];
+		lane lanes[8];
+		size_t next_job = 0;
+		size_t active = 0;
+
+		const auto assign = [&](size_t l) noexcept
+		{
+			lane& ln = lanes[l];
+
+			if (next_job == n)
+			{
+				ln.job = n;
+				return;
+			}
+
+			const size_t size = lens[next_job];
+			const size_t rem = size % 64;
+
+			ln.job = next_job++;
+			ln.data = reinterpret_cast<const uint8_t*>(msgs[ln.job]);
+			ln.full_blocks = size / 64;
+			ln.total_blocks = ln.full_blocks + (rem + 9 > 64 ? 2 : 1);
+			ln.next_block = 0;
+
+			std::memset(ln.tail, 0, sizeof(ln.tail));
+			std::memcpy(ln.tail, ln.data + ln.full_blocks * 64, rem);
+			ln.tail[rem] = 0x80;
+			bit::write_be(ln.tail + (ln.total_blocks - ln.full_blocks) * 64 - 8, size * 8ull);
+
+			for (size_t i = 0; i < 5; i++)
+				state[i][l] = initial.m_hash[i];
+
+			active++;
+		};
+
+		for (size_t l = 0; l < 8; l++)
+			assign(l);
+
+		while (active > 0)
+		{
+			const uint8_t* blocks[8];
+
+			for (size_t l = 0; l < 8; l++)
+			{
+				const lane& ln = lanes[l];
+
+				if (ln.job == n)
+					blocks[l] = zero_block;
+				else if (ln.next_block < ln.full_blocks)
+					blocks[l] = ln.data + ln.next_block * 64;
+				else
+					blocks[l] = ln.tail + (ln.next_block - ln.full_blocks) * 64;
+			}
+
+			process_data_x8(state, blocks);
+
+			for (size_t l = 0; l < 8; l++)
+			{
+				lane& ln = lanes[l];
+
+				if (ln.job == n || ++ln.next_block < ln.total_blocks)
+					continue;
+
+				uint8_t* dest = out + ln.job * (DIGEST_SIZE / 8);
+
+				for (size_t i = 0; i < 5; i++)
+					bit::write_be(dest + i * 4, state[i][l]);
+
+				active--;
+				assign(l);
+			}
+		}
+	}
 }
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <vector>
+#include <cstring>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
@@ -48,11 +48,19 @@ namespace rb::crypto
 		[[nodiscard]] std::string operator()(const void* data, size_t size) noexcept override;
 		[[nodiscard]] std::string operator()(const std::string& str) noexcept override;
 
+		// Hashes `n` independent messages, writing the digest of `msgs[i]` to `out + i * DIGEST_SIZE / 8`.
+		static void hash_many(const void* const* msgs, const size_t* lens, size_t n, uint8_t* out) noexcept;
+
+		// AVX2 kernel of `hash_many` that hashes eight messages side by side, used when SHA-NI is not available
+		static void _hash_many_x8(const void* const* msgs, const size_t* lens, size_t n, uint8_t* out) noexcept;
+
 	private:
-		std::vector<uint8_t> m_data;
+		uint8_t m_block[BLOCK_SIZE / 8];
+		size_t m_block_size;
+		uint64_t m_size;
 		uint32_t m_hash[5];
 
 		void pad_data() noexcept;
-		void process_data() noexcept;
+		void process_data(const uint8_t* data, size_t count) noexcept;
 	};
 }
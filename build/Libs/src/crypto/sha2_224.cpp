@@ -25,31 +25,32 @@ namespace rb::crypto
 
 	void sha2_224::pad_data() noexcept
 	{
-		uint64_t size = m_data.size() * 8ull;
+		const uint64_t size = m_size * 8ull;
 
-		m_data.push_back(0x80);
+		m_block[m_block_size++] = 0x80;
 
-		while ((m_data.size() % 64) != 56)
-			m_data.push_back(0);
+		if (m_block_size > 56)
+		{
+			std::memset(m_block + m_block_size, 0, 64 - m_block_size);
+			process_data(m_block, 1);
+			m_block_size = 0;
+		}
 
-		m_data.push_back((size >> 56) & 0xFF);
-		m_data.push_back((size >> 48) & 0xFF);
-		m_data.push_back((size >> 40) & 0xFF);
-		m_data.push_back((size >> 32) & 0xFF);
-		m_data.push_back((size >> 24) & 0xFF);
-		m_data.push_back((size >> 16) & 0xFF);
-		m_data.push_back((size >> 8) & 0xFF);
-		m_data.push_back(size & 0xFF);
+		std::memset(m_block + m_block_size, 0, 56 - m_block_size);
+		bit::write_be(m_block + 56, size);
+
+		process_data(m_block, 1);
+		m_block_size = 0;
 	}
 	
-	void sha2_224::process_data() noexcept
+	void sha2_224::process_data(const uint8_t* data, size_t count) noexcept
 	{
-		for (size_t i = 0; i < m_data.size() / 64; i++)
+		for (size_t i = 0; i < count; i++, data += 64)
 		{
 			uint32_t w[64] = { 0 };
 			
 			for (size_t j = 0; j < 16; j++)
-				w[j] = rb::bit::read_be<uint32_t>(&m_data[i * 64 + j * 4]);
+				w[j] = rb::bit::read_be<uint32_t>(data + j * 4);
 
 			for (size_t j = 16; j < 64; j++)
 			{
@@ -104,37 +105,62 @@ namespace rb::crypto
 	
 	sha2_224& sha2_224::write(const void* data, size_t size) noexcept
 	{
-		std::copy_n(reinterpret_cast<const uint8_t*>(data), size, std::back_inserter(m_data));
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+
+		m_size += size;
+
+		if (m_block_size > 0)
+		{
+			const size_t count = std::min(size, 64 - m_block_size);
+
+			std::memcpy(m_block + m_block_size, bytes, count);
+			m_block_size += count;
+			bytes += count;
+			size -= count;
+
+			if (m_block_size < 64)
+				return *this;
+
+			process_data(m_block, 1);
+			m_block_size = 0;
+		}
+
+		process_data(bytes, size / 64);
+
+		m_block_size = size % 64;
+		std::memcpy(m_block, bytes + size - m_block_size, m_block_size);
+
 		return *this;
 	}
 	
 	void sha2_224::digest(void* dest) noexcept
 	{
-		pad_data();
-		process_data();
+		sha2_224 temp = *this;
+		temp.pad_data();
 
 		uint32_t* dest_u32 = reinterpret_cast<uint32_t*>(dest);
 
 		for (size_t i = 0; i < 7; i++)
-			bit::write_be(dest_u32++, m_hash[i]);
+			bit::write_be(dest_u32++, temp.m_hash[i]);
 	}
 
 	std::string sha2_224::hex_digest() noexcept
 	{
-		pad_data();
-		process_data();
+		sha2_224 temp = *this;
+		temp.pad_data();
 
 		std::stringstream hex_digest;
 		
 		for (size_t i = 0; i < 7; i++)
-			hex_digest << std::setw(8) << std::setfill('0') << std::hex << m_hash[i];
+			hex_digest << std::setw(8) << std::setfill('0') << std::hex << temp.m_hash[i];
 
 		return hex_digest.str();
 	}
 	
 	void sha2_224::clear() noexcept
 	{
-		m_data.clear();
+		m_block_size = 0;
+		m_size = 0;
 
 		m_hash[0] = 0xC1059ED8;
 		m_hash[1] = 0x367CD507;
@@ -148,13 +174,13 @@ namespace rb::crypto
 	
 	sha2_224& sha2_224::operator<<(char value) noexcept
 	{
-		m_data.push_back(value);
+		write(&value, 1);
 		return *this;
 	}
 
 	sha2_224& sha2_224::operator<<(unsigned char value) noexcept
 	{
-		m_data.push_back(value);
+		write(&value, 1);
 		return *this;
 	}
 
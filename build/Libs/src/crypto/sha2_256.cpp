@@ -1,5 +1,9 @@
 #include "pch.h"
 
+#include <immintrin.h>
+
+#include "intrin/cpu.h"
+
 #include "crypto/sha2.h"
 
 namespace rb::crypto
@@ -23,33 +27,183 @@ namespace rb::crypto
 		0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
 	};
 
+	// SHA-256 compression using the Intel SHA extensions
+	// https://www.intel.com/content/www/us/en/developer/articles/technical/intel-sha-extensions.html
+	static void process_data_shani(uint32_t hash[8], const uint8_t* data, size_t count) noexcept
+	{
+		const __m128i mask = _mm_set_epi64x(0x0C0D0E0F08090A0Bull, 0x0405060700010203ull);
+
+		__m128i temp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hash)), 0xB1); // CDAB
+		__m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hash + 4)), 0x1B); // EFGH
+		__m128i state0 = _mm_alignr_epi8(temp, state1, 8); // ABEF
+		state1 = _mm_blend_epi16(state1, temp, 0xF0); // CDGH
+
+		for (size_t i = 0; i < count; i++, data += 64)
+		{
+			const __m128i abef = state0;
+			const __m128i cdgh = state1;
+
+			__m128i w[4];
+
+			for (size_t j = 0; j < 4; j++)
+				w[j] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + j * 16)), mask);
+
+			for (size_t j = 0; j < 16; j++)
+			{
+				if (j >= 4)
+				{
+					// W[t] = s1(W[t - 2]) + W[t - 7] + s0(W[t - 15]) + W[t - 16]
+					temp = _mm_sha256msg1_epu32(w[j & 3], w[(j + 1) & 3]);
+					temp = _mm_add_epi32(temp, _mm_alignr_epi8(w[(j + 3) & 3], w[(j + 2) & 3], 4));
+					w[j & 3] = _mm_sha256msg2_epu32(temp, w[(j + 3) & 3]);
+				}
+
+				__m128i msg = _mm_add_epi32(w[j & 3], _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + j * 4)));
+				state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+				msg = _mm_shuffle_epi32(msg, 0x0E);
+				state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+			}
+
+			state0 = _mm_add_epi32(state0, abef);
+			state1 = _mm_add_epi32(state1, cdgh);
+		}
+
+		temp = _mm_shuffle_epi32(state0, 0x1B); // FEBA
+		state1 = _mm_shuffle_epi32(state1, 0xB1); // DCHG
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(hash), _mm_blend_epi16(temp, state1, 0xF0)); // DCBA
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(hash + 4), _mm_alignr_epi8(state1, temp, 8)); // HGFE
+	}
+
+	template<int R>
+	[[nodiscard]] static inline __m256i rotr_x8(__m256i x) noexcept
+	{
+		return _mm256_or_si256(_mm256_srli_epi32(x, R), _mm256_slli_epi32(x, 32 - R));
+	}
+
+	// Loads 8 consecutive big-endian words from 8 blocks and transposes them, so that w[i] holds word i of every lane
+	static void load_words_x8(const uint8_t* const blocks[8], size_t offset, __m256i w[8]) noexcept
+	{
+		const __m256i mask = _mm256_setr_epi8(
+			3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+			3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+		__m256i r[8], t[8];
+
+		for (size_t i = 0; i < 8; i++)
+			r[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks[i] + offset));
+
+		for (size_t i = 0; i < 8; i += 2)
+		{
+			t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+			t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+		}
+
+		for (size_t i = 0; i < 8; i += 4)
+		{
+			r[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+			r[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+			r[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+			r[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+		}
+
+		for (size_t i = 0; i < 4; i++)
+		{
+			w[i] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r[i], r[i + 4], 0x20), mask);
+			w[i + 4] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r[i], r[i + 4], 0x31), mask);
+		}
+	}
+
+	// SHA-256 compression of 8 independent blocks, one per 32-bit AVX2 lane
+	// state[i] holds word i of every lane's hash
+	static void process_data_x8(uint32_t state[8][8], const uint8_t* const blocks[8]) noexcept
+	{
+		__m256i w[16];
+
+		load_words_x8(blocks, 0, w);
+		load_words_x8(blocks, 32, w + 8);
+
+		__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[0]));
+		__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[1]));
+		__m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[2]));
+		__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[3]));
+		__m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[4]));
+		__m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[5]));
+		__m256i g = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[6]));
+		__m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[7]));
+
+		for (size_t j = 0; j < 64; j++)
+		{
+			if (j >= 16)
+			{
+				const __m256i w15 = w[(j - 15) & 15];
+				const __m256i w2 = w[(j - 2) & 15];
+
+				__m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr_x8<7>(w15), rotr_x8<18>(w15)), _mm256_srli_epi32(w15, 3));
+				__m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr_x8<17>(w2), rotr_x8<19>(w2)), _mm256_srli_epi32(w2, 10));
+				w[j & 15] = _mm256_add_epi32(_mm256_add_epi32(w[j & 15], s0), _mm256_add_epi32(w[(j - 7) & 15], s1));
+			}
+
+			__m256i S1 = _mm256_xor_si256(_mm256_xor_si256(rotr_x8<6>(e), rotr_x8<11>(e)), rotr_x8<25>(e));
+			__m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+			__m256i temp1 = _mm256_add_epi32(_mm256_add_epi32(h, S1), _mm256_add_epi32(ch, _mm256_add_epi32(_mm256_set1_epi32(K[j]), w[j & 15])));
+			__m256i S0 = _mm256_xor_si256(_mm256_xor_si256(rotr_x8<2>(a), rotr_x8<13>(a)), rotr_x8<22>(a));
+			__m256i maj = _mm256_xor_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_xor_si256(a, b)));
+			__m256i temp2 = _mm256_add_epi32(S0, maj);
+
+			h = g;
+			g = f;
+			f = e;
+			e = _mm256_add_epi32(d, temp1);
+			d = c;
+			c = b;
+			b = a;
+			a = _mm256_add_epi32(temp1, temp2);
+		}
+
+		const __m256i result[8] = { a, b, c, d, e, f, g, h };
+
+		for (size_t i = 0; i < 8; i++)
+		{
+			__m256i* p = reinterpret_cast<__m256i*>(state[i]);
+			_mm256_storeu_si256(p, _mm256_add_epi32(_mm256_loadu_si256(p), result[i]));
+		}
+	}
+
 	void sha2_256::pad_data() noexcept
 	{
-		uint64_t size = m_data.size() * 8ull;
+		const uint64_t size = m_size * 8ull;
 
-		m_data.push_back(0x80);
+		m_block[m_block_size++] = 0x80;
+
+		if (m_block_size > 56)
+		{
+			std::memset(m_block + m_block_size, 0, 64 - m_block_size);
+			process_data(m_block, 1);
+			m_block_size = 0;
+		}
 
-		while ((m_data.size() % 64) != 56)
-			m_data.push_back(0);
+		std::memset(m_block + m_block_size, 0, 56 - m_block_size);
+		bit::write_be(m_block + 56, size);
 
-		m_data.push_back((size >> 56) & 0xFF);
-		m_data.push_back((size >> 48) & 0xFF);
-		m_data.push_back((size >> 40) & 0xFF);
-		m_data.push_back((size >> 32) & 0xFF);
-		m_data.push_back((size >> 24) & 0xFF);
-		m_data.push_back((size >> 16) & 0xFF);
-		m_data.push_back((size >> 8) & 0xFF);
-		m_data.push_back(size & 0xFF);
+		process_data(m_block, 1);
+		m_block_size = 0;
 	}
 	
-	void sha2_256::process_data() noexcept
+	void sha2_256::process_data(const uint8_t* data, size_t count) noexcept
 	{
-		for (size_t i = 0; i < m_data.size() / 64; i++)
+		if (intrin::cpu().sha)
+		{
+			process_data_shani(m_hash, data, count);
+			return;
+		}
+
+		for (size_t i = 0; i < count; i++, data += 64)
 		{
 			uint32_t w[64] = { 0 };
 			
 			for (size_t j = 0; j < 16; j++)
-				w[j] = rb::bit::read_be<uint32_t>(&m_data[i * 64 + j * 4]);
+				w[j] = rb::bit::read_be<uint32_t>(data + j * 4);
 
 			for (size_t j = 16; j < 64; j++)
 			{
@@ -104,29 +258,53 @@ namespace rb::crypto
 	
 	sha2_256& sha2_256::write(const void* data, size_t size) noexcept
 	{
-		std::copy_n(reinterpret_cast<const uint8_t*>(data), size, std::back_inserter(m_data));
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+
+		m_size += size;
+
+		if (m_block_size > 0)
+		{
+			const size_t count = std::min(size, 64 - m_block_size);
+
+			std::memcpy(m_block + m_block_size, bytes, count);
+			m_block_size += count;
+			bytes += count;
+			size -= count;
+
+			if (m_block_size < 64)
+				return *this;
+
+			process_data(m_block, 1);
+			m_block_size = 0;
+		}
+
+		process_data(bytes, size / 64);
+
+		m_block_size = size % 64;
+		std::memcpy(m_block, bytes + size - m_block_size, m_block_size);
+
 		return *this;
 	}
 	
 	void sha2_256::digest(void* dest) noexcept
 	{
-		pad_data();
-		process_data();
+		sha2_256 temp = *this;
+		temp.pad_data();
 
 		uint32_t* dest_u32 = reinterpret_cast<uint32_t*>(dest);
 
-		for (uint32_t h : m_hash)
+		for (uint32_t h : temp.m_hash)
 			bit::write_be(dest_u32++, h);
 	}
 
 	std::string sha2_256::hex_digest() noexcept
 	{
-		pad_data();
-		process_data();
+		sha2_256 temp = *this;
+		temp.pad_data();
 
 		std::stringstream hex_digest;
 		
-		for (uint32_t h : m_hash)
+		for (uint32_t h : temp.m_hash)
 			hex_digest << std::setw(8) << std::setfill('0') << std::hex << h;
 
 		return hex_digest.str();
@@ -134,7 +312,8 @@ namespace rb::crypto
 	
 	void sha2_256::clear() noexcept
 	{
-		m_data.clear();
+		m_block_size = 0;
+		m_size = 0;
 
 		m_hash[0] = 0x6A09E667;
 		m_hash[1] = 0xBB67AE85;
@@ -148,13 +327,13 @@ namespace rb::crypto
 	
 	sha2_256& sha2_256::operator<<(char value) noexcept
 	{
-		m_data.push_back(value);
+		write(&value, 1);
 		return *this;
 	}
 
 	sha2_256& sha2_256::operator<<(unsigned char value) noexcept
 	{
-		m_data.push_back(value);
+		write(&value, 1);
 		return *this;
 	}
 
@@ -241,4 +420,114 @@ namespace rb::crypto
 		write(str.data(), str.size());
 		return hex_digest();
 	}
+
+	void sha2_256::hash_many(const void* const* msgs, const size_t* lens, size_t n, uint8_t* out) noexcept
+	{
+		if (intrin::cpu().sha)
+		{
+			sha2_256 hash;
+
+			for (size_t i = 0; i < n; i++)
+			{
+				hash.clear();
+				hash.write(msgs[i], lens[i]);
+				hash.digest(out + i * (DIGEST_SIZE / 8));
+			}
+
+			return;
+		}
+
+		_hash_many_x8(msgs, lens, n, out);
+	}
+
+	void sha2_256::_hash_many_x8(const void* const* msgs, const size_t* lens, size_t n, uint8_t* out) noexcept
+	{
+		// Every lane hashes one message at a time. A message is read in place up to its last full block,
+		// then from a padded copy of its tail. When a lane finishes, it picks up the next message.
+		struct lane
+		{
+			size_t job;
+			const uint8_t* data;
+			size_t full_blocks;
+			size_t total_blocks;
+			size_t next_block;
+			uint8_t tail[128];
+		};
+
+		static const uint8_t zero_block[64]{ 0 };
+		const sha2_256 initial;
+
+		uint32_t state[8][8];
+		lane lanes[8];
+		size_t next_job = 0;
+		size_t active = 0;
+
+		const auto assign = [&](size_t l) noexcept
+		{
+			lane& ln = lanes[l];
+
+			if (next_job == n)
+			{
+				ln.job = n;
+				return;
+			}
+
+			const size_t size = lens[next_job];
+			const size_t rem = size % 64;
+
+			ln.job = next_job++;
+			ln.data = reinterpret_cast<const uint8_t*>(msgs[ln.job]);
+			ln.full_blocks = size / 64;
+			ln.total_blocks = ln.full_blocks + (rem + 9 > 64 ? 2 : 1);
+			ln.next_block = 0;
+
+			std::memset(ln.tail, 0, sizeof(ln.tail));
+			std::memcpy(ln.tail, ln.data + ln.full_blocks * 64, rem);
+			ln.tail[rem] = 0x80;
+			bit::write_be(ln.tail + (ln.total_blocks - ln.full_blocks) * 64 - 8, size * 8ull);
+
+			for (size_t i = 0; i < 8; i++)
+				state[i][l] = initial.m_hash[i];
+
+			active++;
+		};
+
+		for (size_t l = 0; l < 8; l++)
+			assign(l);
+
+		while (active > 0)
+		{
+			const uint8_t* blocks[8];
+
+			for (size_t l = 0; l < 8; l++)
+			{
+				const lane& ln = lanes[l];
+
+				if (ln.job == n)
+					blocks[l] = zero_block;
+				else if (ln.next_block < ln.full_blocks)
+					blocks[l] = ln.data + ln.next_block * 64;
+				else
+					blocks[l] = ln.tail + (ln.next_block - ln.full_blocks) * 64;
+			}
+
+			process_data_x8(state, blocks);
+
+			for (size_t l = 0; l < 8; l++)
+			{
+				lane& ln = lanes[l];
+
+				if (ln.job == n || ++ln.next_block < ln.total_blocks)
+					continue;
+
+				uint8_t* dest = out + ln.job * (DIGEST_SIZE / 8);
+
+				for (size_t i = 0; i < 8; i++)
+					bit::write_be(dest + i * 4, state[i][l]);
+
+				active--;
+				assign(l);
+			}
+		}
+	}
 }
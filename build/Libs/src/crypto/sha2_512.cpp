@@ -29,32 +29,32 @@ namespace rb::crypto
 
 	void sha2_512::pad_data() noexcept
 	{
-		uint64_t size = m_data.size() * 8ull;
-		
-		m_data.push_back(0x80);
+		const uint64_t size = m_size * 8ull;
+
+		m_block[m_block_size++] = 0x80;
+
+		if (m_block_size > 112)
+		{
+			std::memset(m_block + m_block_size, 0, 128 - m_block_size);
+			process_data(m_block, 1);
+			m_block_size = 0;
+		}
 
-		while ((m_data.size() % 128) != 112)
-			m_data.push_back(0);
+		std::memset(m_block + m_block_size, 0, 120 - m_block_size);
+		bit::write_be(m_block + 120, size);
 
-		std::fill_n(std::back_inserter(m_data), 8, 0);
-		m_data.push_back((size >> 56) & 0xFF);
-		m_data.push_back((size >> 48) & 0xFF);
-		m_data.push_back((size >> 40) & 0xFF);
-		m_data.push_back((size >> 32) & 0xFF);
-		m_data.push_back((size >> 24) & 0xFF);
-		m_data.push_back((size >> 16) & 0xFF);
-		m_data.push_back((size >> 8) & 0xFF);
-		m_data.push_back(size & 0xFF);
+		process_data(m_block, 1);
+		m_block_size = 0;
 	}
 	
-	void sha2_512::process_data() noexcept
+	void sha2_512::process_data(const uint8_t* data, size_t count) noexcept
 	{
-		for (size_t i = 0; i < m_data.size() / 128; i++)
+		for (size_t i = 0; i < count; i++, data += 128)
 		{
 			uint64_t w[80] = { 0 };
 			
 			for (size_t j = 0; j < 16; j++)
-				w[j] = rb::bit::read_be<uint64_t>(&m_data[i * 128 + j * 8]);
+				w[j] = rb::bit::read_be<uint64_t>(data + j * 8);
 
 			for (size_t j = 16; j < 80; j++)
 			{
@@ -109,29 +109,53 @@ namespace rb::crypto
 	
 	sha2_512& sha2_512::write(const void* data, size_t size) noexcept
 	{
-		std::copy_n(reinterpret_cast<const uint8_t*>(data), size, std::back_inserter(m_data));
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+
+		m_size += size;
+
+		if (m_block_size > 0)
+		{
+			const size_t count = std::min(size, 128 - m_block_size);
+
+			std::memcpy(m_block + m_block_size, bytes, count);
+			m_block_size += count;
+			bytes += count;
+			size -= count;
+
+			if (m_block_size < 128)
+				return *this;
+
+			process_data(m_block, 1);
+			m_block_size = 0;
+		}
+
+		process_data(bytes, size / 128);
+
+		m_block_size = size % 128;
+		std::memcpy(m_block, bytes + size - m_block_size, m_block_size);
+
 		return *this;
 	}
 	
 	void sha2_512::digest(void* dest) noexcept
 	{
-		pad_data();
-		process_data();
+		sha2_512 temp = *this;
+		temp.pad_data();
 
 		uint64_t* dest_u64 = reinterpret_cast<uint64_t*>(dest);
 
-		for (uint64_t h : m_hash)
+		for (uint64_t h : temp.m_hash)
 			bit::write_be(dest_u64++, h);
 	}
 
 	std::string sha2_512::hex_digest() noexcept
 	{
-		pad_data();
-		process_data();
+		sha2_512 temp = *this;
+		temp.pad_data();
 
 		std::stringstream hex_digest;
 		
-		for (uint64_t h : m_hash)
+		for (uint64_t h : temp.m_hash)
 			hex_digest << std::setw(16) << std::setfill('0') << std::hex << h;
 
 		return hex_digest.str();
@@ -139,7 +163,8 @@ namespace rb::crypto
 	
 	void sha2_512::clear() noexcept
 	{
-		m_data.clear();
+		m_block_size = 0;
+		m_size = 0;
 
 		m_hash[0] = 0x6A09E667F3BCC908ull;
 		m_hash[1] = 0xBB67AE8584CAA73Bull;
@@ -153,13 +178,13 @@ namespace rb::crypto
 	
 	sha2_512& sha2_512::operator<<(char value) noexcept
 	{
-		m_data.push_back(value);
+		write(&value, 1);
 		return *this;
 	}
 
 	sha2_512& sha2_512::operator<<(unsigned char value) noexcept
 	{
-		m_data.push_back(value);
+		write(&value, 1);
 		return *this;
 	}
 
@@ -0,0 +1,149 @@
+#include "pch.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "data/mapped_file.h"
+
+#if !defined(_WIN32)
+// Offsets past 2 GiB would be truncated and `fstat` fails on such files, see `_FILE_OFFSET_BITS` in premake5.lua
+static_assert(sizeof(off_t) >= 8, "`mapped_file` requires a 64-bit off_t, build with _FILE_OFFSET_BITS=64");
+#endif
+
+namespace rb::data
+{
+#if defined(_WIN32)
+	bool mapped_file::open(const std::filesystem::path& path) noexcept
+	{
+		close();
+
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		// Pipes and character devices cannot be mapped and have no meaningful size
+		LARGE_INTEGER size;
+
+		if (GetFileType(file) != FILE_TYPE_DISK || !GetFileSizeEx(file, &size))
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		// Empty files cannot be mapped, but there is nothing to read from them either
+		HANDLE mapping = nullptr;
+
+		if (size.QuadPart > 0)
+		{
+			mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+			if (mapping == nullptr)
+			{
+				CloseHandle(file);
+				return false;
+			}
+		}
+
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+
+		m_file = file;
+		m_mapping = mapping;
+		m_size = static_cast<uint64_t>(size.QuadPart);
+		m_granularity = info.dwAllocationGranularity;
+		m_open = true;
+
+		return true;
+	}
+
+	void mapped_file::close() noexcept
+	{
+		if (m_mapping != nullptr)
+			CloseHandle(m_mapping);
+
+		if (m_file != nullptr)
+			CloseHandle(m_file);
+
+		m_file = nullptr;
+		m_mapping = nullptr;
+		m_size = 0;
+		m_open = false;
+	}
+
+	const uint8_t* mapped_file::map(uint64_t offset, size_t size) const noexcept
+	{
+		void* view = MapViewOfFile(m_mapping, FILE_MAP_READ, static_cast<DWORD>(offset >> 32), static_cast<DWORD>(offset), size);
+		return reinterpret_cast<const uint8_t*>(view);
+	}
+
+	void mapped_file::unmap(const uint8_t* view, size_t) noexcept
+	{
+		UnmapViewOfFile(view);
+	}
+#else
+	bool mapped_file::open(const std::filesystem::path& path) noexcept
+	{
+		close();
+
+		const int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+		if (file == -1)
+			return false;
+
+		struct stat info;
+
+		// Pipes, sockets and devices cannot be mapped and have no meaningful size
+		if (fstat(file, &info) != 0 || !S_ISREG(info.st_mode))
+		{
+			::close(file);
+			return false;
+		}
+
+		// Lets the kernel read ahead aggressively, the views are advised separately
+		posix_fadvise(file, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+		m_file = file;
+		m_size = static_cast<uint64_t>(info.st_size);
+		m_granularity = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+		m_open = true;
+
+		return true;
+	}
+
+	void mapped_file::close() noexcept
+	{
+		if (m_file != -1)
+			::close(m_file);
+
+		m_file = -1;
+		m_size = 0;
+		m_open = false;
+	}
+
+	const uint8_t* mapped_file::map(uint64_t offset, size_t size) const noexcept
+	{
+		void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, m_file, static_cast<off_t>(offset));
+
+		if (view == MAP_FAILED)
+			return nullptr;
+
+		madvise(view, size, MADV_SEQUENTIAL);
+
+		return reinterpret_cast<const uint8_t*>(view);
+	}
+
+	void mapped_file::unmap(const uint8_t* view, size_t size) noexcept
+	{
+		munmap(const_cast<uint8_t*>(view), size);
+	}
+#endif
+}
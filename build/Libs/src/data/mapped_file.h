@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <filesystem>
+
+namespace rb::data
+{
+	// Read-only memory mapping of a file, the contents are mapped one view at a time
+	// so that files larger than the address space can be read as well.
+	// Only regular files can be opened. The file must not be truncated while it is read: touching a page
+	// past the new end raises SIGBUS on POSIX systems and an access violation on Windows.
+	class mapped_file
+	{
+	public:
+		// Largest view that is mapped at once
+		static constexpr size_t VIEW_SIZE = sizeof(void*) >= 8 ? size_t(1) << 30 : size_t(1) << 26;
+
+	public:
+		mapped_file() noexcept = default;
+
+		explicit mapped_file(const std::filesystem::path& path) noexcept
+		{
+			(void)open(path);
+		}
+
+		mapped_file(const mapped_file&) = delete;
+		mapped_file& operator=(const mapped_file&) = delete;
+
+		~mapped_file() noexcept
+		{
+			close();
+		}
+
+		// Opens the file for reading, returns false if it cannot be opened or is not a regular file
+		[[nodiscard]] bool open(const std::filesystem::path& path) noexcept;
+
+		void close() noexcept;
+
+		[[nodiscard]] bool is_open() const noexcept { return m_open; }
+
+		[[nodiscard]] uint64_t size() const noexcept { return m_size; }
+
+		// Calls `f(const uint8_t* data, size_t size)` on consecutive views of the bytes [offset, offset + size),
+		// the views are advised to be read sequentially. Returns false if a view cannot be mapped.
+		// Views are mapped and unmapped independently, so several threads can read the same file.
+		template<class F>
+		[[nodiscard]] bool read(uint64_t offset, uint64_t size, F&& f) const noexcept
+		{
+			if (!m_open || offset > m_size || size > m_size - offset)
+				return false;
+
+			while (size > 0)
+			{
+				// Views have to start at a multiple of the allocation granularity
+				const uint64_t start = offset - offset % m_granularity;
+				const size_t skip = static_cast<size_t>(offset - start);
+				const size_t count = static_cast<size_t>(std::min<uint64_t>(size, VIEW_SIZE - skip));
+
+				const uint8_t* view = map(start, skip + count);
+
+				if (view == nullptr)
+					return false;
+
+				f(view + skip, count);
+
+				unmap(view, skip + count);
+
+				offset += count;
+				size -= count;
+			}
+
+			return true;
+		}
+
+	private:
+		bool m_open = false;
+		uint64_t m_size = 0;
+		uint64_t m_granularity = 1;
+
+#if defined(_WIN32)
+		void* m_file = nullptr;
+		void* m_mapping = nullptr;
+#else
+		int m_file = -1;
+#endif
+
+		const uint8_t* map(uint64_t offset, size_t size) const noexcept;
+		static void unmap(const uint8_t* view, size_t size) noexcept;
+	};
+}
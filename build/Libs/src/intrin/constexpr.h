@@ -0,0 +1,16 @@
+#pragma once
+
+namespace rb::intrin
+{
+	/**
+	 * \brief Returns `true` during constant evaluation, used to fall back from intrinsics to portable code.
+	 */
+	[[nodiscard]] constexpr bool _is_constant_evaluated() noexcept
+	{
+#if defined(__GNUC__) || defined(_MSC_VER)
+		return __builtin_is_constant_evaluated();
+#else
+		return true;
+#endif
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+namespace rb::intrin
+{
+	/**
+	 * \brief Instruction set extensions reported by the processor.
+	 */
+	struct cpu_features
+	{
+		bool sse41 = false;
+		bool avx2 = false;
+		bool bmi2 = false;
+		bool adx = false;
+		bool aes = false;
+		bool pclmulqdq = false;
+		bool sha = false;
+	};
+
+	/**
+	 * \brief Executes the CPUID instruction.
+	 *
+	 * \param leaf Value of EAX.
+	 * \param subleaf Value of ECX.
+	 * \param regs Destination of EAX, EBX, ECX and EDX.
+	 */
+	inline void _cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) noexcept
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+
+		for (size_t i = 0; i < 4; i++)
+			regs[i] = static_cast<uint32_t>(info[i]);
+#else
+		__cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+	}
+
+	/**
+	 * \brief Implementation of the feature detection. Use `cpu()` instead.
+	 */
+	[[nodiscard]] inline cpu_features _detect_cpu_features() noexcept
+	{
+		cpu_features features;
+		uint32_t regs[4]{ 0 };
+
+		_cpuid(0, 0, regs);
+		const uint32_t max_leaf = regs[0];
+
+		if (max_leaf >= 1)
+		{
+			_cpuid(1, 0, regs);
+
+			features.pclmulqdq = (regs[2] >> 1) & 1;
+			features.sse41 = (regs[2] >> 19) & 1;
+			features.aes = (regs[2] >> 25) & 1;
+		}
+
+		if (max_leaf >= 7)
+		{
+			_cpuid(7, 0, regs);
+
+			features.avx2 = (regs[1] >> 5) & 1;
+			features.bmi2 = (regs[1] >> 8) & 1;
+			features.adx = (regs[1] >> 19) & 1;
+			features.sha = (regs[1] >> 29) & 1;
+		}
+
+		return features;
+	}
+
+	/**
+	 * \brief Returns the instruction set extensions of the executing processor.
+	 *
+	 * The CPUID instruction is only executed on the first call, the result is cached afterwards.
+	 */
+	[[nodiscard]] inline const cpu_features& cpu() noexcept
+	{
+		static const cpu_features features = _detect_cpu_features();
+		return features;
+	}
+}
@@ -16,7 +16,7 @@
 #include <functional>
 #include <exception>
 
-#include "bit/endian.h"
+#include "math/limb.h"
 
 namespace rb::math
 {
@@ -26,10 +26,17 @@ namespace rb::math
 	public:
 		static inline constexpr size_t BIT_SIZE = B;
 		static inline constexpr size_t BYTE_SIZE = (B + 7) / 8;
+		static inline constexpr size_t LIMB_SIZE = (BYTE_SIZE + 7) / 8;
 
 	private:
 		using this_type = bigint_impl<BIT_SIZE>;
-		using data_type = std::array<uint8_t, BYTE_SIZE>;
+		using data_type = std::array<uint64_t, LIMB_SIZE>;
+
+		// Bits of the most significant limb which lie within BYTE_SIZE
+		static inline constexpr uint64_t TOP_MASK = BYTE_SIZE % 8 == 0 ? ~uint64_t(0) : (uint64_t(1) << (BYTE_SIZE % 8 * 8)) - 1;
+
+		// Position of the sign bit within the most significant limb
+		static inline constexpr uint32_t SIGN_BIT = (BYTE_SIZE * 8 - 1) % 64;
 
 	public:
 		constexpr bigint_impl() noexcept
@@ -52,20 +59,19 @@ namespace rb::math
 		{
 			for (const char& c : str)
 				if ((c < '0' || c > '9') && (c < 'a' || c > 'f') && (c < 'A' || c > 'F'))
-					throw std::invalid_argument("`" __FUNCSIG__ "`: argument contains non-hexadecimal characters");
+					throw std::invalid_argument("`rb::math::bigint_impl::bigint_impl`: argument contains non-hexadecimal characters");
 
-			for (size_t i = 0; i < (str.size() >> 1); i++)
-				m_data[i] = _hex_char_to_int(str[str.size() - 1 - (i << 1)]) | (_hex_char_to_int(str[str.size() - 2 - (i << 1)]) << 4);
+			for (size_t i = 0; i < std::min(str.size(), LIMB_SIZE * 16); i++)
+				m_data[i / 16] |= static_cast<uint64_t>(_hex_char_to_int(str[str.size() - 1 - i])) << (i % 16 * 4);
 
-			if (str.size() & 1)
-				m_data[str.size() >> 1] = _hex_char_to_int(str[0]);
+			_mask();
 		}
 
 		explicit constexpr bigint_impl(const uint8_t* data, size_t size) noexcept
 			: bigint_impl()
 		{
 			for (size_t i = 0; i < std::min(size, BYTE_SIZE); i++)
-				m_data[i] = data[i];
+				m_data[i / 8] |= static_cast<uint64_t>(data[i]) << (i % 8 * 8);
 		}
 
 		template<typename T, typename std::enable_if_t<std::is_integral_v<T>, int> = 0>
@@ -75,11 +81,21 @@ namespace rb::math
 			using U = std::make_unsigned_t<T>;
 			U u_value = static_cast<U>(value);
 
-			if (value < 0)
-				*this = ~(*this);
+			m_data[0] = static_cast<uint64_t>(u_value);
+
+			// Sign extend negative values
+			if constexpr (std::is_signed_v<T>)
+			{
+				if (value < 0)
+				{
+					m_data[0] = static_cast<uint64_t>(static_cast<int64_t>(value));
 
-			for (size_t i = 0; i < std::min(BYTE_SIZE, sizeof(T)); i++)
-				m_data[i] = static_cast<uint8_t>((u_value >> (i * 8)) & 0xFF);
+					for (size_t i = 1; i < LIMB_SIZE; i++)
+						m_data[i] = ~uint64_t(0);
+				}
+			}
+
+			_mask();
 		}
 
 	private:
@@ -97,46 +113,42 @@ namespace rb::math
 			return -1;
 		}
 
+		constexpr void _mask() noexcept
+		{
+			m_data[LIMB_SIZE - 1] &= TOP_MASK;
+		}
+
+		// Knuth's Algorithm D on the magnitudes, see `_limbs_divmod`
 		[[nodiscard]] constexpr std::pair<this_type, this_type> _division_impl(const this_type& rhs) const
 		{
 			if (rhs.is_zero())
-				throw std::domain_error("`" __FUNCSIG__ "`: cannot divide by 0");
+				throw std::domain_error("`rb::math::bigint_impl::_division_impl`: cannot divide by 0");
 
 			if (is_zero())
 				return { 0, 0 };
 
-			this_type n = *this, d = rhs;
+			const bool n_changed = sign() < 0;
+			const bool d_changed = rhs.sign() < 0;
 
-			bool n_changed = false, d_changed = false;
+			const this_type n = abs(), d = rhs.abs();
 
-			if (n.sign() < 0)
-			{
-				n = -n;
-				n_changed = true;
-			}
-
-			if (d.sign() < 0)
-			{
-				d = -d;
-				d_changed = true;
-			}
+			const size_t nn = _limbs_size(n.m_data.data(), LIMB_SIZE);
+			const size_t dn = _limbs_size(d.m_data.data(), LIMB_SIZE);
 
 			this_type q, r;
 
-			for (int32_t i = n.bits() - 1; i >= 0; i--)
+			if (nn < dn)
+				r = n;
+			else
 			{
-				r <<= 1;
-				r.m_data[0] = (r.m_data[0] & 0xFE) | ((n.m_data[i / 8] >> (i % 8)) & 1);
-
-				if (r >= d)
-				{
-					r -= d;
-					q.m_data[i / 8] |= 1 << (i % 8);
-				}
+				std::array<uint64_t, 2 * LIMB_SIZE + 1> scratch{ 0 };
+				_limbs_divmod(q.m_data.data(), r.m_data.data(), n.m_data.data(), nn, d.m_data.data(), dn, scratch.data());
 			}
 
 			if (n_changed && d_changed)
 				return { q, -r };
+			else if (r.is_zero() && n_changed != d_changed)
+				return { -q, r };
 			else if (n_changed && !d_changed)
 				return { -q, rhs - r };
 			else if (!n_changed && d_changed)
@@ -169,12 +181,12 @@ namespace rb::math
 	public:
 		[[nodiscard]] constexpr int sign() const noexcept
 		{
-			return (m_data[BYTE_SIZE - 1] & 0x80) == 0 ? 1 : -1;
+			return ((m_data[LIMB_SIZE - 1] >> SIGN_BIT) & 1) == 0 ? 1 : -1;
 		}
 
 		[[nodiscard]] constexpr bool is_zero() const noexcept
 		{
-			for (size_t i = 0; i < BYTE_SIZE; i++)
+			for (size_t i = 0; i < LIMB_SIZE; i++)
 				if (m_data[i] != 0)
 					return false;
 
@@ -188,31 +200,13 @@ namespace rb::math
 
 		[[nodiscard]] constexpr size_t bits() const noexcept
 		{
-			data_type::const_reverse_iterator it = m_data.rbegin();
-
-			while (*it == 0 && it != m_data.rend())
-				it++;
-
-			size_t num_bits = (std::distance(it, m_data.rend()) - 1) * 8;
-
-			if (it != m_data.rend())
-			{
-				uint8_t byte = *it;
-
-				while (byte)
-				{
-					byte >>= 1;
-					num_bits++;
-				}
-			}
-
-			return num_bits;
+			return _limbs_bits(m_data.data(), LIMB_SIZE);
 		}
 
 		[[nodiscard]] constexpr this_type sqrt() const
 		{
 			if (sign() < 0)
-				throw std::domain_error("`" __FUNCSIG__ "`: cannot take square root of a negative number");
+				throw std::domain_error("`rb::math::bigint_impl::sqrt`: cannot take square root of a negative number");
 
 			if (*this < 2)
 				return *this;
@@ -229,7 +223,7 @@ namespace rb::math
 		[[nodiscard]] constexpr this_type pow(this_type n) const
 		{
 			if (n < 0)
-				throw std::domain_error("`" __FUNCSIG__ "`: exponent `n` cannot be negative");
+				throw std::domain_error("`rb::math::bigint_impl::pow`: exponent `n` cannot be negative");
 
 			if (n.is_zero())
 				return 1;
@@ -257,10 +251,10 @@ namespace rb::math
 		[[nodiscard]] constexpr this_type log(const this_type& b) const
 		{
 			if (b <= 0)
-				throw std::domain_error("`" __FUNCSIG__ "`: logarithm base `b` must be positive");
+				throw std::domain_error("`rb::math::bigint_impl::log`: logarithm base `b` must be positive");
 
 			if (*this <= 0)
-				throw std::domain_error("`" __FUNCSIG__ "`: cannot take logarithm of non-positive number");
+				throw std::domain_error("`rb::math::bigint_impl::log`: cannot take logarithm of non-positive number");
 
 			this_type result;
 			this_type x = *this;
@@ -277,7 +271,7 @@ namespace rb::math
 		[[nodiscard]] constexpr this_type log2() const
 		{
 			if (*this <= 0)
-				throw std::domain_error("`" __FUNCSIG__ "`: cannot take logarithm of non-positive number");
+				throw std::domain_error("`rb::math::bigint_impl::log2`: cannot take logarithm of non-positive number");
 
 			return bits() - 1;
 		}
@@ -319,17 +313,18 @@ namespace rb::math
 	public:
 		[[nodiscard]] constexpr size_t size() const noexcept
 		{
-			return m_data.size();
+			return BYTE_SIZE;
 		}
 
-		[[nodiscard]] constexpr uint8_t* data() noexcept
+		// Limbs are stored in little-endian order, which matches the byte order of the supported targets
+		[[nodiscard]] uint8_t* data() noexcept
 		{
-			return m_data.data();
+			return reinterpret_cast<uint8_t*>(m_data.data());
 		}
 
-		[[nodiscard]] constexpr const uint8_t* data() const noexcept
+		[[nodiscard]] const uint8_t* data() const noexcept
 		{
-			return m_data.data();
+			return reinterpret_cast<const uint8_t*>(m_data.data());
 		}
 
 	public:
@@ -357,19 +352,20 @@ namespace rb::math
 		{
 			this_type result;
 
-			for (size_t i = 0, carry = 0; i < BYTE_SIZE; i++)
-			{
-				uint32_t temp = carry + m_data[i] + rhs.m_data[i];
-				result.m_data[i] = temp & 0xFF;
-				carry = temp >> 8;
-			}
+			_limbs_add(result.m_data.data(), m_data.data(), LIMB_SIZE, rhs.m_data.data(), LIMB_SIZE);
+			result._mask();
 
 			return result;
 		}
 
 		[[nodiscard]] constexpr this_type operator-(const this_type& rhs) const noexcept
 		{
-			return *this + (-rhs);
+			this_type result;
+
+			_limbs_sub(result.m_data.data(), m_data.data(), LIMB_SIZE, rhs.m_data.data(), LIMB_SIZE);
+			result._mask();
+
+			return result;
 		}
 
 		[[nodiscard]] constexpr this_type operator+() const noexcept
@@ -379,7 +375,7 @@ namespace rb::math
 
 		[[nodiscard]] constexpr this_type operator-() const noexcept
 		{
-			return ~(*this) + 1;
+			return ZERO() - *this;
 		}
 
 		constexpr this_type operator++(int) noexcept
@@ -408,38 +404,35 @@ namespace rb::math
 			return *this;
 		}
 
+		// The lower half of a two's complement product does not depend on the signs of the operands
 		[[nodiscard]] constexpr this_type operator*(const this_type& rhs) const noexcept
 		{
-			if (is_zero() || rhs.is_zero())
-				return 0;
+			this_type result;
 
-			this_type a = *this, b = rhs;
+			// Only the lower half of the product is kept, so Karatsuba pays off at twice the usual size
+			if constexpr (LIMB_SIZE >= 2 * KARATSUBA_THRESHOLD)
+			{
+				const size_t na = _limbs_size(m_data.data(), LIMB_SIZE);
+				const size_t nb = _limbs_size(rhs.m_data.data(), LIMB_SIZE);
 
-			bool change_sign = false;
+				if (std::min(na, nb) >= KARATSUBA_THRESHOLD)
+				{
+					std::array<uint64_t, 2 * LIMB_SIZE> product{ 0 };
+					std::array<uint64_t, _karatsuba_scratch_size(LIMB_SIZE)> scratch{ 0 };
 
-			if (a.sign() * b.sign() < 0)
-				change_sign = true;
+					_limbs_mul_karatsuba(product.data(), m_data.data(), rhs.m_data.data(), std::max(na, nb), scratch.data());
 
-			if (a.sign() < 0)
-				a = -a;
+					for (size_t i = 0; i < LIMB_SIZE; i++)
+						result.m_data[i] = product[i];
 
-			if (b.sign() < 0)
-				b = -b;
+					result._mask();
 
-			this_type result;
-
-			for (size_t i = 0; i < BYTE_SIZE; i++)
-			{
-				for (size_t j = 0, carry = 0; j < BYTE_SIZE - i; j++)
-				{
-					uint32_t temp = carry + a.m_data[i] * b.m_data[j] + result.m_data[i + j];
-					result.m_data[i + j] = temp & 0xFF;
-					carry = temp >> 8;
+					return result;
 				}
 			}
 
-			if (change_sign)
-				return -result;
+			_limbs_mul_low(result.m_data.data(), m_data.data(), rhs.m_data.data(), LIMB_SIZE);
+			result._mask();
 
 			return result;
 		}
@@ -489,7 +482,7 @@ namespace rb::math
 		{
 			this_type result = *this;
 
-			for (size_t i = 0; i < BYTE_SIZE; i++)
+			for (size_t i = 0; i < LIMB_SIZE; i++)
 				result.m_data[i] &= rhs.m_data[i];
 
 			return result;
@@ -499,7 +492,7 @@ namespace rb::math
 		{
 			this_type result = *this;
 
-			for (size_t i = 0; i < BYTE_SIZE; i++)
+			for (size_t i = 0; i < LIMB_SIZE; i++)
 				result.m_data[i] |= rhs.m_data[i];
 
 			return result;
@@ -509,7 +502,7 @@ namespace rb::math
 		{
 			this_type result = *this;
 
-			for (size_t i = 0; i < BYTE_SIZE; i++)
+			for (size_t i = 0; i < LIMB_SIZE; i++)
 				result.m_data[i] ^= rhs.m_data[i];
 
 			return result;
@@ -523,28 +516,20 @@ namespace rb::math
 			if (rhs >= BIT_SIZE)
 				return 0;
 
-			const uint32_t byte_pos = rhs / 8;
-			const uint32_t bit_offs = rhs % 8;
-
 			this_type result;
 
-			for (size_t i = byte_pos; i < BYTE_SIZE; i++)
-				result.m_data[i] |= (m_data[i - byte_pos] << bit_offs) | (i - byte_pos > 0 ? (m_data[i - byte_pos - 1] >> (8 - bit_offs)) : 0);
+			_limbs_shl(result.m_data.data(), m_data.data(), LIMB_SIZE, rhs);
+			result._mask();
 
 			return result;
 		}
 
 		[[nodiscard]] constexpr this_type operator<<(const this_type& rhs) const noexcept
 		{
-			if (rhs.is_zero())
-				return *this;
-
-			if (rhs.m_data[0] >= BIT_SIZE)
+			if (_limbs_size(rhs.m_data.data(), LIMB_SIZE) > 1 || rhs.m_data[0] >= BIT_SIZE)
 				return 0;
 
-			uint32_t shift = rb::bit::read_le<uint32_t>(rhs.m_data.data());
-
-			return *this << shift;
+			return *this << static_cast<uint32_t>(rhs.m_data[0]);
 		}
 
 		[[nodiscard]] constexpr this_type operator>>(uint32_t rhs) const noexcept
@@ -555,37 +540,30 @@ namespace rb::math
 			if (rhs >= BIT_SIZE)
 				return 0;
 
-			const uint32_t byte_pos = rhs >> 3;
-			const uint32_t bit_offs = rhs & 0b111;
-
 			this_type result;
 
-			for (size_t i = 0; i < BYTE_SIZE - byte_pos; i++)
-				result.m_data[i] |= (m_data[i + byte_pos] >> bit_offs) | (byte_pos + i + 1 < BYTE_SIZE ? (m_data[byte_pos + i + 1] << (8 - bit_offs)) : 0);
+			_limbs_shr(result.m_data.data(), m_data.data(), LIMB_SIZE, rhs);
 
 			return result;
 		}
 
 		[[nodiscard]] constexpr this_type operator>>(const this_type& rhs) const noexcept
 		{
-			if (rhs.is_zero())
-				return *this;
-
-			if (rhs.m_data[0] >= BIT_SIZE)
+			if (_limbs_size(rhs.m_data.data(), LIMB_SIZE) > 1 || rhs.m_data[0] >= BIT_SIZE)
 				return 0;
 
-			uint32_t shift = rb::bit::read_le<uint32_t>(rhs.m_data.data());
-
-			return *this >> shift;
+			return *this >> static_cast<uint32_t>(rhs.m_data[0]);
 		}
 
 		[[nodiscard]] constexpr this_type operator~() const noexcept
 		{
 			this_type result;
 
-			for (size_t i = 0; i < BYTE_SIZE; i++)
+			for (size_t i = 0; i < LIMB_SIZE; i++)
 				result.m_data[i] = ~m_data[i];
 
+			result._mask();
+
 			return result;
 		}
 
@@ -634,20 +612,11 @@ namespace rb::math
 	public:
 		[[nodiscard]] constexpr bool operator<(const this_type& rhs) const noexcept
 		{
-			if (sign() < rhs.sign())
-				return true;
-
-			if (sign() > rhs.sign())
-				return false;
-
-			if (sign() < 0 && rhs.sign() < 0)
-				return -rhs < -(*this);
-
-			for (int32_t i = BYTE_SIZE - 1; i >= 0; i--)
-				if (m_data[i] != rhs.m_data[i])
-					return m_data[i] < rhs.m_data[i];
+			if (sign() != rhs.sign())
+				return sign() < rhs.sign();
 
-			return false;
+			// Two's complement representations of equally signed numbers order like unsigned ones
+			return _limbs_cmp(m_data.data(), rhs.m_data.data(), LIMB_SIZE) < 0;
 		}
 
 		[[nodiscard]] constexpr bool operator<=(const this_type& rhs) const noexcept
@@ -667,11 +636,7 @@ namespace rb::math
 
 		[[nodiscard]] constexpr bool operator==(const this_type& rhs) const noexcept
 		{
-			for (size_t i = 0; i < BYTE_SIZE; i++)
-				if (m_data[i] != rhs.m_data[i])
-					return false;
-
-			return true;
+			return _limbs_cmp(m_data.data(), rhs.m_data.data(), LIMB_SIZE) == 0;
 		}
 
 		[[nodiscard]] constexpr bool operator!=(const this_type& rhs) const noexcept
@@ -688,20 +653,15 @@ namespace rb::math
 				v = -v;
 			}
 
-			data_type::const_reverse_iterator it = v.m_data.rbegin();
+			size_t i = _limbs_size(v.m_data.data(), LIMB_SIZE);
 
-			while (it != v.m_data.rend() && *it == 0)
-				it++;
-
-			if (it == v.m_data.rend())
+			if (i == 0)
 				os << "0";
 			else
-			{
-				os << std::hex << static_cast<uint32_t>(*(it++));
+				os << std::hex << v.m_data[--i];
 
-				while (it != v.m_data.rend())
-					os << std::setw(2) << std::setfill('0') << std::hex << static_cast<uint32_t>(*(it++));
-			}
+			while (i > 0)
+				os << std::setw(16) << std::setfill('0') << std::hex << v.m_data[--i];
 
 			return os;
 		}
@@ -744,7 +704,7 @@ namespace rb::math
 	{
 	private:
 		using this_type = bigint_impl<0>;
-		using data_type = std::vector<uint8_t>;
+		using data_type = std::vector<uint64_t>;
 
 	public:
 		bigint_impl() noexcept
@@ -767,15 +727,12 @@ namespace rb::math
 		{
 			for (const char& c : str)
 				if ((c < '0' || c > '9') && (c < 'a' || c > 'f') && (c < 'A' || c > 'F'))
-					throw std::invalid_argument("`" __FUNCSIG__ "`: argument contains non-hexadecimal characters");
-
-			m_data.resize((str.size() + 1) >> 1);
+					throw std::invalid_argument("`rb::math::bigint_impl::bigint_impl`: argument contains non-hexadecimal characters");
 
-			for (size_t i = 0; i < (str.size() >> 1); i++)
-				m_data[i] = _hex_char_to_int(str[str.size() - 1 - (i << 1)]) | (_hex_char_to_int(str[str.size() - 2 - (i << 1)]) << 4);
+			resize((str.size() + 15) / 16);
 
-			if (str.size() & 1)
-				m_data[str.size() >> 1] = _hex_char_to_int(str[0]);
+			for (size_t i = 0; i < str.size(); i++)
+				m_data[i / 16] |= static_cast<uint64_t>(_hex_char_to_int(str[str.size() - 1 - i])) << (i % 16 * 4);
 
 			fit();
 		}
@@ -783,10 +740,10 @@ namespace rb::math
 		explicit bigint_impl(const uint8_t* data, size_t size) noexcept
 			: bigint_impl()
 		{
-			m_data.resize(size);
+			resize((size + 7) / 8);
 
 			for (size_t i = 0; i < size; i++)
-				m_data[i] = data[i];
+				m_data[i / 8] |= static_cast<uint64_t>(data[i]) << (i % 8 * 8);
 
 			fit();
 		}
@@ -795,24 +752,19 @@ namespace rb::math
 		bigint_impl(T value) noexcept
 			: bigint_impl()
 		{
+			using U = std::make_unsigned_t<T>;
+			U u_value = static_cast<U>(value);
+
 			if constexpr (std::is_signed_v<T>)
 			{
 				if (value < 0)
 				{
 					m_sign = -1;
-					value = -value;
+					u_value = U(0) - u_value;
 				}
 			}
 
-			using U = std::make_unsigned_t<T>;
-			U u_value = static_cast<U>(value);
-
-			m_data.resize(sizeof(T));
-
-			for (size_t i = 0; i < sizeof(T); i++)
-				m_data[i] = static_cast<uint8_t>((u_value >> (i * 8)) & 0xFF);
-
-			fit();
+			m_data[0] = static_cast<uint64_t>(u_value);
 		}
 
 	private:
@@ -837,62 +789,61 @@ namespace rb::math
 
 		void fit()
 		{
-			size_t n = 0;
-			for (data_type::reverse_iterator it = m_data.rbegin(); it != m_data.rend() && *it == 0; it++)
-				n++;
-			resize(std::max(size() - n, 1U));
+			const size_t n = _limbs_size(m_data.data(), m_data.size());
+
+			resize(std::max<size_t>(n, 1));
+
+			if (n == 0)
+				m_sign = 1;
 		}
 
-		// Binary Long Division
-		// https://en.wikipedia.org/wiki/Division_algorithm#Long_division
+		[[nodiscard]] static int _compare_magnitude(const this_type& lhs, const this_type& rhs) noexcept
+		{
+			const size_t na = _limbs_size(lhs.m_data.data(), lhs.m_data.size());
+			const size_t nb = _limbs_size(rhs.m_data.data(), rhs.m_data.size());
+
+			if (na != nb)
+				return na < nb ? -1 : 1;
+
+			return _limbs_cmp(lhs.m_data.data(), rhs.m_data.data(), na);
+		}
+
+		// Knuth's Algorithm D on the magnitudes, see `_limbs_divmod`
 		[[nodiscard]] std::pair<this_type, this_type> _division_impl(const this_type& rhs) const
 		{
 			if (rhs.is_zero())
-				throw std::domain_error("`" __FUNCSIG__ "`: cannot divide by 0");
+				throw std::domain_error("`rb::math::bigint_impl::_division_impl`: cannot divide by 0");
 
 			if (is_zero())
 				return { 0, 0 };
 
-			this_type n = *this, d = rhs;
+			const bool n_changed = sign() < 0;
+			const bool d_changed = rhs.sign() < 0;
 
-			bool n_changed = false, d_changed = false;
+			const size_t m = _limbs_size(m_data.data(), m_data.size());
+			const size_t n = _limbs_size(rhs.m_data.data(), rhs.m_data.size());
 
-			if (n.sign() < 0)
-			{
-				n = -n;
-				n_changed = true;
-			}
+			this_type q, r;
 
-			if (d.sign() < 0)
+			if (m < n)
+				r = abs();
+			else
 			{
-				d = -d;
-				d_changed = true;
-			}
+				q.resize(m - n + 1);
+				r.resize(n);
 
-			this_type q, r;
-
-			size_t max_size = std::max(n.size(), d.size());
-			n.resize(max_size);
-			d.resize(max_size);
-			q.resize(max_size);
+				data_type scratch(m + n + 1);
 
-			for (int32_t i = n.bits() - 1; i >= 0; i--)
-			{
-				r <<= 1;
-				r.m_data[0] = (r.m_data[0] & 0xFE) | ((n.m_data[i >> 3] >> (i & 0b111)) & 1);
+				_limbs_divmod(q.m_data.data(), r.m_data.data(), m_data.data(), m, rhs.m_data.data(), n, scratch.data());
 
-				if (r >= d)
-				{
-					r -= d;
-					q.m_data[i >> 3] |= 1 << (i % 8);
-				}
+				q.fit();
+				r.fit();
 			}
 
-			q.fit();
-			r.fit();
-
 			if (n_changed && d_changed)
 				return { q, -r };
+			else if (r.is_zero() && n_changed != d_changed)
+				return { -q, r };
 			else if (n_changed && !d_changed)
 				return { -q, rhs - r };
 			else if (!n_changed && d_changed)
@@ -922,7 +873,7 @@ namespace rb::math
 
 		[[nodiscard]] bool is_zero() const noexcept
 		{
-			return size() == 1 && m_data[0] == 0;
+			return _limbs_size(m_data.data(), m_data.size()) == 0;
 		}
 
 		[[nodiscard]] this_type abs() const noexcept
@@ -932,31 +883,13 @@ namespace rb::math
 
 		[[nodiscard]] size_t bits() const noexcept
 		{
-			data_type::const_reverse_iterator it = m_data.rbegin();
-
-			while (*it == 0 && it != m_data.rend())
-				it++;
-
-			size_t num_bits = (std::distance(it, m_data.rend()) - 1) * 8;
-
-			if (it != m_data.rend())
-			{
-				uint8_t byte = *it;
-
-				while (byte)
-				{
-					byte >>= 1;
-					num_bits++;
-				}
-			}
-
-			return num_bits;
+			return _limbs_bits(m_data.data(), m_data.size());
 		}
 
 		[[nodiscard]] this_type sqrt() const
 		{
 			if (sign() < 0)
-				throw std::domain_error("`" __FUNCSIG__ "`: cannot take square root of a negative number");
+				throw std::domain_error("`rb::math::bigint_impl::sqrt`: cannot take square root of a negative number");
 
 			if (*this < 2)
 				return *this;
@@ -973,7 +906,7 @@ namespace rb::math
 		[[nodiscard]] this_type pow(this_type n) const
 		{
 			if (n.sign() < 0)
-				throw std::domain_error("`" __FUNCSIG__ "`: exponent `n` cannot be negative");
+				throw std::domain_error("`rb::math::bigint_impl::pow`: exponent `n` cannot be negative");
 
 			if (n.is_zero())
 				return 1;
@@ -1001,10 +934,10 @@ namespace rb::math
 		[[nodiscard]] this_type log(const this_type& b) const
 		{
 			if (b <= 0)
-				throw std::domain_error("`" __FUNCSIG__ "`: logarithm base `b` must be positive");
+				throw std::domain_error("`rb::math::bigint_impl::log`: logarithm base `b` must be positive");
 
 			if (*this <= 0)
-				throw std::domain_error("`" __FUNCSIG__ "`: cannot take logarithm of non-positive number");
+				throw std::domain_error("`rb::math::bigint_impl::log`: cannot take logarithm of non-positive number");
 
 			this_type result;
 			this_type x = *this;
@@ -1021,7 +954,7 @@ namespace rb::math
 		[[nodiscard]] this_type log2() const
 		{
 			if (*this <= 0)
-				throw std::domain_error("`" __FUNCSIG__ "`: cannot take logarithm of non-positive number");
+				throw std::domain_error("`rb::math::bigint_impl::log2`: cannot take logarithm of non-positive number");
 
 			return bits() - 1;
 		}
@@ -1062,73 +995,62 @@ namespace rb::math
 	public:
 		[[nodiscard]] size_t size() const noexcept
 		{
-			return m_data.size();
+			return m_data.size() * sizeof(uint64_t);
 		}
 
+		// Limbs are stored in little-endian order, which matches the byte order of the supported targets
 		[[nodiscard]] uint8_t* data() noexcept
 		{
-			return m_data.data();
+			return reinterpret_cast<uint8_t*>(m_data.data());
 		}
 
 		[[nodiscard]] const uint8_t* data() const noexcept
 		{
-			return m_data.data();
+			return reinterpret_cast<const uint8_t*>(m_data.data());
 		}
 
-		public:
-			this_type& operator=(const this_type& rhs) noexcept
-			{
-				m_sign = rhs.m_sign;
-				m_data = rhs.m_data;
-				return *this;
-			}
+	public:
+		this_type& operator=(const this_type& rhs) noexcept
+		{
+			m_sign = rhs.m_sign;
+			m_data = rhs.m_data;
+			return *this;
+		}
 
-			this_type& operator=(this_type&& rhs) noexcept
-			{
-				m_sign = std::move(rhs.m_sign);
-				m_data = std::move(rhs.m_data);
-				return *this;
-			}
+		this_type& operator=(this_type&& rhs) noexcept
+		{
+			m_sign = std::move(rhs.m_sign);
+			m_data = std::move(rhs.m_data);
+			return *this;
+		}
 
-			template<typename T, typename std::enable_if_t<std::is_integral_v<T>, int> = 0>
-			this_type& operator=(T rhs) noexcept
-			{
-				*this = this_type(rhs);
-				return *this;
-			}
+		template<typename T, typename std::enable_if_t<std::is_integral_v<T>, int> = 0>
+		this_type& operator=(T rhs) noexcept
+		{
+			*this = this_type(rhs);
+			return *this;
+		}
 
 	public:
 		[[nodiscard]] this_type operator+(const this_type& rhs) const noexcept
 		{
-			if (sign() > 0 && rhs.sign() < 0)
-				return *this - -rhs;
-
-			if (sign() < 0 && rhs.sign() > 0)
-				return -(-(*this) - rhs);
+			if (rhs.is_zero())
+				return *this;
 
-			const this_type& longer = size() >= rhs.size() ? *this : rhs;
-			const this_type& shorter = size() < rhs.size() ? *this : rhs;
+			if (is_zero())
+				return rhs;
 
-			this_type result;
-			result.resize(longer.size() + 1);
+			if (sign() != rhs.sign())
+				return *this - -rhs;
 
-			uint32_t carry = 0;
-			for (size_t i = 0; i < shorter.size(); i++)
-			{
-				uint32_t temp = carry + longer.m_data[i] + shorter.m_data[i];
-				result.m_data[i] = temp & 0xFF;
-				carry = temp >> 8;
-			}
+			const this_type& longer = m_data.size() >= rhs.m_data.size() ? *this : rhs;
+			const this_type& shorter = m_data.size() < rhs.m_data.size() ? *this : rhs;
 
-			for (size_t i = shorter.size(); i < longer.size(); i++)
-			{
-				uint32_t temp = carry + longer.m_data[i];
-				result.m_data[i] = temp & 0xFF;
-				carry = temp >> 8;
-			}
+			this_type result;
+			result.m_sign = m_sign;
+			result.resize(longer.m_data.size() + 1);
 
-			if (carry)
-				result.m_data.back() = carry;
+			result.m_data.back() = _limbs_add(result.m_data.data(), longer.m_data.data(), longer.m_data.size(), shorter.m_data.data(), shorter.m_data.size());
 
 			result.fit();
 
@@ -1137,45 +1059,23 @@ namespace rb::math
 
 		[[nodiscard]] this_type operator-(const this_type& rhs) const noexcept
 		{
-			if (sign() > 0 && rhs.sign() < 0)
+			if (rhs.is_zero())
+				return *this;
+
+			if (sign() != rhs.sign())
 				return *this + -rhs;
 
-			if (sign() < 0 && rhs.sign() > 0)
-				return -(-(*this) + rhs);
+			// Equal signs, subtract the smaller magnitude from the greater one
+			const bool less = _compare_magnitude(*this, rhs) < 0;
 
-			this_type result, greater, lesser;
+			const this_type& greater = less ? rhs : *this;
+			const this_type& lesser = less ? *this : rhs;
 
-			if (*this >= rhs)
-			{
-				greater = *this;
-				lesser = rhs;
-			}
-			else
-			{
-				greater = rhs;
-				lesser = *this;
-				result.m_sign = -1;
-			}
+			this_type result;
+			result.m_sign = less ? -m_sign : m_sign;
+			result.resize(greater.m_data.size());
 
-			lesser.resize(greater.size());
-			result.resize(greater.size() + 1);
-			
-			int32_t borrow = 0;
-			for (size_t i = 0; i < greater.size(); i++)
-			{
-				int32_t temp = borrow + static_cast<int32_t>(greater.m_data[i]) - static_cast<int32_t>(lesser.m_data[i]);
-				
-				if (temp < 0)
-				{
-					result.m_data[i] = (256 + (temp % 256)) & 0xFF;
-					borrow = temp >> 8;
-				}
-				else
-				{
-					result.m_data[i] = temp;
-					borrow = 0;
-				}
-			}
+			_limbs_sub(result.m_data.data(), greater.m_data.data(), greater.m_data.size(), lesser.m_data.data(), _limbs_size(lesser.m_data.data(), lesser.m_data.size()));
 
 			result.fit();
 
@@ -1190,7 +1090,10 @@ namespace rb::math
 		[[nodiscard]] this_type operator-() const noexcept
 		{
 			this_type temp = *this;
-			temp.m_sign = -temp.m_sign;
+
+			if (!temp.is_zero())
+				temp.m_sign = -temp.m_sign;
+
 			return temp;
 		}
 
@@ -1225,40 +1128,18 @@ namespace rb::math
 			if (is_zero() || rhs.is_zero())
 				return 0;
 
-			this_type a = *this, b = rhs;
-
-			bool change_sign = false;
-
-			if (a.sign() * b.sign() < 0)
-				change_sign = true;
-
-			if (a.sign() < 0)
-				a = -a;
+			const size_t na = _limbs_size(m_data.data(), m_data.size());
+			const size_t nb = _limbs_size(rhs.m_data.data(), rhs.m_data.size());
 
-			if (b.sign() < 0)
-				b = -b;
-
-			size_t result_size = a.size() + b.size();
-			
 			this_type result;
-			result.resize(result_size);
-			a.resize(result_size);
-			b.resize(result_size);
+			result.m_sign = m_sign * rhs.m_sign;
+			result.resize(na + nb);
 
-			for (size_t i = 0; i < result_size; i++)
-			{
-				for (size_t j = 0, carry = 0; j < result_size - i; j++)
-				{
-					uint32_t temp = carry + a.m_data[i] * b.m_data[j] + result.m_data[i + j];
-					result.m_data[i + j] = temp & 0xFF;
-					carry = temp >> 8;
-				}
-			}
+			data_type scratch(_limbs_mul_scratch_size(na, nb));
 
-			result.fit();
+			_limbs_mul(result.m_data.data(), m_data.data(), na, rhs.m_data.data(), nb, scratch.data());
 
-			if (change_sign)
-				return -result;
+			result.fit();
 
 			return result;
 		}
@@ -1307,9 +1188,9 @@ namespace rb::math
 		[[nodiscard]] this_type operator&(const this_type& rhs) const noexcept
 		{
 			this_type result = *this;
-			result.resize(rhs.size());
+			result.resize(rhs.m_data.size());
 
-			for (size_t i = 0; i < result.size(); i++)
+			for (size_t i = 0; i < result.m_data.size(); i++)
 				result.m_data[i] &= rhs.m_data[i];
 
 			result.fit();
@@ -1320,11 +1201,11 @@ namespace rb::math
 		[[nodiscard]] this_type operator|(const this_type& rhs) const noexcept
 		{
 			this_type result = *this;
-			
-			if (result.size() < rhs.size())
-				result.resize(rhs.size());
 
-			for (size_t i = 0; i < rhs.size(); i++)
+			if (result.m_data.size() < rhs.m_data.size())
+				result.resize(rhs.m_data.size());
+
+			for (size_t i = 0; i < rhs.m_data.size(); i++)
 				result.m_data[i] |= rhs.m_data[i];
 
 			result.fit();
@@ -1337,12 +1218,12 @@ namespace rb::math
 			this_type result = *this;
 			this_type temp = rhs;
 
-			if (result.size() < temp.size())
-				result.resize(temp.size());
+			if (result.m_data.size() < temp.m_data.size())
+				result.resize(temp.m_data.size());
 			else
-				temp.resize(result.size());
+				temp.resize(result.m_data.size());
 
-			for (size_t i = 0; i < result.size(); i++)
+			for (size_t i = 0; i < result.m_data.size(); i++)
 				result.m_data[i] ^= temp.m_data[i];
 
 			result.fit();
@@ -1358,18 +1239,10 @@ namespace rb::math
 			if (is_zero())
 				return ZERO();
 
-			const uint32_t byte_pos = rhs / 8;
-			const uint32_t bit_offs = rhs % 8;
-
-			this_type result;
-			result.resize(size() + (rhs + 7) / 8);
-
-			result.m_data[byte_pos] = m_data[0] << bit_offs;
-			
-			for (size_t i = byte_pos + 1; i < result.size() - 1; i++)
-				result.m_data[i] |= (m_data[i - byte_pos] << bit_offs) | (m_data[i - byte_pos - 1] >> (8 - bit_offs));
+			this_type result = *this;
+			result.resize(m_data.size() + rhs / 64 + 1);
 
-			result.m_data.back() = m_data.back() >> ((8 - bit_offs) % 8);
+			_limbs_shl(result.m_data.data(), result.m_data.data(), result.m_data.size(), rhs);
 
 			result.fit();
 
@@ -1381,14 +1254,7 @@ namespace rb::math
 			if (rhs.is_zero())
 				return *this;
 
-			this_type temp = rhs;
-			
-			if (rhs.size() < 4)
-				temp.resize(4);
-
-			uint32_t shift = rb::bit::read_le<uint32_t>(temp.m_data.data());
-
-			return *this << shift;
+			return *this << static_cast<uint32_t>(rhs.m_data[0]);
 		}
 
 		[[nodiscard]] this_type operator>>(uint32_t rhs) const noexcept
@@ -1396,17 +1262,12 @@ namespace rb::math
 			if (rhs == 0)
 				return *this;
 
-			if (rhs >= size() * 8)
+			if (rhs >= m_data.size() * 64)
 				return 0;
 
-			const uint32_t byte_pos = rhs / 8;
-			const uint32_t bit_offs = rhs % 8;
-
-			this_type result;
-			result.resize(size() - byte_pos);
+			this_type result = *this;
 
-			for (size_t i = 0; i < result.size(); i++)
-				result.m_data[i] |= (m_data[i + byte_pos] >> bit_offs) | (byte_pos + i + 1 < size() ? (m_data[byte_pos + i + 1] << (8 - bit_offs)) : 0);
+			_limbs_shr(result.m_data.data(), result.m_data.data(), result.m_data.size(), rhs);
 
 			result.fit();
 
@@ -1418,23 +1279,23 @@ namespace rb::math
 			if (rhs.is_zero())
 				return *this;
 
-			this_type temp = rhs;
-
-			if (rhs.size() < 4)
-				temp.resize(4);
-
-			uint32_t shift = rb::bit::read_le<uint32_t>(temp.m_data.data());
-
-			return *this >> shift;
+			return *this >> static_cast<uint32_t>(rhs.m_data[0]);
 		}
 
+		// Complements the bytes up to the most significant non-zero one
 		[[nodiscard]] this_type operator~() const noexcept
 		{
+			const size_t byte_size = std::max<size_t>((bits() + 7) / 8, 1);
+
 			this_type result = *this;
+			result.fit();
 
-			for (size_t i = 0; i < result.size(); i++)
+			for (size_t i = 0; i < result.m_data.size(); i++)
 				result.m_data[i] = ~result.m_data[i];
 
+			if (byte_size % 8 != 0)
+				result.m_data.back() &= (uint64_t(1) << (byte_size % 8 * 8)) - 1;
+
 			result.fit();
 
 			return result;
@@ -1442,10 +1303,10 @@ namespace rb::math
 
 		this_type& operator&=(const this_type& rhs) noexcept
 		{
-			if (size() > rhs.size())
-				resize(rhs.size());
+			if (m_data.size() > rhs.m_data.size())
+				resize(rhs.m_data.size());
 
-			for (size_t i = 0; i < size(); i++)
+			for (size_t i = 0; i < m_data.size(); i++)
 				m_data[i] &= rhs.m_data[i];
 
 			fit();
@@ -1455,10 +1316,10 @@ namespace rb::math
 
 		this_type& operator|=(const this_type& rhs) noexcept
 		{
-			if (size() < rhs.size())
-				resize(rhs.size());
+			if (m_data.size() < rhs.m_data.size())
+				resize(rhs.m_data.size());
 
-			for (size_t i = 0; i < rhs.size(); i++)
+			for (size_t i = 0; i < rhs.m_data.size(); i++)
 				m_data[i] |= rhs.m_data[i];
 
 			fit();
@@ -1470,12 +1331,12 @@ namespace rb::math
 		{
 			this_type temp = rhs;
 
-			if (size() < temp.size())
-				resize(temp.size());
+			if (m_data.size() < temp.m_data.size())
+				resize(temp.m_data.size());
 			else
-				temp.resize(size());
+				temp.resize(m_data.size());
 
-			for (size_t i = 0; i < size(); i++)
+			for (size_t i = 0; i < m_data.size(); i++)
 				m_data[i] ^= temp.m_data[i];
 
 			fit();
@@ -1510,30 +1371,13 @@ namespace rb::math
 	public:
 		[[nodiscard]] bool operator<(const this_type& rhs) const noexcept
 		{
-			if (sign() < rhs.sign())
-				return true;
-
-			if (sign() > rhs.sign())
-				return false;
+			if (sign() != rhs.sign())
+				return sign() < rhs.sign();
 
 			if (sign() < 0)
-				return -(*this) > -rhs;
-
-			if (size() > rhs.size())
-				for (int32_t i = static_cast<int32_t>(size()) - 1; i >= static_cast<int32_t>(rhs.size()); i--)
-					if (m_data[i])
-						return false;
-
-			if (size() < rhs.size())
-				for (int32_t i = static_cast<int32_t>(rhs.size()) - 1; i >= static_cast<int32_t>(size()); i--)
-					if (rhs.m_data[i])
-						return true;
+				return _compare_magnitude(*this, rhs) > 0;
 
-			for (int32_t i = static_cast<int32_t>(std::min(size(), rhs.size())) - 1; i >= 0; i--)
-				if (m_data[i] != rhs.m_data[i])
-					return m_data[i] < rhs.m_data[i];
-
-			return false;
+			return _compare_magnitude(*this, rhs) < 0;
 		}
 
 		[[nodiscard]] bool operator<=(const this_type& rhs) const noexcept
@@ -1553,17 +1397,7 @@ namespace rb::math
 
 		[[nodiscard]] bool operator==(const this_type& rhs) const noexcept
 		{
-			if (sign() != rhs.sign())
-				return false;
-
-			if (size() != rhs.size())
-				return false;
-
-			for (size_t i = 0; i < size(); i++)
-				if (m_data[i] != rhs.m_data[i])
-					return false;
-
-			return true;
+			return sign() == rhs.sign() && _compare_magnitude(*this, rhs) == 0;
 		}
 
 		[[nodiscard]] bool operator!=(const this_type& rhs) const noexcept
@@ -1577,17 +1411,15 @@ namespace rb::math
 			if (v.sign() < 0)
 				os << "-";
 
-			data_type::const_reverse_iterator it = v.m_data.rbegin();
+			size_t i = _limbs_size(v.m_data.data(), v.m_data.size());
 
-			if (it == v.m_data.rend())
+			if (i == 0)
 				os << "0";
 			else
-			{
-				os << std::hex << static_cast<uint32_t>(*(it++));
+				os << std::hex << v.m_data[--i];
 
-				while (it != v.m_data.rend())
-					os << std::setw(2) << std::setfill('0') << std::hex << static_cast<uint32_t>(*(it++));
-			}
+			while (i > 0)
+				os << std::setw(16) << std::setfill('0') << std::hex << v.m_data[--i];
 
 			return os;
 		}
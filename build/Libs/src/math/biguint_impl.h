@@ -16,7 +16,7 @@
 #include <functional>
 #include <exception>
 
-#include "bit/endian.h"
+#include "math/limb.h"
 
 namespace rb::math
 {
@@ -26,10 +26,14 @@ namespace rb::math
 	public:
 		static inline constexpr size_t BIT_SIZE = B;
 		static inline constexpr size_t BYTE_SIZE = (B + 7) / 8;
+		static inline constexpr size_t LIMB_SIZE = (BYTE_SIZE + 7) / 8;
 
 	private:
 		using this_type = biguint_impl<BIT_SIZE>;
-		using data_type = std::array<uint8_t, BYTE_SIZE>;
+		using data_type = std::array<uint64_t, LIMB_SIZE>;
+
+		// Bits of the most significant limb which lie within BYTE_SIZE
+		static inline constexpr uint64_t TOP_MASK = BYTE_SIZE % 8 == 0 ? ~uint64_t(0) : (uint64_t(1) << (BYTE_SIZE % 8 * 8)) - 1;
 
 	public:
 		constexpr biguint_impl() noexcept
@@ -52,19 +56,19 @@ namespace rb::math
 		{
 			for (const char& c : str)
 				if ((c < '0' || c > '9') && (c < 'a' || c > 'f') && (c < 'A' || c > 'F'))
-					throw std::invalid_argument(__FUNCSIG__ ": argument contains non-hexadecimal characters");
+					throw std::invalid_argument("`rb::math::biguint_impl::biguint_impl`: argument contains non-hexadecimal characters");
 
-			for (size_t i = 0; i < (str.size() >> 1); i++)
-				m_data[i] = _hex_char_to_int(str[str.size() - 1 - (i << 1)]) | (_hex_char_to_int(str[str.size() - 2 - (i << 1)]) << 4);
+			for (size_t i = 0; i < std::min(str.size(), LIMB_SIZE * 16); i++)
+				m_data[i / 16] |= static_cast<uint64_t>(_hex_char_to_int(str[str.size() - 1 - i])) << (i % 16 * 4);
 
-			if (str.size() & 1)
-				m_data[str.size() >> 1] = _hex_char_to_int(str[0]);
+			_mask();
 		}
 
-		explicit biguint_impl(const uint8_t* data, size_t size) noexcept
+		explicit constexpr biguint_impl(const uint8_t* data, size_t size) noexcept
 			: biguint_impl()
 		{
-			std::copy_n(data, std::min(BYTE_SIZE, size), m_data.data());
+			for (size_t i = 0; i < std::min(BYTE_SIZE, size); i++)
+				m_data[i / 8] |= static_cast<uint64_t>(data[i]) << (i % 8 * 8);
 		}
 
 		template<typename T, typename std::enable_if_t<std::is_integral_v<T>, int> = 0>
@@ -74,8 +78,9 @@ namespace rb::math
 			using U = std::make_unsigned_t<T>;
 			U u_value = static_cast<U>(value);
 
-			for (size_t i = 0; i < std::min(BYTE_SIZE, sizeof(T)); i++)
-				m_data[i] = static_cast<uint8_t>((u_value >> (i * 8)) & 0xFF);
+			m_data[0] = static_cast<uint64_t>(u_value);
+
+			_mask();
 		}
 
 	private:
@@ -93,27 +98,27 @@ namespace rb::math
 			return -1;
 		}
 
+		constexpr void _mask() noexcept
+		{
+			m_data[LIMB_SIZE - 1] &= TOP_MASK;
+		}
+
+		// Knuth's Algorithm D, see `_limbs_divmod`
 		[[nodiscard]] constexpr std::pair<this_type, this_type> _division_impl(const this_type& rhs) const
 		{
 			if (rhs.is_zero())
-				throw std::domain_error("`" __FUNCSIG__ "`: cannot divide by 0");
+				throw std::domain_error("`rb::math::biguint_impl::_division_impl`: cannot divide by 0");
 
-			if (is_zero())
-				return { 0, 0 };
+			const size_t m = _limbs_size(m_data.data(), LIMB_SIZE);
+			const size_t n = _limbs_size(rhs.m_data.data(), LIMB_SIZE);
 
-			this_type q, r;
+			if (m < n)
+				return { 0, *this };
 
-			for (int32_t i = bits() - 1; i >= 0; i--)
-			{
-				r <<= 1;
-				r.m_data[0] = (r.m_data[0] & 0xFE) | ((m_data[i / 8] & (1 << (i % 8))) >> (i % 8));
+			this_type q, r;
+			std::array<uint64_t, 2 * LIMB_SIZE + 1> scratch{ 0 };
 
-				if (r >= rhs)
-				{
-					r -= rhs;
-					q.m_data[i / 8] |= 1 << (i % 8);
-				}
-			}
+			_limbs_divmod(q.m_data.data(), r.m_data.data(), m_data.data(), m, rhs.m_data.data(), n, scratch.data());
 
 			return { q, r };
 		}
@@ -142,7 +147,7 @@ namespace rb::math
 	public:
 		[[nodiscard]] constexpr bool is_zero() const noexcept
 		{
-			for (size_t i = 0; i < BYTE_SIZE; i++)
+			for (size_t i = 0; i < LIMB_SIZE; i++)
 				if (m_data[i] != 0)
 					return false;
 
@@ -151,25 +156,7 @@ namespace rb::math
 
 		[[nodiscard]] constexpr size_t bits() const noexcept
 		{
-			data_type::const_reverse_iterator it = m_data.rbegin();
-
-			while (*it == 0 && it != m_data.rend())
-				it++;
-
-			size_t num_bits = (std::distance(it, m_data.rend()) - 1) * 8;
-
-			if (it != m_data.rend())
-			{
-				uint8_t byte = *it;
-
-				while (byte != 0)
-				{
-					byte >>= 1;
-					num_bits++;
-				}
-			}
-
-			return num_bits;
+			return _limbs_bits(m_data.data(), LIMB_SIZE);
 		}
 
 		[[nodiscard]] constexpr this_type sqrt() const noexcept
@@ -189,7 +176,7 @@ namespace rb::math
 		[[nodiscard]] constexpr this_type pow(this_type n) const
 		{
 			if (is_zero() && n.is_zero())
-				throw std::domain_error("`" __FUNCSIG__ "`: 0 to the 0 is undefined");
+				throw std::domain_error("`rb::math::biguint_impl::pow`: 0 to the 0 is undefined");
 
 			if (is_zero())
 				return *this;
@@ -220,10 +207,10 @@ namespace rb::math
 		[[nodiscard]] constexpr this_type log(const this_type& b) const
 		{
 			if (b == 0)
-				throw std::domain_error("`" __FUNCSIG__ "`: logarithm base `b` must be positive");
+				throw std::domain_error("`rb::math::biguint_impl::log`: logarithm base `b` must be positive");
 
 			if (*this == 0)
-				throw std::domain_error("`" __FUNCSIG__ "`: cannot take logarithm of non-positive number");
+				throw std::domain_error("`rb::math::biguint_impl::log`: cannot take logarithm of non-positive number");
 
 			this_type result;
 			this_type x = *this;
@@ -240,7 +227,7 @@ namespace rb::math
 		[[nodiscard]] constexpr this_type log2() const
 		{
 			if (*this == 0)
-				throw std::domain_error("`" __FUNCSIG__ "`: cannot take logarithm of non-positive number");
+				throw std::domain_error("`rb::math::biguint_impl::log2`: cannot take logarithm of non-positive number");
 
 			return bits() - 1;
 		}
@@ -279,14 +266,15 @@ namespace rb::math
 		}
 
 	public:
-		[[nodiscard]] constexpr uint8_t* data() noexcept
+		// Limbs are stored in little-endian order, which matches the byte order of the supported targets
+		[[nodiscard]] uint8_t* data() noexcept
 		{
-			return m_data.data();
+			return reinterpret_cast<uint8_t*>(m_data.data());
 		}
 
-		[[nodiscard]] constexpr const uint8_t* data() const noexcept
+		[[nodiscard]] const uint8_t* data() const noexcept
 		{
-			return m_data.data();
+			return reinterpret_cast<const uint8_t*>(m_data.data());
 		}
 
 	public:
@@ -314,19 +302,20 @@ namespace rb::math
 		{
 			this_type result;
 
-			for (size_t i = 0, carry = 0; i < BYTE_SIZE; i++)
-			{
-				uint32_t temp = carry + m_data[i] + rhs.m_data[i];
-				result.m_data[i] = temp % 256;
-				carry = temp / 256;
-			}
+			_limbs_add(result.m_data.data(), m_data.data(), LIMB_SIZE, rhs.m_data.data(), LIMB_SIZE);
+			result._mask();
 
 			return result;
 		}
 
 		[[nodiscard]] constexpr this_type operator-(const this_type& rhs) const noexcept
 		{
-			return *this + (-rhs);
+			this_type result;
+
+			_limbs_sub(result.m_data.data(), m_data.data(), LIMB_SIZE, rhs.m_data.data(), LIMB_SIZE);
+			result._mask();
+
+			return result;
 		}
 
 		[[nodiscard]] constexpr this_type operator+() const noexcept
@@ -336,7 +325,7 @@ namespace rb::math
 
 		[[nodiscard]] constexpr this_type operator-() const noexcept
 		{
-			return ~(*this) + 1;
+			return ZERO() - *this;
 		}
 
 		constexpr this_type operator++(int) noexcept
@@ -367,21 +356,33 @@ namespace rb::math
 
 		[[nodiscard]] constexpr this_type operator*(const this_type& rhs) const noexcept
 		{
-			if (is_zero() || rhs.is_zero())
-				return 0;
-
 			this_type result;
 
-			for (size_t i = 0; i < BYTE_SIZE; i++)
+			// Only the lower half of the product is kept, so Karatsuba pays off at twice the usual size
+			if constexpr (LIMB_SIZE >= 2 * KARATSUBA_THRESHOLD)
 			{
-				for (size_t j = 0, carry = 0; j < BYTE_SIZE - i; j++)
+				const size_t na = _limbs_size(m_data.data(), LIMB_SIZE);
+				const size_t nb = _limbs_size(rhs.m_data.data(), LIMB_SIZE);
+
+				if (std::min(na, nb) >= KARATSUBA_THRESHOLD)
 				{
-					uint32_t temp = carry + m_data[i] * rhs.m_data[j] + result.m_data[i + j];
-					result.m_data[i + j] = temp % 256;
-					carry = temp / 256;
+					std::array<uint64_t, 2 * LIMB_SIZE> product{ 0 };
+					std::array<uint64_t, _karatsuba_scratch_size(LIMB_SIZE)> scratch{ 0 };
+
+					_limbs_mul_karatsuba(product.data(), m_data.data(), rhs.m_data.data(), std::max(na, nb), scratch.data());
+
+					for (size_t i = 0; i < LIMB_SIZE; i++)
+						result.m_data[i] = product[i];
+
+					result._mask();
+
+					return result;
 				}
 			}
 
+			_limbs_mul_low(result.m_data.data(), m_data.data(), rhs.m_data.data(), LIMB_SIZE);
+			result._mask();
+
 			return result;
 		}
 
@@ -429,8 +430,8 @@ namespace rb::math
 		[[nodiscard]] constexpr this_type operator&(const this_type& rhs) const noexcept
 		{
 			this_type result = *this;
-			
-			for (size_t i = 0; i < BYTE_SIZE; i++)
+
+			for (size_t i = 0; i < LIMB_SIZE; i++)
 				result.m_data[i] &= rhs.m_data[i];
 
 			return result;
@@ -439,8 +440,8 @@ namespace rb::math
 		[[nodiscard]] constexpr this_type operator|(const this_type& rhs) const noexcept
 		{
 			this_type result = *this;
-			
-			for (size_t i = 0; i < BYTE_SIZE; i++)
+
+			for (size_t i = 0; i < LIMB_SIZE; i++)
 				result.m_data[i] |= rhs.m_data[i];
 
 			return result;
@@ -449,8 +450,8 @@ namespace rb::math
 		[[nodiscard]] constexpr this_type operator^(const this_type& rhs) const noexcept
 		{
 			this_type result = *this;
-			
-			for (size_t i = 0; i < BYTE_SIZE; i++)
+
+			for (size_t i = 0; i < LIMB_SIZE; i++)
 				result.m_data[i] ^= rhs.m_data[i];
 
 			return result;
@@ -464,28 +465,20 @@ namespace rb::math
 			if (rhs >= BIT_SIZE)
 				return 0;
 
-			const uint32_t byte_pos = rhs / 8;
-			const uint32_t bit_offs = rhs % 8;
-
 			this_type result;
 
-			for (size_t i = byte_pos; i < BYTE_SIZE; i++)
-				result.m_data[i] |= (m_data[i - byte_pos] << bit_offs) | (i - byte_pos > 0 ? (m_data[i - byte_pos - 1] >> (8 - bit_offs)) : 0);
+			_limbs_shl(result.m_data.data(), m_data.data(), LIMB_SIZE, rhs);
+			result._mask();
 
 			return result;
 		}
 
 		[[nodiscard]] constexpr this_type operator<<(const this_type& rhs) const noexcept
 		{
-			if (rhs.is_zero())
-				return *this;
-
-			if (rhs.m_data[0] >= BIT_SIZE)
+			if (_limbs_size(rhs.m_data.data(), LIMB_SIZE) > 1 || rhs.m_data[0] >= BIT_SIZE)
 				return 0;
 
-			uint32_t shift = rb::bit::read_le<uint32_t>(rhs.m_data.data());
-
-			return *this << shift;
+			return *this << static_cast<uint32_t>(rhs.m_data[0]);
 		}
 
 		[[nodiscard]] constexpr this_type operator>>(uint32_t rhs) const noexcept
@@ -496,43 +489,36 @@ namespace rb::math
 			if (rhs >= BIT_SIZE)
 				return 0;
 
-			const uint32_t byte_pos = rhs / 8;
-			const uint32_t bit_offs = rhs % 8;
-
 			this_type result;
 
-			for (size_t i = 0; i < BYTE_SIZE - byte_pos; i++)
-				result.m_data[i] |= (m_data[i + byte_pos] >> bit_offs) | (byte_pos + i + 1 < BYTE_SIZE ? (m_data[byte_pos + i + 1] << (8 - bit_offs)) : 0);
+			_limbs_shr(result.m_data.data(), m_data.data(), LIMB_SIZE, rhs);
 
 			return result;
 		}
 
 		[[nodiscard]] constexpr this_type operator>>(const this_type& rhs) const noexcept
 		{
-			if (rhs.is_zero())
-				return *this;
-
-			if (rhs.m_data[0] >= BIT_SIZE)
+			if (_limbs_size(rhs.m_data.data(), LIMB_SIZE) > 1 || rhs.m_data[0] >= BIT_SIZE)
 				return 0;
 
-			uint32_t shift = rb::bit::read_le<uint32_t>(rhs.m_data.data());
-
-			return *this >> shift;
+			return *this >> static_cast<uint32_t>(rhs.m_data[0]);
 		}
 
 		[[nodiscard]] constexpr this_type operator~() const noexcept
 		{
 			this_type result;
-			
-			for (size_t i = 0; i < BYTE_SIZE; i++)
+
+			for (size_t i = 0; i < LIMB_SIZE; i++)
 				result.m_data[i] = ~m_data[i];
 
+			result._mask();
+
 			return result;
 		}
 
 		constexpr this_type& operator&=(const this_type& rhs) noexcept
 		{
-			for (size_t i = 0; i < BYTE_SIZE; i++)
+			for (size_t i = 0; i < LIMB_SIZE; i++)
 				m_data[i] &= rhs.m_data[i];
 
 			return *this;
@@ -540,7 +526,7 @@ namespace rb::math
 
 		constexpr this_type& operator|=(const this_type& rhs) noexcept
 		{
-			for (size_t i = 0; i < BYTE_SIZE; i++)
+			for (size_t i = 0; i < LIMB_SIZE; i++)
 				m_data[i] |= rhs.m_data[i];
 
 			return *this;
@@ -548,7 +534,7 @@ namespace rb::math
 
 		constexpr this_type& operator^=(const this_type& rhs) noexcept
 		{
-			for (size_t i = 0; i < BYTE_SIZE; i++)
+			for (size_t i = 0; i < LIMB_SIZE; i++)
 				m_data[i] ^= rhs.m_data[i];
 
 			return *this;
@@ -581,11 +567,7 @@ namespace rb::math
 	public:
 		[[nodiscard]] constexpr bool operator<(const this_type& rhs) const noexcept
 		{
-			for (int32_t i = BYTE_SIZE - 1; i >= 0; i--)
-				if (m_data[i] != rhs.m_data[i])
-					return m_data[i] < rhs.m_data[i];
-
-			return false;
+			return _limbs_cmp(m_data.data(), rhs.m_data.data(), LIMB_SIZE) < 0;
 		}
 
 		[[nodiscard]] constexpr bool operator<=(const this_type& rhs) const noexcept
@@ -605,11 +587,7 @@ namespace rb::math
 
 		[[nodiscard]] constexpr bool operator==(const this_type& rhs) const noexcept
 		{
-			for (size_t i = 0; i < BYTE_SIZE; i++)
-				if (m_data[i] != rhs.m_data[i])
-					return false;
-
-			return true;
+			return _limbs_cmp(m_data.data(), rhs.m_data.data(), LIMB_SIZE) == 0;
 		}
 
 		[[nodiscard]] constexpr bool operator!=(const this_type& rhs) const noexcept
@@ -620,18 +598,15 @@ namespace rb::math
 	public:
 		friend std::ostream& operator<<(std::ostream& os, const this_type& v)
 		{
-			data_type::const_reverse_iterator it = v.m_data.rbegin();
-
-			while (it != v.m_data.rend() && *it == 0)
-				it++;
+			size_t i = _limbs_size(v.m_data.data(), LIMB_SIZE);
 
-			if (it == v.m_data.rend())
+			if (i == 0)
 				os << "0";
 			else
-				os << std::hex << static_cast<uint32_t>(*(it++));
+				os << std::hex << v.m_data[--i];
 
-			while (it != v.m_data.rend())
-				os << std::setw(2) << std::setfill('0') << std::hex << static_cast<uint32_t>(*(it++));
+			while (i > 0)
+				os << std::setw(16) << std::setfill('0') << std::hex << v.m_data[--i];
 
 			return os;
 		}
@@ -674,7 +649,7 @@ namespace rb::math
 	{
 	private:
 		using this_type = biguint_impl<0>;
-		using data_type = std::vector<uint8_t>;
+		using data_type = std::vector<uint64_t>;
 
 	public:
 		biguint_impl() noexcept
@@ -697,15 +672,12 @@ namespace rb::math
 		{
 			for (const char& c : str)
 				if ((c < '0' || c > '9') && (c < 'a' || c > 'f') && (c < 'A' || c > 'F'))
-					throw std::invalid_argument("`" __FUNCSIG__ "`: argument contains non-hexadecimal characters");
+					throw std::invalid_argument("`rb::math::biguint_impl::biguint_impl`: argument contains non-hexadecimal characters");
 
-			m_data.resize((str.size() + 1) >> 1);
+			resize((str.size() + 15) / 16);
 
-			for (size_t i = 0; i < (str.size() >> 1); i++)
-				m_data[i] = _hex_char_to_int(str[str.size() - 1 - (i << 1)]) | (_hex_char_to_int(str[str.size() - 2 - (i << 1)]) << 4);
-
-			if (str.size() & 1)
-				m_data[str.size() >> 1] = _hex_char_to_int(str[0]);
+			for (size_t i = 0; i < str.size(); i++)
+				m_data[i / 16] |= static_cast<uint64_t>(_hex_char_to_int(str[str.size() - 1 - i])) << (i % 16 * 4);
 
 			fit();
 		}
@@ -713,10 +685,10 @@ namespace rb::math
 		explicit biguint_impl(const uint8_t* data, size_t size) noexcept
 			: biguint_impl()
 		{
-			m_data.resize(size);
+			resize((size + 7) / 8);
 
 			for (size_t i = 0; i < size; i++)
-				m_data[i] = data[i];
+				m_data[i / 8] |= static_cast<uint64_t>(data[i]) << (i % 8 * 8);
 
 			fit();
 		}
@@ -728,12 +700,7 @@ namespace rb::math
 			using U = std::make_unsigned_t<T>;
 			U u_value = static_cast<U>(value);
 
-			m_data.resize(sizeof(T));
-
-			for (size_t i = 0; i < sizeof(T); i++)
-				m_data[i] = static_cast<uint8_t>((u_value >> (i * 8)) & 0xFF);
-
-			fit();
+			m_data[0] = static_cast<uint64_t>(u_value);
 		}
 
 	private:
@@ -758,41 +725,28 @@ namespace rb::math
 
 		void fit()
 		{
-			size_t n = 0;
-			for (data_type::reverse_iterator it = m_data.rbegin(); it != m_data.rend() && *it == 0; it++)
-				n++;
-			resize(std::max(size() - n, 1U));
+			resize(std::max<size_t>(_limbs_size(m_data.data(), m_data.size()), 1));
 		}
 
-		// Binary Long Division
-		// https://en.wikipedia.org/wiki/Division_algorithm#Long_division
+		// Knuth's Algorithm D, see `_limbs_divmod`
 		[[nodiscard]] std::pair<this_type, this_type> _division_impl(const this_type& rhs) const
 		{
 			if (rhs.is_zero())
-				throw std::domain_error("`" __FUNCSIG__ "`: cannot divide by 0");
+				throw std::domain_error("`rb::math::biguint_impl::_division_impl`: cannot divide by 0");
 
-			if (is_zero())
-				return { 0, 0 };
+			const size_t m = _limbs_size(m_data.data(), m_data.size());
+			const size_t n = _limbs_size(rhs.m_data.data(), rhs.m_data.size());
+
+			if (m < n)
+				return { ZERO(), *this };
 
-			this_type n = *this, d = rhs;
 			this_type q, r;
+			q.resize(m - n + 1);
+			r.resize(n);
 
-			size_t max_size = std::max(n.size(), d.size());
-			n.resize(max_size);
-			d.resize(max_size);
-			q.resize(max_size);
+			data_type scratch(m + n + 1);
 
-			for (int32_t i = n.bits() - 1; i >= 0; i--)
-			{
-				r <<= 1;
-				r.m_data[0] = (r.m_data[0] & 0xFE) | ((n.m_data[i >> 3] >> (i & 0b111)) & 1);
-
-				if (r >= d)
-				{
-					r -= d;
-					q.m_data[i >> 3] |= 1 << (i % 8);
-				}
-			}
+			_limbs_divmod(q.m_data.data(), r.m_data.data(), m_data.data(), m, rhs.m_data.data(), n, scratch.data());
 
 			q.fit();
 			r.fit();
@@ -816,30 +770,12 @@ namespace rb::math
 	public:
 		[[nodiscard]] bool is_zero() const noexcept
 		{
-			return size() == 1 && m_data[0] == 0;
+			return _limbs_size(m_data.data(), m_data.size()) == 0;
 		}
 
 		[[nodiscard]] size_t bits() const noexcept
 		{
-			data_type::const_reverse_iterator it = m_data.rbegin();
-
-			while (*it == 0 && it != m_data.rend())
-				it++;
-
-			size_t num_bits = (std::distance(it, m_data.rend()) - 1) * 8;
-
-			if (it != m_data.rend())
-			{
-				uint8_t byte = *it;
-
-				while (byte)
-				{
-					byte >>= 1;
-					num_bits++;
-				}
-			}
-
-			return num_bits;
+			return _limbs_bits(m_data.data(), m_data.size());
 		}
 
 		[[nodiscard]] this_type sqrt() const
@@ -884,10 +820,10 @@ namespace rb::math
 		[[nodiscard]] this_type log(const this_type& b) const
 		{
 			if (b <= 0)
-				throw std::domain_error("`" __FUNCSIG__ "`: logarithm base `b` must be positive");
+				throw std::domain_error("`rb::math::biguint_impl::log`: logarithm base `b` must be positive");
 
 			if (*this <= 0)
-				throw std::domain_error("`" __FUNCSIG__ "`: cannot take logarithm of non-positive number");
+				throw std::domain_error("`rb::math::biguint_impl::log`: cannot take logarithm of non-positive number");
 
 			this_type result;
 			this_type x = *this;
@@ -904,7 +840,7 @@ namespace rb::math
 		[[nodiscard]] this_type log2() const
 		{
 			if (*this <= 0)
-				throw std::domain_error("`" __FUNCSIG__ "`: cannot take logarithm of non-positive number");
+				throw std::domain_error("`rb::math::biguint_impl::log2`: cannot take logarithm of non-positive number");
 
 			return bits() - 1;
 		}
@@ -945,17 +881,18 @@ namespace rb::math
 	public:
 		[[nodiscard]] size_t size() const noexcept
 		{
-			return m_data.size();
+			return m_data.size() * sizeof(uint64_t);
 		}
 
+		// Limbs are stored in little-endian order, which matches the byte order of the supported targets
 		[[nodiscard]] uint8_t* data() noexcept
 		{
-			return m_data.data();
+			return reinterpret_cast<uint8_t*>(m_data.data());
 		}
 
 		[[nodiscard]] const uint8_t* data() const noexcept
 		{
-			return m_data.data();
+			return reinterpret_cast<const uint8_t*>(m_data.data());
 		}
 
 	public:
@@ -981,69 +918,31 @@ namespace rb::math
 	public:
 		[[nodiscard]] this_type operator+(const this_type& rhs) const noexcept
 		{
-			const this_type& longer = size() >= rhs.size() ? *this : rhs;
-			const this_type& shorter = size() < rhs.size() ? *this : rhs;
+			const this_type& longer = m_data.size() >= rhs.m_data.size() ? *this : rhs;
+			const this_type& shorter = m_data.size() < rhs.m_data.size() ? *this : rhs;
 
 			this_type result;
-			result.resize(longer.size() + 1);
+			result.resize(longer.m_data.size() + 1);
 
-			uint32_t carry = 0;
-			for (size_t i = 0; i < shorter.size(); i++)
-			{
-				uint32_t temp = carry + longer.m_data[i] + shorter.m_data[i];
-				result.m_data[i] = temp & 0xFF;
-				carry = temp >> 8;
-			}
-
-			for (size_t i = shorter.size(); i < longer.size(); i++)
-			{
-				uint32_t temp = carry + longer.m_data[i];
-				result.m_data[i] = temp & 0xFF;
-				carry = temp >> 8;
-			}
-
-			if (carry)
-				result.m_data.back() = carry;
+			result.m_data.back() = _limbs_add(result.m_data.data(), longer.m_data.data(), longer.m_data.size(), shorter.m_data.data(), shorter.m_data.size());
 
 			result.fit();
 
 			return result;
 		}
 
+		// Yields the absolute difference of the operands
 		[[nodiscard]] this_type operator-(const this_type& rhs) const noexcept
 		{
-			this_type result, greater, lesser;
+			const bool less = *this < rhs;
 
-			if (*this >= rhs)
-			{
-				greater = *this;
-				lesser = rhs;
-			}
-			else
-			{
-				greater = rhs;
-				lesser = *this;
-			}
+			const this_type& greater = less ? rhs : *this;
+			const this_type& lesser = less ? *this : rhs;
 
-			lesser.resize(greater.size());
-			result.resize(greater.size() + 1);
+			this_type result;
+			result.resize(greater.m_data.size());
 
-			int32_t borrow = 0;
-			for (size_t i = 0; i < greater.size(); i++)
-			{
-				int32_t temp = borrow + static_cast<int32_t>(greater.m_data[i]) - static_cast<int32_t>(lesser.m_data[i]);
-
-				if (temp < 0)
-				{
-					result.m_data[i] = (256 + (temp % 256)) & 0xFF;
-					borrow = temp >> 8;
-				}
-				else
-				{
-					result.m_data[i] = temp;
-					borrow = 0;
-				}
-			}
+			_limbs_sub(result.m_data.data(), greater.m_data.data(), greater.m_data.size(), lesser.m_data.data(), _limbs_size(lesser.m_data.data(), lesser.m_data.size()));
 
 			result.fit();
 
@@ -1091,23 +990,15 @@ namespace rb::math
 			if (is_zero() || rhs.is_zero())
 				return 0;
 
-			this_type a = *this, b = rhs;
-			size_t result_size = a.size() + b.size();
+			const size_t na = _limbs_size(m_data.data(), m_data.size());
+			const size_t nb = _limbs_size(rhs.m_data.data(), rhs.m_data.size());
 
 			this_type result;
-			result.resize(result_size);
-			a.resize(result_size);
-			b.resize(result_size);
+			result.resize(na + nb);
 
-			for (size_t i = 0; i < result_size; i++)
-			{
-				for (size_t j = 0, carry = 0; j < result_size - i; j++)
-				{
-					uint32_t temp = carry + a.m_data[i] * b.m_data[j] + result.m_data[i + j];
-					result.m_data[i + j] = temp & 0xFF;
-					carry = temp >> 8;
-				}
-			}
+			data_type scratch(_limbs_mul_scratch_size(na, nb));
+
+			_limbs_mul(result.m_data.data(), m_data.data(), na, rhs.m_data.data(), nb, scratch.data());
 
 			result.fit();
 
@@ -1158,9 +1049,9 @@ namespace rb::math
 		[[nodiscard]] this_type operator&(const this_type& rhs) const noexcept
 		{
 			this_type result = *this;
-			result.resize(rhs.size());
+			result.resize(rhs.m_data.size());
 
-			for (size_t i = 0; i < result.size(); i++)
+			for (size_t i = 0; i < result.m_data.size(); i++)
 				result.m_data[i] &= rhs.m_data[i];
 
 			result.fit();
@@ -1172,10 +1063,10 @@ namespace rb::math
 		{
 			this_type result = *this;
 
-			if (result.size() < rhs.size())
-				result.resize(rhs.size());
+			if (result.m_data.size() < rhs.m_data.size())
+				result.resize(rhs.m_data.size());
 
-			for (size_t i = 0; i < rhs.size(); i++)
+			for (size_t i = 0; i < rhs.m_data.size(); i++)
 				result.m_data[i] |= rhs.m_data[i];
 
 			result.fit();
@@ -1188,12 +1079,12 @@ namespace rb::math
 			this_type result = *this;
 			this_type temp = rhs;
 
-			if (result.size() < temp.size())
-				result.resize(temp.size());
+			if (result.m_data.size() < temp.m_data.size())
+				result.resize(temp.m_data.size());
 			else
-				temp.resize(result.size());
+				temp.resize(result.m_data.size());
 
-			for (size_t i = 0; i < result.size(); i++)
+			for (size_t i = 0; i < result.m_data.size(); i++)
 				result.m_data[i] ^= temp.m_data[i];
 
 			result.fit();
@@ -1209,18 +1100,10 @@ namespace rb::math
 			if (is_zero())
 				return ZERO();
 
-			const uint32_t byte_pos = rhs / 8;
-			const uint32_t bit_offs = rhs % 8;
-
-			this_type result;
-			result.resize(size() + (rhs + 7) / 8);
-
-			result.m_data[byte_pos] = m_data[0] << bit_offs;
-
-			for (size_t i = byte_pos + 1; i < result.size() - 1; i++)
-				result.m_data[i] |= (m_data[i - byte_pos] << bit_offs) | (m_data[i - byte_pos - 1] >> (8 - bit_offs));
+			this_type result = *this;
+			result.resize(m_data.size() + rhs / 64 + 1);
 
-			result.m_data.back() = m_data.back() >> ((8 - bit_offs) % 8);
+			_limbs_shl(result.m_data.data(), result.m_data.data(), result.m_data.size(), rhs);
 
 			result.fit();
 
@@ -1232,14 +1115,7 @@ namespace rb::math
 			if (rhs.is_zero())
 				return *this;
 
-			this_type temp = rhs;
-
-			if (rhs.size() < 4)
-				temp.resize(4);
-
-			uint32_t shift = rb::bit::read_le<uint32_t>(temp.m_data.data());
-
-			return *this << shift;
+			return *this << static_cast<uint32_t>(rhs.m_data[0]);
 		}
 
 		[[nodiscard]] this_type operator>>(uint32_t rhs) const noexcept
@@ -1247,17 +1123,12 @@ namespace rb::math
 			if (rhs == 0)
 				return *this;
 
-			if (rhs >= size() * 8)
+			if (rhs >= m_data.size() * 64)
 				return 0;
 
-			const uint32_t byte_pos = rhs / 8;
-			const uint32_t bit_offs = rhs % 8;
-
-			this_type result;
-			result.resize(size() - byte_pos);
+			this_type result = *this;
 
-			for (size_t i = 0; i < result.size(); i++)
-				result.m_data[i] |= (m_data[i + byte_pos] >> bit_offs) | (byte_pos + i + 1 < size() ? (m_data[byte_pos + i + 1] << (8 - bit_offs)) : 0);
+			_limbs_shr(result.m_data.data(), result.m_data.data(), result.m_data.size(), rhs);
 
 			result.fit();
 
@@ -1269,23 +1140,23 @@ namespace rb::math
 			if (rhs.is_zero())
 				return *this;
 
-			this_type temp = rhs;
-
-			if (rhs.size() < 4)
-				temp.resize(4);
-
-			uint32_t shift = rb::bit::read_le<uint32_t>(temp.m_data.data());
-
-			return *this >> shift;
+			return *this >> static_cast<uint32_t>(rhs.m_data[0]);
 		}
 
+		// Complements the bytes up to the most significant non-zero one
 		[[nodiscard]] this_type operator~() const noexcept
 		{
+			const size_t byte_size = std::max<size_t>((bits() + 7) / 8, 1);
+
 			this_type result = *this;
+			result.fit();
 
-			for (size_t i = 0; i < result.size(); i++)
+			for (size_t i = 0; i < result.m_data.size(); i++)
 				result.m_data[i] = ~result.m_data[i];
 
+			if (byte_size % 8 != 0)
+				result.m_data.back() &= (uint64_t(1) << (byte_size % 8 * 8)) - 1;
+
 			result.fit();
 
 			return result;
@@ -1293,10 +1164,10 @@ namespace rb::math
 
 		this_type& operator&=(const this_type& rhs) noexcept
 		{
-			if (size() > rhs.size())
-				resize(rhs.size());
+			if (m_data.size() > rhs.m_data.size())
+				resize(rhs.m_data.size());
 
-			for (size_t i = 0; i < size(); i++)
+			for (size_t i = 0; i < m_data.size(); i++)
 				m_data[i] &= rhs.m_data[i];
 
 			fit();
@@ -1306,10 +1177,10 @@ namespace rb::math
 
 		this_type& operator|=(const this_type& rhs) noexcept
 		{
-			if (size() < rhs.size())
-				resize(rhs.size());
+			if (m_data.size() < rhs.m_data.size())
+				resize(rhs.m_data.size());
 
-			for (size_t i = 0; i < rhs.size(); i++)
+			for (size_t i = 0; i < rhs.m_data.size(); i++)
 				m_data[i] |= rhs.m_data[i];
 
 			fit();
@@ -1321,12 +1192,12 @@ namespace rb::math
 		{
 			this_type temp = rhs;
 
-			if (size() < temp.size())
-				resize(temp.size());
+			if (m_data.size() < temp.m_data.size())
+				resize(temp.m_data.size());
 			else
-				temp.resize(size());
+				temp.resize(m_data.size());
 
-			for (size_t i = 0; i < size(); i++)
+			for (size_t i = 0; i < m_data.size(); i++)
 				m_data[i] ^= temp.m_data[i];
 
 			fit();
@@ -1361,21 +1232,13 @@ namespace rb::math
 	public:
 		[[nodiscard]] bool operator<(const this_type& rhs) const noexcept
 		{
-			if (size() > rhs.size())
-				for (int32_t i = static_cast<int32_t>(size()) - 1; i >= static_cast<int32_t>(rhs.size()); i--)
-					if (m_data[i])
-						return false;
+			const size_t na = _limbs_size(m_data.data(), m_data.size());
+			const size_t nb = _limbs_size(rhs.m_data.data(), rhs.m_data.size());
 
-			if (size() < rhs.size())
-				for (int32_t i = static_cast<int32_t>(rhs.size()) - 1; i >= static_cast<int32_t>(size()); i--)
-					if (rhs.m_data[i])
-						return true;
+			if (na != nb)
+				return na < nb;
 
-			for (int32_t i = static_cast<int32_t>(std::min(size(), rhs.size())) - 1; i >= 0; i--)
-				if (m_data[i] != rhs.m_data[i])
-					return m_data[i] < rhs.m_data[i];
-
-			return false;
+			return _limbs_cmp(m_data.data(), rhs.m_data.data(), na) < 0;
 		}
 
 		[[nodiscard]] bool operator<=(const this_type& rhs) const noexcept
@@ -1395,14 +1258,10 @@ namespace rb::math
 
 		[[nodiscard]] bool operator==(const this_type& rhs) const noexcept
 		{
-			if (size() != rhs.size())
-				return false;
-
-			for (size_t i = 0; i < size(); i++)
-				if (m_data[i] != rhs.m_data[i])
-					return false;
+			const size_t na = _limbs_size(m_data.data(), m_data.size());
+			const size_t nb = _limbs_size(rhs.m_data.data(), rhs.m_data.size());
 
-			return true;
+			return na == nb && _limbs_cmp(m_data.data(), rhs.m_data.data(), na) == 0;
 		}
 
 		[[nodiscard]] bool operator!=(const this_type& rhs) const noexcept
@@ -1413,17 +1272,15 @@ namespace rb::math
 	public:
 		friend std::ostream& operator<<(std::ostream& os, const this_type& v)
 		{
-			data_type::const_reverse_iterator it = v.m_data.rbegin();
+			size_t i = _limbs_size(v.m_data.data(), v.m_data.size());
 
-			if (it == v.m_data.rend())
+			if (i == 0)
 				os << "0";
 			else
-			{
-				os << std::hex << static_cast<uint32_t>(*(it++));
+				os << std::hex << v.m_data[--i];
 
-				while (it != v.m_data.rend())
-					os << std::setw(2) << std::setfill('0') << std::hex << static_cast<uint32_t>(*(it++));
-			}
+			while (i > 0)
+				os << std::setw(16) << std::setfill('0') << std::hex << v.m_data[--i];
 
 			return os;
 		}
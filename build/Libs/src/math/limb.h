@@ -0,0 +1,629 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include <algorithm>
+
+#include "intrin/constexpr.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace rb::math
+{
+	/**
+	 * \brief Operand size in limbs from which multiplication switches from schoolbook to Karatsuba.
+	 */
+	inline constexpr size_t KARATSUBA_THRESHOLD = 32;
+
+	/**
+	 * \brief Adds two limbs and an incoming carry.
+	 *
+	 * \param carry Incoming carry, 0 or 1.
+	 * \param a First operand.
+	 * \param b Second operand.
+	 * \param out Destination of the sum.
+	 * \return Outgoing carry.
+	 */
+	constexpr uint8_t _addcarry(uint8_t carry, uint64_t a, uint64_t b, uint64_t& out) noexcept
+	{
+#if defined(_M_X64) || defined(__x86_64__)
+		if (!rb::intrin::_is_constant_evaluated())
+		{
+			unsigned long long sum = 0;
+			carry = _addcarry_u64(carry, a, b, &sum);
+			out = sum;
+			return carry;
+		}
+#endif
+
+		const uint64_t partial = a + b;
+		const uint64_t sum = partial + carry;
+
+		out = sum;
+		return static_cast<uint8_t>((partial < a) | (sum < partial));
+	}
+
+	/**
+	 * \brief Subtracts a limb and an incoming borrow from another limb.
+	 *
+	 * \param borrow Incoming borrow, 0 or 1.
+	 * \param a Minuend.
+	 * \param b Subtrahend.
+	 * \param out Destination of the difference.
+	 * \return Outgoing borrow.
+	 */
+	constexpr uint8_t _subborrow(uint8_t borrow, uint64_t a, uint64_t b, uint64_t& out) noexcept
+	{
+#if defined(_M_X64) || defined(__x86_64__)
+		if (!rb::intrin::_is_constant_evaluated())
+		{
+			unsigned long long diff = 0;
+			borrow = _subborrow_u64(borrow, a, b, &diff);
+			out = diff;
+			return borrow;
+		}
+#endif
+
+		const uint64_t partial = a - b;
+		const uint64_t diff = partial - borrow;
+
+		out = diff;
+		return static_cast<uint8_t>((a < b) | (partial < borrow));
+	}
+
+	/**
+	 * \brief Multiplies two limbs into a double limb product.
+	 *
+	 * \param a First operand.
+	 * \param b Second operand.
+	 * \param hi Destination of the upper half of the product.
+	 * \return Lower half of the product.
+	 */
+	constexpr uint64_t _mulx(uint64_t a, uint64_t b, uint64_t& hi) noexcept
+	{
+#if defined(__SIZEOF_INT128__)
+		const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+
+		hi = static_cast<uint64_t>(product >> 64);
+		return static_cast<uint64_t>(product);
+#else
+#if defined(_M_X64)
+		if (!rb::intrin::_is_constant_evaluated())
+		{
+			unsigned long long high = 0;
+			const uint64_t low = _umul128(a, b, &high);
+			hi = high;
+			return low;
+		}
+#endif
+
+		const uint64_t a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+		const uint64_t b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+
+		const uint64_t p0 = a_lo * b_lo;
+		const uint64_t p1 = a_lo * b_hi;
+		const uint64_t p2 = a_hi * b_lo;
+		const uint64_t p3 = a_hi * b_hi;
+
+		const uint64_t mid = (p0 >> 32) + (p1 & 0xFFFFFFFF) + (p2 & 0xFFFFFFFF);
+
+		hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+		return (mid << 32) | (p0 & 0xFFFFFFFF);
+#endif
+	}
+
+	/**
+	 * \brief Computes `a * b + c + d`, which always fits into a double limb.
+	 *
+	 * \param hi Destination of the upper half of the result.
+	 * \return Lower half of the result.
+	 */
+	constexpr uint64_t _muladd(uint64_t a, uint64_t b, uint64_t c, uint64_t d, uint64_t& hi) noexcept
+	{
+		uint64_t high = 0;
+		uint64_t low = _mulx(a, b, high);
+
+		low += c;
+		high += low < c;
+
+		low += d;
+		high += low < d;
+
+		hi = high;
+		return low;
+	}
+
+	/**
+	 * \brief Counts the leading zero bits of a limb.
+	 */
+	[[nodiscard]] constexpr uint32_t _clz(uint64_t x) noexcept
+	{
+		if (x == 0)
+			return 64;
+
+		uint32_t n = 0;
+
+		for (uint32_t shift = 32; shift > 0; shift >>= 1)
+		{
+			if ((x >> (64 - shift)) == 0)
+			{
+				x <<= shift;
+				n += shift;
+			}
+		}
+
+		return n;
+	}
+
+	/**
+	 * \brief Divides a double limb by a limb.
+	 *
+	 * The quotient must fit into a single limb, i.e. `hi` must be less than `d`.
+	 *
+	 * \param hi Upper half of the dividend.
+	 * \param lo Lower half of the dividend.
+	 * \param d Divisor.
+	 * \param rem Destination of the remainder.
+	 * \return Quotient.
+	 */
+	constexpr uint64_t _divx(uint64_t hi, uint64_t lo, uint64_t d, uint64_t& rem) noexcept
+	{
+#if defined(__SIZEOF_INT128__)
+		const unsigned __int128 n = (static_cast<unsigned __int128>(hi) << 64) | lo;
+
+		rem = static_cast<uint64_t>(n % d);
+		return static_cast<uint64_t>(n / d);
+#else
+		// Divide two 32-bit digits at a time (Hacker's Delight, divlu)
+		// https://github.com/hcs0/Hackers-Delight/blob/master/divlu.c.txt
+		constexpr uint64_t BASE = uint64_t(1) << 32;
+
+		const uint32_t s = _clz(d);
+		d <<= s;
+
+		const uint64_t d1 = d >> 32, d0 = d & 0xFFFFFFFF;
+		const uint64_t n32 = s == 0 ? hi : (hi << s) | (lo >> (64 - s));
+		const uint64_t n10 = lo << s;
+		const uint64_t n1 = n10 >> 32, n0 = n10 & 0xFFFFFFFF;
+
+		uint64_t q1 = n32 / d1;
+		uint64_t rhat = n32 - q1 * d1;
+
+		while (q1 >= BASE || q1 * d0 > BASE * rhat + n1)
+		{
+			q1--;
+			rhat += d1;
+
+			if (rhat >= BASE)
+				break;
+		}
+
+		const uint64_t n21 = n32 * BASE + n1 - q1 * d;
+
+		uint64_t q0 = n21 / d1;
+		rhat = n21 - q0 * d1;
+
+		while (q0 >= BASE || q0 * d0 > BASE * rhat + n0)
+		{
+			q0--;
+			rhat += d1;
+
+			if (rhat >= BASE)
+				break;
+		}
+
+		rem = (n21 * BASE + n0 - q0 * d) >> s;
+		return q1 * BASE + q0;
+#endif
+	}
+
+	/**
+	 * \brief Returns the number of limbs without the leading zero limbs.
+	 */
+	[[nodiscard]] constexpr size_t _limbs_size(const uint64_t* a, size_t n) noexcept
+	{
+		while (n > 0 && a[n - 1] == 0)
+			n--;
+
+		return n;
+	}
+
+	/**
+	 * \brief Returns the number of significant bits.
+	 */
+	[[nodiscard]] constexpr size_t _limbs_bits(const uint64_t* a, size_t n) noexcept
+	{
+		n = _limbs_size(a, n);
+
+		if (n == 0)
+			return 0;
+
+		return n * 64 - _clz(a[n - 1]);
+	}
+
+	/**
+	 * \brief Compares two numbers of equal length.
+	 *
+	 * \return Negative, zero or positive if `a` is less than, equal to or greater than `b`.
+	 */
+	[[nodiscard]] constexpr int _limbs_cmp(const uint64_t* a, const uint64_t* b, size_t n) noexcept
+	{
+		while (n-- > 0)
+			if (a[n] != b[n])
+				return a[n] < b[n] ? -1 : 1;
+
+		return 0;
+	}
+
+	/**
+	 * \brief Computes `r = a + b`, where `a` has `na` and `b` has `nb <= na` limbs.
+	 *
+	 * \return Carry out of the most significant limb.
+	 */
+	constexpr uint8_t _limbs_add(uint64_t* r, const uint64_t* a, size_t na, const uint64_t* b, size_t nb) noexcept
+	{
+		uint8_t carry = 0;
+		size_t i = 0;
+
+		for (; i < nb; i++)
+			carry = _addcarry(carry, a[i], b[i], r[i]);
+
+		for (; i < na; i++)
+			carry = _addcarry(carry, a[i], 0, r[i]);
+
+		return carry;
+	}
+
+	/**
+	 * \brief Computes `r = a - b`, where `a` has `na` and `b` has `nb <= na` limbs.
+	 *
+	 * \return Borrow out of the most significant limb.
+	 */
+	constexpr uint8_t _limbs_sub(uint64_t* r, const uint64_t* a, size_t na, const uint64_t* b, size_t nb) noexcept
+	{
+		uint8_t borrow = 0;
+		size_t i = 0;
+
+		for (; i < nb; i++)
+			borrow = _subborrow(borrow, a[i], b[i], r[i]);
+
+		for (; i < na; i++)
+			borrow = _subborrow(borrow, a[i], 0, r[i]);
+
+		return borrow;
+	}
+
+	/**
+	 * \brief Computes `r += a * m`.
+	 *
+	 * \return Carry limb out of `r[n - 1]`.
+	 */
+	constexpr uint64_t _limbs_addmul_1(uint64_t* r, const uint64_t* a, size_t n, uint64_t m) noexcept
+	{
+		uint64_t carry = 0;
+
+		for (size_t i = 0; i < n; i++)
+		{
+			uint64_t hi = 0;
+			uint64_t lo = _mulx(a[i], m, hi);
+
+			lo += carry;
+			hi += lo < carry;
+
+			r[i] += lo;
+			hi += r[i] < lo;
+
+			carry = hi;
+		}
+
+		return carry;
+	}
+
+	/**
+	 * \brief Computes `r = a << s` for `s < 64`. `r` may alias `a`.
+	 *
+	 * \return Bits shifted out of the most significant limb.
+	 */
+	constexpr uint64_t _limbs_shl_bits(uint64_t* r, const uint64_t* a, size_t n, uint32_t s) noexcept
+	{
+		if (s == 0)
+		{
+			for (size_t i = n; i-- > 0;)
+				r[i] = a[i];
+
+			return 0;
+		}
+
+		const uint64_t out = n > 0 ? a[n - 1] >> (64 - s) : 0;
+
+		for (size_t i = n; i-- > 1;)
+			r[i] = (a[i] << s) | (a[i - 1] >> (64 - s));
+
+		if (n > 0)
+			r[0] = a[0] << s;
+
+		return out;
+	}
+
+	/**
+	 * \brief Computes `r = a << shift` truncated to `n` limbs. `r` may alias `a`.
+	 */
+	constexpr void _limbs_shl(uint64_t* r, const uint64_t* a, size_t n, size_t shift) noexcept
+	{
+		const size_t limb_shift = std::min(shift / 64, n);
+		const uint32_t bit_shift = shift % 64;
+
+		for (size_t i = n; i-- > limb_shift;)
+		{
+			r[i] = a[i - limb_shift] << bit_shift;
+
+			if (bit_shift != 0 && i > limb_shift)
+				r[i] |= a[i - limb_shift - 1] >> (64 - bit_shift);
+		}
+
+		for (size_t i = 0; i < limb_shift; i++)
+			r[i] = 0;
+	}
+
+	/**
+	 * \brief Computes `r = a >> shift`. `r` may alias `a`.
+	 */
+	constexpr void _limbs_shr(uint64_t* r, const uint64_t* a, size_t n, size_t shift) noexcept
+	{
+		const size_t limb_shift = std::min(shift / 64, n);
+		const uint32_t bit_shift = shift % 64;
+
+		for (size_t i = 0; i < n - limb_shift; i++)
+		{
+			r[i] = a[i + limb_shift] >> bit_shift;
+
+			if (bit_shift != 0 && i + limb_shift + 1 < n)
+				r[i] |= a[i + limb_shift + 1] << (64 - bit_shift);
+		}
+
+		for (size_t i = n - limb_shift; i < n; i++)
+			r[i] = 0;
+	}
+
+	/**
+	 * \brief Computes the full product `r = a * b` with the schoolbook method.
+	 *
+	 * `r` has `na + nb` limbs and must not alias the operands.
+	 */
+	constexpr void _limbs_mul_basecase(uint64_t* r, const uint64_t* a, size_t na, const uint64_t* b, size_t nb) noexcept
+	{
+		for (size_t i = 0; i < na; i++)
+			r[i] = 0;
+
+		for (size_t j = 0; j < nb; j++)
+			r[na + j] = _limbs_addmul_1(r + j, a, na, b[j]);
+	}
+
+	/**
+	 * \brief Computes the lower `n` limbs of `a * b` with the schoolbook method.
+	 *
+	 * `r` must not alias the operands.
+	 */
+	constexpr void _limbs_mul_low(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) noexcept
+	{
+		const size_t na = _limbs_size(a, n);
+		const size_t nb = _limbs_size(b, n);
+
+		for (size_t i = 0; i < n; i++)
+			r[i] = 0;
+
+		for (size_t j = 0; j < nb; j++)
+		{
+			const size_t len = std::min(na, n - j);
+			const uint64_t carry = _limbs_addmul_1(r + j, a, len, b[j]);
+
+			if (j + len < n)
+				r[j + len] = carry;
+		}
+	}
+
+	/**
+	 * \brief Returns the scratch size in limbs required by `_limbs_mul_karatsuba`.
+	 */
+	[[nodiscard]] constexpr size_t _karatsuba_scratch_size(size_t n) noexcept
+	{
+		size_t size = 0;
+
+		while (n >= KARATSUBA_THRESHOLD)
+		{
+			n = n - n / 2 + 1;
+			size += 4 * n;
+		}
+
+		return size;
+	}
+
+	// Karatsuba multiplication
+	// https://en.wikipedia.org/wiki/Karatsuba_algorithm
+	constexpr void _limbs_mul_karatsuba(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n, uint64_t* scratch) noexcept
+	{
+		if (n < KARATSUBA_THRESHOLD)
+		{
+			_limbs_mul_basecase(r, a, n, b, n);
+			return;
+		}
+
+		const size_t l = n / 2;
+		const size_t h = n - l;
+
+		// z0 = a0 * b0 and z2 = a1 * b1 go straight into the result
+		_limbs_mul_karatsuba(r, a, b, l, scratch);
+		_limbs_mul_karatsuba(r + 2 * l, a + l, b + l, h, scratch);
+
+		uint64_t* sa = scratch;
+		uint64_t* sb = sa + (h + 1);
+		uint64_t* z1 = sb + (h + 1);
+
+		// z1 = (a0 + a1) * (b0 + b1) - z0 - z2
+		sa[h] = _limbs_add(sa, a + l, h, a, l);
+		sb[h] = _limbs_add(sb, b + l, h, b, l);
+
+		_limbs_mul_karatsuba(z1, sa, sb, h + 1, z1 + 2 * (h + 1));
+
+		_limbs_sub(z1, z1, 2 * (h + 1), r, 2 * l);
+		_limbs_sub(z1, z1, 2 * (h + 1), r + 2 * l, 2 * h);
+
+		_limbs_add(r + l, r + l, 2 * n - l, z1, 2 * (h + 1));
+	}
+
+	/**
+	 * \brief Returns the scratch size in limbs required by `_limbs_mul`.
+	 */
+	[[nodiscard]] constexpr size_t _limbs_mul_scratch_size(size_t na, size_t nb) noexcept
+	{
+		if (na < nb)
+			return _limbs_mul_scratch_size(nb, na);
+
+		if (nb < KARATSUBA_THRESHOLD)
+			return 0;
+
+		if (na == nb)
+			return _karatsuba_scratch_size(nb);
+
+		return 2 * nb + std::max(_karatsuba_scratch_size(nb), _limbs_mul_scratch_size(nb, na % nb));
+	}
+
+	/**
+	 * \brief Computes the full product `r = a * b`.
+	 *
+	 * `r` has `na + nb` limbs and must not alias the operands. Uses the schoolbook method for small
+	 * operands and Karatsuba otherwise, unbalanced operands are multiplied in chunks of the shorter one.
+	 *
+	 * \param scratch Temporary storage of `_limbs_mul_scratch_size(na, nb)` limbs.
+	 */
+	constexpr void _limbs_mul(uint64_t* r, const uint64_t* a, size_t na, const uint64_t* b, size_t nb, uint64_t* scratch) noexcept
+	{
+		if (na < nb)
+		{
+			_limbs_mul(r, b, nb, a, na, scratch);
+			return;
+		}
+
+		if (nb < KARATSUBA_THRESHOLD)
+		{
+			_limbs_mul_basecase(r, a, na, b, nb);
+			return;
+		}
+
+		if (na == nb)
+		{
+			_limbs_mul_karatsuba(r, a, b, nb, scratch);
+			return;
+		}
+
+		uint64_t* t = scratch;
+
+		for (size_t i = 0; i < na + nb; i++)
+			r[i] = 0;
+
+		for (size_t i = 0; i < na; i += nb)
+		{
+			const size_t len = std::min(nb, na - i);
+
+			if (len == nb)
+				_limbs_mul_karatsuba(t, a + i, b, nb, t + 2 * nb);
+			else
+				_limbs_mul(t, b, nb, a + i, len, t + 2 * nb);
+
+			_limbs_add(r + i, r + i, na + nb - i, t, len + nb);
+		}
+	}
+
+	// Knuth's Algorithm D (TAOCP Vol. 2, 4.3.1)
+	// https://skanthak.homepage.t-online.de/division.html
+	//
+	// Divides `u` of `m` limbs by `v` of `n` limbs, where `m >= n` and `v[n - 1] != 0`. The quotient
+	// has `m - n + 1` limbs and the remainder `n` limbs, scratch has to hold `m + n + 1` limbs.
+	constexpr void _limbs_divmod(uint64_t* q, uint64_t* r, const uint64_t* u, size_t m, const uint64_t* v, size_t n, uint64_t* scratch) noexcept
+	{
+		uint64_t* un = scratch;
+		uint64_t* vn = scratch + m + 1;
+
+		// Normalize so that the most significant bit of the divisor is set
+		const uint32_t s = _clz(v[n - 1]);
+
+		_limbs_shl_bits(vn, v, n, s);
+		un[m] = _limbs_shl_bits(un, u, m, s);
+
+		if (n == 1)
+		{
+			uint64_t rem = un[m];
+
+			for (size_t j = m; j-- > 0;)
+				q[j] = _divx(rem, un[j], vn[0], rem);
+
+			r[0] = rem >> s;
+			return;
+		}
+
+		for (size_t j = m - n + 1; j-- > 0;)
+		{
+			// Estimate the quotient limb from the top two limbs and correct it using the next one
+			uint64_t qhat = 0, rhat = 0;
+			bool rhat_overflow = false;
+
+			if (un[j + n] >= vn[n - 1])
+			{
+				qhat = ~uint64_t(0);
+				rhat = un[j + n - 1] + vn[n - 1];
+				rhat_overflow = rhat < vn[n - 1];
+			}
+			else
+				qhat = _divx(un[j + n], un[j + n - 1], vn[n - 1], rhat);
+
+			while (!rhat_overflow)
+			{
+				uint64_t hi = 0;
+				const uint64_t lo = _mulx(qhat, vn[n - 2], hi);
+
+				if (hi < rhat || (hi == rhat && lo <= un[j + n - 2]))
+					break;
+
+				qhat--;
+				rhat += vn[n - 1];
+				rhat_overflow = rhat < vn[n - 1];
+			}
+
+			// Multiply and subtract
+			uint64_t carry = 0;
+			uint8_t borrow = 0;
+
+			for (size_t i = 0; i < n; i++)
+			{
+				uint64_t hi = 0;
+				uint64_t lo = _mulx(qhat, vn[i], hi);
+
+				lo += carry;
+				hi += lo < carry;
+
+				borrow = _subborrow(borrow, un[i + j], lo, un[i + j]);
+				carry = hi;
+			}
+
+			borrow = _subborrow(borrow, un[j + n], carry, un[j + n]);
+
+			// Add back if the estimate was one too large
+			if (borrow)
+			{
+				qhat--;
+				un[j + n] += _limbs_add(un + j, un + j, n, vn, n);
+			}
+
+			q[j] = qhat;
+		}
+
+		// Denormalize the remainder
+		for (size_t i = 0; i < n; i++)
+			r[i] = s == 0 ? un[i] : (un[i] >> s) | (un[i + 1] << (64 - s));
+	}
+}
@@ -9,6 +9,10 @@
 #include <type_traits>
 #include <initializer_list>
 
+#include "intrin/constexpr.h"
+
+#include "math/matrix_simd.h"
+
 namespace rb::math
 {
 	template<class T, size_t R, size_t C>
@@ -84,7 +88,7 @@ namespace rb::math
 		}
 
 	public:
-		template<typename = typename std::enable_if_t<IS_SQUARE>>
+		template<bool B = IS_SQUARE, typename = std::enable_if_t<B>>
 		[[nodiscard]] static constexpr this_type IDENTITY() noexcept
 		{
 			this_type identity;
@@ -175,7 +179,7 @@ namespace rb::math
 			return true;
 		}
 
-		template<typename = typename std::enable_if_t<IS_SQUARE>>
+		template<bool B = IS_SQUARE, typename = std::enable_if_t<B>>
 		[[nodiscard]] constexpr bool is_identity() const noexcept
 		{
 			for (size_t i = 0; i < SIZE; i++)
@@ -204,6 +208,15 @@ namespace rb::math
 		{
 			matrix<value_type, COLS, ROWS> m;
 
+			if constexpr (ROWS == 4 && COLS == 4 && _has_simd_kernel_v<value_type, 4>)
+			{
+				if (!rb::intrin::_is_constant_evaluated())
+				{
+					_transpose4(data(), m.data());
+					return m;
+				}
+			}
+
 			for (size_t r = 0; r < ROWS; r++)
 				for (size_t c = 0; c < COLS; c++)
 					m.at(c, r) = at(r, c);
@@ -211,7 +224,7 @@ namespace rb::math
 			return m;
 		}
 
-		template<typename = typename std::enable_if_t<(ROWS > 1 && COLS > 1)>>
+		template<bool B = (ROWS > 1 && COLS > 1), typename = std::enable_if_t<B>>
 		[[nodiscard]] constexpr matrix<value_type, ROWS - 1, COLS - 1> submatrix(size_t r, size_t c) const noexcept
 		{
 			matrix<value_type, ROWS - 1, COLS - 1> m;
@@ -298,7 +311,7 @@ namespace rb::math
 		}
 
 	private:
-		template<typename = typename std::enable_if_t<IS_SQUARE>>
+		template<bool B = IS_SQUARE, typename = std::enable_if_t<B>>
 		[[nodiscard]] constexpr value_type _gaussian_determinant() const noexcept
 		{
 			if constexpr (ROWS == 2)
@@ -341,7 +354,7 @@ namespace rb::math
 			return det;
 		}
 
-		template<typename = typename std::enable_if_t<IS_SQUARE>>
+		template<bool B = IS_SQUARE, typename = std::enable_if_t<B>>
 		[[nodiscard]] constexpr value_type _recursive_determinant() const noexcept
 		{
 			if constexpr (ROWS == 2)
@@ -349,40 +362,126 @@ namespace rb::math
 
 			value_type det = 0;
 
-			for (size_t i = 0; i < _S; i++)
+			for (size_t i = 0; i < ROWS; i++)
 				det += at(0, i) * submatrix(0, i)._recursive_determinant() * (i % 2 ? -1 : 1);
 
 			return det;
 		}
 
-		template<typename = typename std::enable_if_t<IS_SQUARE>>
+		template<bool B = IS_SQUARE, typename = std::enable_if_t<B>>
 		[[nodiscard]] constexpr this_type _inverse() const noexcept
 		{
-			value_type det = determinant();
+			this_type inv;
+
+			if constexpr (ROWS == 4 && _has_simd_kernel_v<value_type, 4>)
+			{
+				if (!rb::intrin::_is_constant_evaluated())
+				{
+					if (!_inverse4(data(), inv.data()))
+						return {};
 
-			if (det == 0)
-				return {};
+					return inv;
+				}
+			}
 
 			if constexpr (ROWS == 2)
-				return this_type{
-					m.at(1, 1), -m.at(0, 1),
-					-m.at(1, 0), m.at(0, 0)
-				} / det;
+			{
+				const value_type det = at(0, 0) * at(1, 1) - at(0, 1) * at(1, 0);
 
-			this_type cof = cofactors();
-			this_type adj = cof.transpose();
+				if (det == 0)
+					return {};
 
-			return adj / det;
+				inv.at(0, 0) = at(1, 1);
+				inv.at(0, 1) = -at(0, 1);
+				inv.at(1, 0) = -at(1, 0);
+				inv.at(1, 1) = at(0, 0);
+
+				return inv / det;
+			}
+			else if constexpr (ROWS == 3)
+			{
+				// The columns of the inverse are the cross products of the rows, scaled by 1 / det
+				for (size_t i = 0; i < ROWS; i++)
+				{
+					const size_t r0 = (i + 1) % ROWS;
+					const size_t r1 = (i + 2) % ROWS;
+
+					inv.at(0, i) = at(r0, 1) * at(r1, 2) - at(r0, 2) * at(r1, 1);
+					inv.at(1, i) = at(r0, 2) * at(r1, 0) - at(r0, 0) * at(r1, 2);
+					inv.at(2, i) = at(r0, 0) * at(r1, 1) - at(r0, 1) * at(r1, 0);
+				}
+
+				const value_type det = at(0, 0) * inv.at(0, 0) + at(0, 1) * inv.at(1, 0) + at(0, 2) * inv.at(2, 0);
+
+				if (det == 0)
+					return {};
+
+				return inv / det;
+			}
+			else
+			{
+				// Gauss-Jordan elimination with partial pivoting
+				// https://en.wikipedia.org/wiki/Gaussian_elimination#Finding_the_inverse_of_a_matrix
+				this_type temp = *this;
+				inv = IDENTITY();
+
+				for (size_t i = 0; i < ROWS; i++)
+				{
+					size_t max = i;
+
+					for (size_t j = i + 1; j < ROWS; j++)
+					{
+						value_type abs_j = temp.at(j, i) < 0 ? -temp.at(j, i) : temp.at(j, i);
+						value_type abs_max = temp.at(max, i) < 0 ? -temp.at(max, i) : temp.at(max, i);
+
+						if (abs_j > abs_max)
+							max = j;
+					}
+
+					if (temp.at(max, i) == 0)
+						return {};
+
+					if (i != max)
+					{
+						temp = temp.switch_rows(i, max);
+						inv = inv.switch_rows(i, max);
+					}
+
+					const value_type pivot = temp.at(i, i);
+
+					for (size_t c = 0; c < COLS; c++)
+					{
+						temp.at(i, c) /= pivot;
+						inv.at(i, c) /= pivot;
+					}
+
+					for (size_t r = 0; r < ROWS; r++)
+					{
+						if (r == i)
+							continue;
+
+						const value_type q = temp.at(r, i);
+
+						for (size_t c = 0; c < COLS; c++)
+						{
+							temp.at(r, c) -= q * temp.at(i, c);
+							inv.at(r, c) -= q * inv.at(i, c);
+						}
+					}
+				}
+
+				return inv;
+			}
 		}
 
 	public:
-		template<typename = typename std::enable_if_t<IS_SQUARE>>
+		template<bool B = IS_SQUARE, typename = std::enable_if_t<B>>
 		[[nodiscard]] constexpr value_type determinant() const noexcept
 		{
 			return _gaussian_determinant();
 		}
 
-		template<typename = typename std::enable_if_t<(IS_SQUARE && ROWS > 1)>>
+		template<bool B = (IS_SQUARE && ROWS > 1), typename = std::enable_if_t<B>>
 		[[nodiscard]] constexpr this_type minors() const noexcept
 		{
 			this_type m;
@@ -394,7 +493,7 @@ namespace rb::math
 			return m;
 		}
 
-		template<typename = typename std::enable_if_t<(IS_SQUARE && ROWS > 1)>>
+		template<bool B = (IS_SQUARE && ROWS > 1), typename = std::enable_if_t<B>>
 		[[nodiscard]] constexpr this_type cofactors() const noexcept
 		{
 			this_type m = minors();
@@ -405,7 +504,7 @@ namespace rb::math
 			return m;
 		}
 
-		template<typename = typename std::enable_if_t<IS_SQUARE, int>>
+		template<bool B = IS_SQUARE, typename = std::enable_if_t<B, int>>
 		[[nodiscard]] constexpr this_type inverse() const
 		{
 			return _inverse();
@@ -501,6 +600,15 @@ namespace rb::math
 		{
 			matrix<value_type, ROWS, ROWS> m;
 
+			if constexpr (ROWS == COLS && _has_simd_kernel_v<value_type, ROWS>)
+			{
+				if (!rb::intrin::_is_constant_evaluated())
+				{
+					_mul_rows<value_type, ROWS>(data(), rhs.data(), m.data(), ROWS);
+					return m;
+				}
+			}
+
 			for (size_t i = 0; i < ROWS; i++)
 				for (size_t j = 0; j < ROWS; j++)
 					for (size_t k = 0; k < COLS; k++)
@@ -0,0 +1,668 @@
+#pragma once
+
+#include <cstddef>
+
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace rb::math
+{
+	/**
+	 * \brief Whether the SSE/AVX2 matrix kernels are compiled in.
+	 */
+#if defined(__AVX2__)
+	inline constexpr bool MATRIX_SIMD = true;
+#else
+	inline constexpr bool MATRIX_SIMD = false;
+#endif
+
+	/**
+	 * \brief Whether `N` x `N` matrices of `T` have a vectorized kernel.
+	 */
+	template<class T, size_t N>
+	inline constexpr bool _has_simd_kernel_v = MATRIX_SIMD && (std::is_same_v<T, float> || std::is_same_v<T, double>) && (N == 3 || N == 4);
+
+	/**
+	 * \brief Multiplies row vectors by a square matrix, `r = a * b`.
+	 *
+	 * The products are accumulated in the same order as the scalar loops, so both paths yield identical results.
+	 *
+	 * \param a Row-major `rows` x `N` matrix.
+	 * \param b Row-major `N` x `N` matrix.
+	 * \param r Row-major `rows` x `N` result, may alias `a`.
+	 * \param rows Number of rows of `a`.
+	 */
+	template<class T, size_t N>
+	inline void _mul_rows(const T* a, const T* b, T* r, size_t rows) noexcept
+	{
+		for (size_t i = 0; i < rows; i++)
+		{
+			T row[N]{ 0 };
+
+			for (size_t j = 0; j < N; j++)
+				for (size_t k = 0; k < N; k++)
+					row[j] += a[i * N + k] * b[k * N + j];
+
+			for (size_t j = 0; j < N; j++)
+				r[i * N + j] = row[j];
+		}
+	}
+
+	/**
+	 * \brief Transforms points `(x, y, z, 1)` by a 4 x 4 matrix and drops the w component of the results.
+	 *
+	 * \param a Packed `x, y, z` triplets.
+	 * \param m Row-major 4 x 4 matrix.
+	 * \param r Packed results, may alias `a`.
+	 * \param count Number of points.
+	 */
+	template<class T>
+	inline void _transform_points(const T* a, const T* m, T* r, size_t count) noexcept
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			const T x = a[i * 3 + 0];
+			const T y = a[i * 3 + 1];
+			const T z = a[i * 3 + 2];
+
+			for (size_t j = 0; j < 3; j++)
+				r[i * 3 + j] = x * m[j] + y * m[4 + j] + z * m[8 + j] + m[12 + j];
+		}
+	}
+
+	/**
+	 * \brief Structure-of-arrays variant of `_transform_points`.
+	 */
+	template<class T>
+	inline void _transform_points_soa(const T* x, const T* y, const T* z, const T* m, T* rx, T* ry, T* rz, size_t count) noexcept
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			const T px = x[i];
+			const T py = y[i];
+			const T pz = z[i];
+
+			rx[i] = px * m[0] + py * m[4] + pz * m[8] + m[12];
+			ry[i] = px * m[1] + py * m[5] + pz * m[9] + m[13];
+			rz[i] = px * m[2] + py * m[6] + pz * m[10] + m[14];
+		}
+	}
+
+	/**
+	 * \brief Transposes a row-major 4 x 4 matrix, only defined when `_has_simd_kernel_v<T, 4>` holds.
+	 *
+	 * \param r Destination, may alias `a`.
+	 */
+	template<class T>
+	void _transpose4(const T* a, T* r) noexcept;
+
+	/**
+	 * \brief Inverts a row-major 4 x 4 matrix, only defined when `_has_simd_kernel_v<T, 4>` holds.
+	 *
+	 * The matrix is split into 2 x 2 blocks and inverted blockwise, which only needs 2 x 2 adjugates
+	 * and a single division by the determinant.
+	 * https://lxjk.github.io/2017/09/03/Fast-4x4-Matrix-Inverse-with-SSE-SIMD-Explained.html
+	 *
+	 * \param r Destination, may alias `a`.
+	 * \return `false` if the matrix is singular, `r` is left untouched in that case.
+	 */
+	template<class T>
+	bool _inverse4(const T* a, T* r) noexcept;
+
+#if defined(__AVX2__)
+	template<int X, int Y, int Z, int W>
+	inline __m128 _swizzle_ps(__m128 v) noexcept
+	{
+		return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X));
+	}
+
+	/**
+	 * \brief Yields `(a[X], a[Y], b[Z], b[W])`.
+	 */
+	template<int X, int Y, int Z, int W>
+	inline __m128 _shuffle_ps(__m128 a, __m128 b) noexcept
+	{
+		return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+	}
+
+	template<int X, int Y, int Z, int W>
+	inline __m256d _swizzle_pd(__m256d v) noexcept
+	{
+		return _mm256_permute4x64_pd(v, _MM_SHUFFLE(W, Z, Y, X));
+	}
+
+	/**
+	 * \brief Yields `(a[X], a[Y], b[Z], b[W])` for the index pairs used by the blockwise inverse.
+	 */
+	template<int X, int Y, int Z, int W>
+	inline __m256d _shuffle_pd(__m256d a, __m256d b) noexcept
+	{
+		static_assert(X == Z && Y == W && ((X == 0 && Y == 2) || (X == 1 && Y == 3) || (X == 3 && Y == 1) || (X == 2 && Y == 0)), "`_shuffle_pd`: unsupported shuffle");
+
+		if constexpr (X == 0 && Y == 2)
+			return _mm256_permute4x64_pd(_mm256_unpacklo_pd(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+		else if constexpr (X == 1 && Y == 3)
+			return _mm256_permute4x64_pd(_mm256_unpackhi_pd(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+		else if constexpr (X == 3)
+			return _mm256_permute4x64_pd(_mm256_unpackhi_pd(a, b), _MM_SHUFFLE(1, 3, 0, 2));
+		else
+			return _mm256_permute4x64_pd(_mm256_unpacklo_pd(a, b), _MM_SHUFFLE(1, 3, 0, 2));
+	}
+
+	// 2 x 2 blocks are stored row-major in a single register: | v0 v1 |
+	//                                                         | v2 v3 |
+
+	/**
+	 * \brief 2 x 2 matrix product `a * b`.
+	 */
+	inline __m128 _mat2_mul(__m128 a, __m128 b) noexcept
+	{
+		return _mm_add_ps(_mm_mul_ps(a, _swizzle_ps<0, 3, 0, 3>(b)), _mm_mul_ps(_swizzle_ps<1, 0, 3, 2>(a), _swizzle_ps<2, 1, 2, 1>(b)));
+	}
+
+	/**
+	 * \brief 2 x 2 matrix product `adj(a) * b`.
+	 */
+	inline __m128 _mat2_adj_mul(__m128 a, __m128 b) noexcept
+	{
+		return _mm_sub_ps(_mm_mul_ps(_swizzle_ps<3, 3, 0, 0>(a), b), _mm_mul_ps(_swizzle_ps<1, 1, 2, 2>(a), _swizzle_ps<2, 3, 0, 1>(b)));
+	}
+
+	/**
+	 * \brief 2 x 2 matrix product `a * adj(b)`.
+	 */
+	inline __m128 _mat2_mul_adj(__m128 a, __m128 b) noexcept
+	{
+		return _mm_sub_ps(_mm_mul_ps(a, _swizzle_ps<3, 0, 3, 0>(b)), _mm_mul_ps(_swizzle_ps<1, 0, 3, 2>(a), _swizzle_ps<2, 1, 2, 1>(b)));
+	}
+
+	inline __m256d _mat2_mul(__m256d a, __m256d b) noexcept
+	{
+		return _mm256_add_pd(_mm256_mul_pd(a, _swizzle_pd<0, 3, 0, 3>(b)), _mm256_mul_pd(_swizzle_pd<1, 0, 3, 2>(a), _swizzle_pd<2, 1, 2, 1>(b)));
+	}
+
+	inline __m256d _mat2_adj_mul(__m256d a, __m256d b) noexcept
+	{
+		return _mm256_sub_pd(_mm256_mul_pd(_swizzle_pd<3, 3, 0, 0>(a), b), _mm256_mul_pd(_swizzle_pd<1, 1, 2, 2>(a), _swizzle_pd<2, 3, 0, 1>(b)));
+	}
+
+	inline __m256d _mat2_mul_adj(__m256d a, __m256d b) noexcept
+	{
+		return _mm256_sub_pd(_mm256_mul_pd(a, _swizzle_pd<3, 0, 3, 0>(b)), _mm256_mul_pd(_swizzle_pd<1, 0, 3, 2>(a), _swizzle_pd<2, 1, 2, 1>(b)));
+	}
+
+	/**
+	 * \brief Stores the lower three lanes of `v` to `p`.
+	 */
+	inline void _store3(float* p, __m128 v) noexcept
+	{
+		_mm_storel_pi(reinterpret_cast<__m64*>(p), v);
+		_mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+	}
+
+	inline void _store3(double* p, __m256d v) noexcept
+	{
+		_mm_storeu_pd(p, _mm256_castpd256_pd128(v));
+		_mm_store_sd(p + 2, _mm256_extractf128_pd(v, 1));
+	}
+
+	/**
+	 * \brief Packs the lower three lanes of four vectors into 12 consecutive elements at `p`.
+	 *
+	 * Masked stores are slow, so the triplets are merged into three full width stores instead.
+	 */
+	inline void _store3x4(float* p, __m128 v0, __m128 v1, __m128 v2, __m128 v3) noexcept
+	{
+		_mm_storeu_ps(p + 0, _mm_blend_ps(v0, _mm_permute_ps(v1, _MM_SHUFFLE(0, 0, 0, 0)), 0x8));
+		_mm_storeu_ps(p + 4, _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(1, 0, 2, 1)));
+		_mm_storeu_ps(p + 8, _mm_blend_ps(_mm_permute_ps(v3, _MM_SHUFFLE(2, 1, 0, 0)), _mm_permute_ps(v2, _MM_SHUFFLE(2, 2, 2, 2)), 0x1));
+	}
+
+	inline void _store3x4(double* p, __m256d v0, __m256d v1, __m256d v2, __m256d v3) noexcept
+	{
+		_mm256_storeu_pd(p + 0, _mm256_blend_pd(v0, _mm256_permute4x64_pd(v1, _MM_SHUFFLE(0, 0, 0, 0)), 0x8));
+		_mm256_storeu_pd(p + 4, _mm256_blend_pd(_mm256_permute4x64_pd(v1, _MM_SHUFFLE(0, 0, 2, 1)), _mm256_permute4x64_pd(v2, _MM_SHUFFLE(1, 0, 0, 0)), 0xC));
+		_mm256_storeu_pd(p + 8, _mm256_blend_pd(_mm256_permute4x64_pd(v3, _MM_SHUFFLE(2, 1, 0, 0)), _mm256_permute4x64_pd(v2, _MM_SHUFFLE(2, 2, 2, 2)), 0x1));
+	}
+
+	template<>
+	inline void _mul_rows<float, 4>(const float* a, const float* b, float* r, size_t rows) noexcept
+	{
+		// Every 128-bit lane holds one row of `b`
+		const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 0));
+		const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 4));
+		const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 8));
+		const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 12));
+
+		size_t i = 0;
+
+		// Two rows per iteration
+		for (; i + 2 <= rows; i += 2)
+		{
+			const __m256 v = _mm256_loadu_ps(a + i * 4);
+
+			__m256 acc = _mm256_mul_ps(_mm256_permute_ps(v, 0x00), b0);
+			acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_permute_ps(v, 0x55), b1));
+			acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_permute_ps(v, 0xAA), b2));
+			acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_permute_ps(v, 0xFF), b3));
+
+			_mm256_storeu_ps(r + i * 4, acc);
+		}
+
+		if (i < rows)
+		{
+			const __m128 v = _mm_loadu_ps(a + i * 4);
+
+			__m128 acc = _mm_mul_ps(_mm_permute_ps(v, 0x00), _mm256_castps256_ps128(b0));
+			acc = _mm_add_ps(acc, _mm_mul_ps(_mm_permute_ps(v, 0x55), _mm256_castps256_ps128(b1)));
+			acc = _mm_add_ps(acc, _mm_mul_ps(_mm_permute_ps(v, 0xAA), _mm256_castps256_ps128(b2)));
+			acc = _mm_add_ps(acc, _mm_mul_ps(_mm_permute_ps(v, 0xFF), _mm256_castps256_ps128(b3)));
+
+			_mm_storeu_ps(r + i * 4, acc);
+		}
+	}
+
+	template<>
+	inline void _mul_rows<double, 4>(const double* a, const double* b, double* r, size_t rows) noexcept
+	{
+		const __m256d b0 = _mm256_loadu_pd(b + 0);
+		const __m256d b1 = _mm256_loadu_pd(b + 4);
+		const __m256d b2 = _mm256_loadu_pd(b + 8);
+		const __m256d b3 = _mm256_loadu_pd(b + 12);
+
+		for (size_t i = 0; i < rows; i++)
+		{
+			const double* v = a + i * 4;
+
+			__m256d acc = _mm256_mul_pd(_mm256_broadcast_sd(v + 0), b0);
+			acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_broadcast_sd(v + 1), b1));
+			acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_broadcast_sd(v + 2), b2));
+			acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_broadcast_sd(v + 3), b3));
+
+			_mm256_storeu_pd(r + i * 4, acc);
+		}
+	}
+
+	template<>
+	inline void _mul_rows<float, 3>(const float* a, const float* b, float* r, size_t rows) noexcept
+	{
+		const __m128i mask = _mm_setr_epi32(-1, -1, -1, 0);
+
+		const __m128 b0 = _mm_maskload_ps(b + 0, mask);
+		const __m128 b1 = _mm_maskload_ps(b + 3, mask);
+		const __m128 b2 = _mm_maskload_ps(b + 6, mask);
+
+		const auto row = [&](const float* v) noexcept
+		{
+			__m128 acc = _mm_mul_ps(_mm_broadcast_ss(v + 0), b0);
+			acc = _mm_add_ps(acc, _mm_mul_ps(_mm_broadcast_ss(v + 1), b1));
+			return _mm_add_ps(acc, _mm_mul_ps(_mm_broadcast_ss(v + 2), b2));
+		};
+
+		size_t i = 0;
+
+		// Four rows per iteration, all of them are loaded before anything is stored so that `r` may alias `a`
+		for (; i + 4 <= rows; i += 4)
+		{
+			const __m128 r0 = row(a + i * 3 + 0);
+			const __m128 r1 = row(a + i * 3 + 3);
+			const __m128 r2 = row(a + i * 3 + 6);
+			const __m128 r3 = row(a + i * 3 + 9);
+
+			_store3x4(r + i * 3, r0, r1, r2, r3);
+		}
+
+		for (; i < rows; i++)
+			_store3(r + i * 3, row(a + i * 3));
+	}
+
+	template<>
+	inline void _mul_rows<double, 3>(const double* a, const double* b, double* r, size_t rows) noexcept
+	{
+		const __m256i mask = _mm256_setr_epi64x(-1, -1, -1, 0);
+
+		const __m256d b0 = _mm256_maskload_pd(b + 0, mask);
+		const __m256d b1 = _mm256_maskload_pd(b + 3, mask);
+		const __m256d b2 = _mm256_maskload_pd(b + 6, mask);
+
+		const auto row = [&](const double* v) noexcept
+		{
+			__m256d acc = _mm256_mul_pd(_mm256_broadcast_sd(v + 0), b0);
+			acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_broadcast_sd(v + 1), b1));
+			return _mm256_add_pd(acc, _mm256_mul_pd(_mm256_broadcast_sd(v + 2), b2));
+		};
+
+		size_t i = 0;
+
+		// Four rows per iteration, all of them are loaded before anything is stored so that `r` may alias `a`
+		for (; i + 4 <= rows; i += 4)
+		{
+			const __m256d r0 = row(a + i * 3 + 0);
+			const __m256d r1 = row(a + i * 3 + 3);
+			const __m256d r2 = row(a + i * 3 + 6);
+			const __m256d r3 = row(a + i * 3 + 9);
+
+			_store3x4(r + i * 3, r0, r1, r2, r3);
+		}
+
+		for (; i < rows; i++)
+			_store3(r + i * 3, row(a + i * 3));
+	}
+
+	template<>
+	inline void _transform_points<float>(const float* a, const float* m, float* r, size_t count) noexcept
+	{
+		const __m128 m0 = _mm_loadu_ps(m + 0);
+		const __m128 m1 = _mm_loadu_ps(m + 4);
+		const __m128 m2 = _mm_loadu_ps(m + 8);
+		const __m128 m3 = _mm_loadu_ps(m + 12);
+
+		const auto point = [&](const float* v) noexcept
+		{
+			__m128 acc = _mm_mul_ps(_mm_broadcast_ss(v + 0), m0);
+			acc = _mm_add_ps(acc, _mm_mul_ps(_mm_broadcast_ss(v + 1), m1));
+			acc = _mm_add_ps(acc, _mm_mul_ps(_mm_broadcast_ss(v + 2), m2));
+			return _mm_add_ps(acc, m3);
+		};
+
+		size_t i = 0;
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 p0 = point(a + i * 3 + 0);
+			const __m128 p1 = point(a + i * 3 + 3);
+			const __m128 p2 = point(a + i * 3 + 6);
+			const __m128 p3 = point(a + i * 3 + 9);
+
+			_store3x4(r + i * 3, p0, p1, p2, p3);
+		}
+
+		// Counting down lets the compiler bound the loop when `count` is a constant
+		a += i * 3;
+		r += i * 3;
+
+		for (size_t n = count - i; n > 0; n--, a += 3, r += 3)
+			_store3(r, point(a));
+	}
+
+	template<>
+	inline void _transform_points<double>(const double* a, const double* m, double* r, size_t count) noexcept
+	{
+		const __m256d m0 = _mm256_loadu_pd(m + 0);
+		const __m256d m1 = _mm256_loadu_pd(m + 4);
+		const __m256d m2 = _mm256_loadu_pd(m + 8);
+		const __m256d m3 = _mm256_loadu_pd(m + 12);
+
+		const auto point = [&](const double* v) noexcept
+		{
+			__m256d acc = _mm256_mul_pd(_mm256_broadcast_sd(v + 0), m0);
+			acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_broadcast_sd(v + 1), m1));
+			acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_broadcast_sd(v + 2), m2));
+			return _mm256_add_pd(acc, m3);
+		};
+
+		size_t i = 0;
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m256d p0 = point(a + i * 3 + 0);
+			const __m256d p1 = point(a + i * 3 + 3);
+			const __m256d p2 = point(a + i * 3 + 6);
+			const __m256d p3 = point(a + i * 3 + 9);
+
+			_store3x4(r + i * 3, p0, p1, p2, p3);
+		}
+
+		// Counting down lets the compiler bound the loop when `count` is a constant
+		a += i * 3;
+		r += i * 3;
+
+		for (size_t n = count - i; n > 0; n--, a += 3, r += 3)
+			_store3(r, point(a));
+	}
+
+	template<>
+	inline void _transform_points_soa<float>(const float* x, const float* y, const float* z, const float* m, float* rx, float* ry, float* rz, size_t count) noexcept
+	{
+		__m256 c[4][3];
+
+		for (size_t j = 0; j < 4; j++)
+			for (size_t k = 0; k < 3; k++)
+				c[j][k] = _mm256_set1_ps(m[j * 4 + k]);
+
+		size_t i = 0;
+
+		// Eight points per iteration, every lane transforms one point
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m256 px = _mm256_loadu_ps(x + i);
+			const __m256 py = _mm256_loadu_ps(y + i);
+			const __m256 pz = _mm256_loadu_ps(z + i);
+
+			float* out[3] = { rx, ry, rz };
+
+			for (size_t k = 0; k < 3; k++)
+			{
+				__m256 acc = _mm256_mul_ps(px, c[0][k]);
+				acc = _mm256_add_ps(acc, _mm256_mul_ps(py, c[1][k]));
+				acc = _mm256_add_ps(acc, _mm256_mul_ps(pz, c[2][k]));
+				acc = _mm256_add_ps(acc, c[3][k]);
+
+				_mm256_storeu_ps(out[k] + i, acc);
+			}
+		}
+
+		// Counting down lets the compiler bound the loop when `count` is a constant
+		for (size_t n = count - i; n > 0; n--, i++)
+		{
+			const float px = x[i];
+			const float py = y[i];
+			const float pz = z[i];
+
+			rx[i] = px * m[0] + py * m[4] + pz * m[8] + m[12];
+			ry[i] = px * m[1] + py * m[5] + pz * m[9] + m[13];
+			rz[i] = px * m[2] + py * m[6] + pz * m[10] + m[14];
+		}
+	}
+
+	template<>
+	inline void _transform_points_soa<double>(const double* x, const double* y, const double* z, const double* m, double* rx, double* ry, double* rz, size_t count) noexcept
+	{
+		__m256d c[4][3];
+
+		for (size_t j = 0; j < 4; j++)
+			for (size_t k = 0; k < 3; k++)
+				c[j][k] = _mm256_set1_pd(m[j * 4 + k]);
+
+		size_t i = 0;
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m256d px = _mm256_loadu_pd(x + i);
+			const __m256d py = _mm256_loadu_pd(y + i);
+			const __m256d pz = _mm256_loadu_pd(z + i);
+
+			double* out[3] = { rx, ry, rz };
+
+			for (size_t k = 0; k < 3; k++)
+			{
+				__m256d acc = _mm256_mul_pd(px, c[0][k]);
+				acc = _mm256_add_pd(acc, _mm256_mul_pd(py, c[1][k]));
+				acc = _mm256_add_pd(acc, _mm256_mul_pd(pz, c[2][k]));
+				acc = _mm256_add_pd(acc, c[3][k]);
+
+				_mm256_storeu_pd(out[k] + i, acc);
+			}
+		}
+
+		// Counting down lets the compiler bound the loop when `count` is a constant
+		for (size_t n = count - i; n > 0; n--, i++)
+		{
+			const double px = x[i];
+			const double py = y[i];
+			const double pz = z[i];
+
+			rx[i] = px * m[0] + py * m[4] + pz * m[8] + m[12];
+			ry[i] = px * m[1] + py * m[5] + pz * m[9] + m[13];
+			rz[i] = px * m[2] + py * m[6] + pz * m[10] + m[14];
+		}
+	}
+
+	template<>
+	inline void _transpose4<float>(const float* a, float* r) noexcept
+	{
+		__m128 r0 = _mm_loadu_ps(a + 0);
+		__m128 r1 = _mm_loadu_ps(a + 4);
+		__m128 r2 = _mm_loadu_ps(a + 8);
+		__m128 r3 = _mm_loadu_ps(a + 12);
+
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+		_mm_storeu_ps(r + 0, r0);
+		_mm_storeu_ps(r + 4, r1);
+		_mm_storeu_ps(r + 8, r2);
+		_mm_storeu_ps(r + 12, r3);
+	}
+
+	template<>
+	inline void _transpose4<double>(const double* a, double* r) noexcept
+	{
+		const __m256d r0 = _mm256_loadu_pd(a + 0);
+		const __m256d r1 = _mm256_loadu_pd(a + 4);
+		const __m256d r2 = _mm256_loadu_pd(a + 8);
+		const __m256d r3 = _mm256_loadu_pd(a + 12);
+
+		const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+		const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+		const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+		const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+
+		_mm256_storeu_pd(r + 0, _mm256_permute2f128_pd(t0, t2, 0x20));
+		_mm256_storeu_pd(r + 4, _mm256_permute2f128_pd(t1, t3, 0x20));
+		_mm256_storeu_pd(r + 8, _mm256_permute2f128_pd(t0, t2, 0x31));
+		_mm256_storeu_pd(r + 12, _mm256_permute2f128_pd(t1, t3, 0x31));
+	}
+
+	template<>
+	inline bool _inverse4<float>(const float* a, float* r) noexcept
+	{
+		const __m128 r0 = _mm_loadu_ps(a + 0);
+		const __m128 r1 = _mm_loadu_ps(a + 4);
+		const __m128 r2 = _mm_loadu_ps(a + 8);
+		const __m128 r3 = _mm_loadu_ps(a + 12);
+
+		// | A B |
+		// | C D |
+		const __m128 A = _mm_movelh_ps(r0, r1);
+		const __m128 B = _mm_movehl_ps(r1, r0);
+		const __m128 C = _mm_movelh_ps(r2, r3);
+		const __m128 D = _mm_movehl_ps(r3, r2);
+
+		// (|A|, |B|, |C|, |D|)
+		const __m128 det_sub = _mm_sub_ps(
+			_mm_mul_ps(_shuffle_ps<0, 2, 0, 2>(r0, r2), _shuffle_ps<1, 3, 1, 3>(r1, r3)),
+			_mm_mul_ps(_shuffle_ps<1, 3, 1, 3>(r0, r2), _shuffle_ps<0, 2, 0, 2>(r1, r3)));
+
+		const __m128 det_a = _swizzle_ps<0, 0, 0, 0>(det_sub);
+		const __m128 det_b = _swizzle_ps<1, 1, 1, 1>(det_sub);
+		const __m128 det_c = _swizzle_ps<2, 2, 2, 2>(det_sub);
+		const __m128 det_d = _swizzle_ps<3, 3, 3, 3>(det_sub);
+
+		const __m128 d_c = _mat2_adj_mul(D, C);
+		const __m128 a_b = _mat2_adj_mul(A, B);
+
+		// Adjugates of the blocks of the inverse scaled by |M|
+		__m128 x = _mm_sub_ps(_mm_mul_ps(det_d, A), _mat2_mul(B, d_c));
+		__m128 w = _mm_sub_ps(_mm_mul_ps(det_a, D), _mat2_mul(C, a_b));
+		__m128 y = _mm_sub_ps(_mm_mul_ps(det_b, C), _mat2_mul_adj(D, a_b));
+		__m128 z = _mm_sub_ps(_mm_mul_ps(det_c, B), _mat2_mul_adj(A, d_c));
+
+		// |M| = |A| |D| + |B| |C| - tr(adj(A) B adj(D) C)
+		__m128 tr = _mm_mul_ps(a_b, _swizzle_ps<0, 2, 1, 3>(d_c));
+		tr = _mm_hadd_ps(tr, tr);
+		tr = _mm_hadd_ps(tr, tr);
+
+		const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c)), tr);
+
+		if (_mm_cvtss_f32(det) == 0.0f)
+			return false;
+
+		const __m128 rdet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+
+		x = _mm_mul_ps(x, rdet);
+		y = _mm_mul_ps(y, rdet);
+		z = _mm_mul_ps(z, rdet);
+		w = _mm_mul_ps(w, rdet);
+
+		// The shuffles apply the final 2 x 2 adjugates
+		_mm_storeu_ps(r + 0, _shuffle_ps<3, 1, 3, 1>(x, y));
+		_mm_storeu_ps(r + 4, _shuffle_ps<2, 0, 2, 0>(x, y));
+		_mm_storeu_ps(r + 8, _shuffle_ps<3, 1, 3, 1>(z, w));
+		_mm_storeu_ps(r + 12, _shuffle_ps<2, 0, 2, 0>(z, w));
+
+		return true;
+	}
+
+	template<>
+	inline bool _inverse4<double>(const double* a, double* r) noexcept
+	{
+		const __m256d r0 = _mm256_loadu_pd(a + 0);
+		const __m256d r1 = _mm256_loadu_pd(a + 4);
+		const __m256d r2 = _mm256_loadu_pd(a + 8);
+		const __m256d r3 = _mm256_loadu_pd(a + 12);
+
+		// | A B |
+		// | C D |
+		const __m256d A = _mm256_permute2f128_pd(r0, r1, 0x20);
+		const __m256d B = _mm256_permute2f128_pd(r0, r1, 0x31);
+		const __m256d C = _mm256_permute2f128_pd(r2, r3, 0x20);
+		const __m256d D = _mm256_permute2f128_pd(r2, r3, 0x31);
+
+		// (|A|, |B|, |C|, |D|)
+		const __m256d det_sub = _mm256_sub_pd(
+			_mm256_mul_pd(_shuffle_pd<0, 2, 0, 2>(r0, r2), _shuffle_pd<1, 3, 1, 3>(r1, r3)),
+			_mm256_mul_pd(_shuffle_pd<1, 3, 1, 3>(r0, r2), _shuffle_pd<0, 2, 0, 2>(r1, r3)));
+
+		const __m256d det_a = _swizzle_pd<0, 0, 0, 0>(det_sub);
+		const __m256d det_b = _swizzle_pd<1, 1, 1, 1>(det_sub);
+		const __m256d det_c = _swizzle_pd<2, 2, 2, 2>(det_sub);
+		const __m256d det_d = _swizzle_pd<3, 3, 3, 3>(det_sub);
+
+		const __m256d d_c = _mat2_adj_mul(D, C);
+		const __m256d a_b = _mat2_adj_mul(A, B);
+
+		__m256d x = _mm256_sub_pd(_mm256_mul_pd(det_d, A), _mat2_mul(B, d_c));
+		__m256d w = _mm256_sub_pd(_mm256_mul_pd(det_a, D), _mat2_mul(C, a_b));
+		__m256d y = _mm256_sub_pd(_mm256_mul_pd(det_b, C), _mat2_mul_adj(D, a_b));
+		__m256d z = _mm256_sub_pd(_mm256_mul_pd(det_c, B), _mat2_mul_adj(A, d_c));
+
+		__m256d tr = _mm256_mul_pd(a_b, _swizzle_pd<0, 2, 1, 3>(d_c));
+		tr = _mm256_hadd_pd(tr, tr);
+		tr = _mm256_add_pd(tr, _mm256_permute2f128_pd(tr, tr, 0x01));
+
+		const __m256d det = _mm256_sub_pd(_mm256_add_pd(_mm256_mul_pd(det_a, det_d), _mm256_mul_pd(det_b, det_c)), tr);
+
+		if (_mm256_cvtsd_f64(det) == 0.0)
+			return false;
+
+		const __m256d rdet = _mm256_div_pd(_mm256_setr_pd(1.0, -1.0, -1.0, 1.0), det);
+
+		x = _mm256_mul_pd(x, rdet);
+		y = _mm256_mul_pd(y, rdet);
+		z = _mm256_mul_pd(z, rdet);
+		w = _mm256_mul_pd(w, rdet);
+
+		_mm256_storeu_pd(r + 0, _shuffle_pd<3, 1, 3, 1>(x, y));
+		_mm256_storeu_pd(r + 4, _shuffle_pd<2, 0, 2, 0>(x, y));
+		_mm256_storeu_pd(r + 8, _shuffle_pd<3, 1, 3, 1>(z, w));
+		_mm256_storeu_pd(r + 12, _shuffle_pd<2, 0, 2, 0>(z, w));
+
+		return true;
+	}
+#endif
+}
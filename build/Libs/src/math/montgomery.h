@@ -0,0 +1,228 @@
+#pragma once
+
+#include <array>
+
+#include <cstdint>
+
+#include "math/limb.h"
+
+namespace rb::math
+{
+	// Arithmetic modulo an odd number in Montgomery representation
+	// https://en.wikipedia.org/wiki/Montgomery_modular_multiplication
+	template<size_t L>
+	class montgomery_field
+	{
+	public:
+		static inline constexpr size_t LIMB_SIZE = L;
+
+		using element_type = std::array<uint64_t, LIMB_SIZE>;
+
+	public:
+		constexpr montgomery_field() noexcept
+			: m_modulus{ 0 }, m_one{ 0 }, m_r2{ 0 }, m_inv(0)
+		{
+		}
+
+		explicit constexpr montgomery_field(const element_type& modulus) noexcept
+			: m_modulus(modulus), m_one{ 0 }, m_r2{ 0 }, m_inv(0)
+		{
+			// -m^-1 mod 2^64 using Newton's iteration, every step doubles the number of correct bits
+			uint64_t inv = modulus[0];
+
+			for (size_t i = 0; i < 5; i++)
+				inv *= 2 - modulus[0] * inv;
+
+			m_inv = 0 - inv;
+
+			// R mod m and R^2 mod m, where R = 2^(64 * L)
+			const size_t n = _limbs_size(modulus.data(), LIMB_SIZE);
+
+			std::array<uint64_t, 2 * LIMB_SIZE + 1> u{ 0 };
+			std::array<uint64_t, 2 * LIMB_SIZE + 1> q{ 0 };
+			std::array<uint64_t, 3 * LIMB_SIZE + 2> scratch{ 0 };
+
+			u[LIMB_SIZE] = 1;
+			_limbs_divmod(q.data(), m_one.data(), u.data(), LIMB_SIZE + 1, modulus.data(), n, scratch.data());
+
+			u[LIMB_SIZE] = 0;
+			u[2 * LIMB_SIZE] = 1;
+			_limbs_divmod(q.data(), m_r2.data(), u.data(), 2 * LIMB_SIZE + 1, modulus.data(), n, scratch.data());
+		}
+
+	private:
+		// Returns t - m if t >= m and t otherwise, where t has an extra carry limb
+		[[nodiscard]] constexpr element_type _reduce(const uint64_t* t, uint64_t t_hi) const noexcept
+		{
+			element_type result{ 0 }, diff{ 0 };
+			uint8_t borrow = 0;
+
+			for (size_t i = 0; i < LIMB_SIZE; i++)
+				borrow = _subborrow(borrow, t[i], m_modulus[i], diff[i]);
+
+			uint64_t unused = 0;
+			borrow = _subborrow(borrow, t_hi, 0, unused);
+
+			const uint64_t mask = 0 - static_cast<uint64_t>(borrow);
+
+			for (size_t i = 0; i < LIMB_SIZE; i++)
+				result[i] = (t[i] & mask) | (diff[i] & ~mask);
+
+			return result;
+		}
+
+	public:
+		[[nodiscard]] constexpr const element_type& modulus() const noexcept
+		{
+			return m_modulus;
+		}
+
+		// Montgomery representation of 1
+		[[nodiscard]] constexpr const element_type& one() const noexcept
+		{
+			return m_one;
+		}
+
+		[[nodiscard]] static constexpr bool is_zero(const element_type& a) noexcept
+		{
+			uint64_t acc = 0;
+
+			for (size_t i = 0; i < LIMB_SIZE; i++)
+				acc |= a[i];
+
+			return acc == 0;
+		}
+
+	public:
+		// Accepts any value below 2^(64 * L)
+		[[nodiscard]] constexpr element_type to_montgomery(const element_type& a) const noexcept
+		{
+			return mul(a, m_r2);
+		}
+
+		[[nodiscard]] constexpr element_type from_montgomery(const element_type& a) const noexcept
+		{
+			element_type unit{ 0 };
+			unit[0] = 1;
+
+			return mul(a, unit);
+		}
+
+		[[nodiscard]] constexpr element_type add(const element_type& a, const element_type& b) const noexcept
+		{
+			element_type sum{ 0 };
+			uint8_t carry = 0;
+
+			for (size_t i = 0; i < LIMB_SIZE; i++)
+				carry = _addcarry(carry, a[i], b[i], sum[i]);
+
+			return _reduce(sum.data(), carry);
+		}
+
+		[[nodiscard]] constexpr element_type sub(const element_type& a, const element_type& b) const noexcept
+		{
+			element_type diff{ 0 };
+			uint8_t borrow = 0;
+
+			for (size_t i = 0; i < LIMB_SIZE; i++)
+				borrow = _subborrow(borrow, a[i], b[i], diff[i]);
+
+			// Add the modulus back if the difference is negative
+			const uint64_t mask = 0 - static_cast<uint64_t>(borrow);
+			uint8_t carry = 0;
+
+			for (size_t i = 0; i < LIMB_SIZE; i++)
+				carry = _addcarry(carry, diff[i], m_modulus[i] & mask, diff[i]);
+
+			return diff;
+		}
+
+		[[nodiscard]] constexpr element_type neg(const element_type& a) const noexcept
+		{
+			return sub(element_type{ 0 }, a);
+		}
+
+		// Coarsely Integrated Operand Scanning (CIOS) Montgomery multiplication
+		// https://www.microsoft.com/en-us/research/wp-content/uploads/1996/01/j37acmon.pdf
+		[[nodiscard]] constexpr element_type mul(const element_type& a, const element_type& b) const noexcept
+		{
+			uint64_t t[LIMB_SIZE + 2] = { 0 };
+
+			for (size_t i = 0; i < LIMB_SIZE; i++)
+			{
+				uint64_t carry = 0;
+
+				for (size_t j = 0; j < LIMB_SIZE; j++)
+					t[j] = _muladd(a[j], b[i], t[j], carry, carry);
+
+				t[LIMB_SIZE + 1] = _addcarry(0, t[LIMB_SIZE], carry, t[LIMB_SIZE]);
+
+				// Add a multiple of the modulus which clears the lowest limb and shift it out
+				const uint64_t u = t[0] * m_inv;
+
+				_muladd(u, m_modulus[0], t[0], 0, carry);
+
+				for (size_t j = 1; j < LIMB_SIZE; j++)
+					t[j - 1] = _muladd(u, m_modulus[j], t[j], carry, carry);
+
+				const uint8_t c = _addcarry(0, t[LIMB_SIZE], carry, t[LIMB_SIZE - 1]);
+				t[LIMB_SIZE] = t[LIMB_SIZE + 1] + c;
+			}
+
+			return _reduce(t, t[LIMB_SIZE]);
+		}
+
+		[[nodiscard]] constexpr element_type sqr(const element_type& a) const noexcept
+		{
+			return mul(a, a);
+		}
+
+		// Fixed 4-bit window exponentiation, `e` is a regular (non-Montgomery) integer
+		[[nodiscard]] constexpr element_type pow(const element_type& a, const element_type& e) const noexcept
+		{
+			element_type table[16]{};
+			table[0] = m_one;
+
+			for (size_t i = 1; i < 16; i++)
+				table[i] = mul(table[i - 1], a);
+
+			element_type result = m_one;
+			bool started = false;
+
+			for (size_t i = LIMB_SIZE * 16; i-- > 0;)
+			{
+				const uint64_t digit = (e[i / 16] >> (i % 16 * 4)) & 0xF;
+
+				if (started)
+					for (size_t j = 0; j < 4; j++)
+						result = sqr(result);
+
+				if (digit != 0)
+				{
+					result = mul(result, table[digit]);
+					started = true;
+				}
+			}
+
+			return result;
+		}
+
+		// Inverse using Fermat's little theorem, requires a prime modulus
+		[[nodiscard]] constexpr element_type inverse(const element_type& a) const noexcept
+		{
+			element_type e = m_modulus;
+			element_type two{ 0 };
+			two[0] = 2;
+
+			_limbs_sub(e.data(), e.data(), LIMB_SIZE, two.data(), LIMB_SIZE);
+
+			return pow(a, e);
+		}
+
+	private:
+		element_type m_modulus;
+		element_type m_one;
+		element_type m_r2;
+		uint64_t m_inv;
+	};
+}
@@ -13,6 +13,12 @@ namespace rb::math
 	{
 		vector<T, C> v;
 
+		if constexpr (S == C && _has_simd_kernel_v<T, S>)
+		{
+			_mul_rows<T, S>(lhs.data(), rhs.data(), v.data(), 1);
+			return v;
+		}
+
 		for (size_t i = 0; i < C; i++)
 			for (size_t j = 0; j < S; j++)
 				v[i] += lhs[j] * rhs.at(j, i);
@@ -23,7 +29,7 @@ namespace rb::math
 	template<class T, size_t S>
 	[[nodiscard]] matrix<T, S, S> translate(const matrix<T, S, S>& m, const vector<T, S>& v) noexcept
 	{
-		matrix<T, S, S> _m = matrix<T, S, S>::make_identity();
+		matrix<T, S, S> _m = matrix<T, S, S>::IDENTITY();
 
 		for (size_t i = 0; i < S - 1; i++)
 			_m.at(S - 1, i) = v[i];
@@ -57,8 +63,8 @@ namespace rb::math
 	[[nodiscard]] mat3<T> rotate(const mat3<T>& m, T t) noexcept
 	{
 		return m * mat3<T>{
-			std::cosf(t), -std::sinf(t), 0,
-			std::sinf(t), std::cosf(t), 0,
+			std::cos(t), -std::sin(t), 0,
+			std::sin(t), std::cos(t), 0,
 			0, 0, 1
 		};
 	}
@@ -67,9 +73,9 @@ namespace rb::math
 	[[nodiscard]] mat4<T> rotate(const mat4<T>& m, const vec4<T>& v, T t) noexcept
 	{
 		return m * mat4<T>{
-			v[0] * v[0] * (1 - std::cosf(t)) + std::cosf(t), v[1] * v[0] * (1 - std::cosf(t)) - v[2] * std::sinf(t), v[2] * v[0] * (1 - std::cosf(t)) + v[1] * std::sinf(t), 0,
-			v[0] * v[1] * (1 - std::cosf(t)) + v[2] * std::sinf(t), v[1] * v[1] * (1 - std::cosf(t)) + std::cosf(t), v[2] * v[1] * (1 - std::cosf(t)) - v[0] * std::sinf(t), 0,
-			v[0] * v[2] * (1 - std::cosf(t)) - v[1] * std::sinf(t), v[1] * v[2] * (1 - std::cosf(t)) + v[0] * std::sinf(t), v[2] * v[2] * (1 - std::cosf(t)) + std::cosf(t), 0,
+			v[0] * v[0] * (1 - std::cos(t)) + std::cos(t), v[1] * v[0] * (1 - std::cos(t)) - v[2] * std::sin(t), v[2] * v[0] * (1 - std::cos(t)) + v[1] * std::sin(t), 0,
+			v[0] * v[1] * (1 - std::cos(t)) + v[2] * std::sin(t), v[1] * v[1] * (1 - std::cos(t)) + std::cos(t), v[2] * v[1] * (1 - std::cos(t)) - v[0] * std::sin(t), 0,
+			v[0] * v[2] * (1 - std::cos(t)) - v[1] * std::sin(t), v[1] * v[2] * (1 - std::cos(t)) + v[0] * std::sin(t), v[2] * v[2] * (1 - std::cos(t)) + std::cos(t), 0,
 			0, 0, 0, 1
 		};
 	}
@@ -79,8 +85,8 @@ namespace rb::math
 	{
 		return m * mat4<T>{
 			1, 0, 0, 0,
-			0, std::cosf(t), -std::sinf(t), 0,
-			0, std::sinf(t), std::cosf(t), 0,
+			0, std::cos(t), -std::sin(t), 0,
+			0, std::sin(t), std::cos(t), 0,
 			0, 0, 0, 1
 		};
 	}
@@ -89,9 +95,9 @@ namespace rb::math
 	[[nodiscard]] mat4<T> rotate_y(const mat4<T>& m, T t) noexcept
 	{
 		return m * mat4<T>{
-			std::cosf(t), 0, std::sinf(t), 0,
+			std::cos(t), 0, std::sin(t), 0,
 			0, 1, 0, 0,
-			-std::sinf(t), 0, std::cosf(t), 0,
+			-std::sin(t), 0, std::cos(t), 0,
 			0, 0, 0, 1
 		};
 	}
@@ -100,8 +106,8 @@ namespace rb::math
 	[[nodiscard]] mat4<T> rotate_z(const mat4<T>& m, T t) noexcept
 	{
 		return m * mat4<T>{
-			std::cosf(t), -std::sinf(t), 0, 0,
-			std::sinf(t), std::cosf(t), 0, 0,
+			std::cos(t), -std::sin(t), 0, 0,
+			std::sin(t), std::cos(t), 0, 0,
 			0, 0, 1, 0,
 			0, 0, 0, 1
 		};
@@ -110,7 +116,7 @@ namespace rb::math
 	template<class T>
 	[[nodiscard]] mat4<T> perspective(const mat4<T>& m, T width, T height, T far, T near, T fov) noexcept
 	{
-		const T s = 1.0f / std::tanf(fov / 2.0f);
+		const T s = 1.0f / std::tan(fov / 2.0f);
 
 		return m * mat4<T>{
 			height / width * s, 0, 0, 0,
@@ -141,4 +147,42 @@ namespace rb::math
 
 		return _v;
 	}
+
+	// Batch transforms, one matrix is applied to a whole array so that it stays in registers.
+	// `in` and `out` may point to the same array.
+
+	// out[i] = in[i] * m
+	template<class T>
+	void transform(const mat4<T>& m, const vec4<T>* in, vec4<T>* out, size_t count) noexcept
+	{
+		static_assert(sizeof(vec4<T>) == 4 * sizeof(T), "`transform`: vectors must be tightly packed");
+
+		_mul_rows<T, 4>(reinterpret_cast<const T*>(in), m.data(), reinterpret_cast<T*>(out), count);
+	}
+
+	// out[i] = in[i] * m
+	template<class T>
+	void transform(const mat3<T>& m, const vec3<T>* in, vec3<T>* out, size_t count) noexcept
+	{
+		static_assert(sizeof(vec3<T>) == 3 * sizeof(T), "`transform`: vectors must be tightly packed");
+
+		_mul_rows<T, 3>(reinterpret_cast<const T*>(in), m.data(), reinterpret_cast<T*>(out), count);
+	}
+
+	// Transforms points (x, y, z, 1) by an affine matrix such as the ones built by `translate`, `scale` and `rotate`,
+	// the w component of the result is dropped
+	template<class T>
+	void transform_points(const mat4<T>& m, const vec3<T>* in, vec3<T>* out, size_t count) noexcept
+	{
+		static_assert(sizeof(vec3<T>) == 3 * sizeof(T), "`transform_points`: vectors must be tightly packed");
+
+		_transform_points(reinterpret_cast<const T*>(in), m.data(), reinterpret_cast<T*>(out), count);
+	}
+
+	// Structure-of-arrays layout of `transform_points`, the fastest variant since every SIMD lane transforms its own point
+	template<class T>
+	void transform_points(const mat4<T>& m, const T* x, const T* y, const T* z, T* out_x, T* out_y, T* out_z, size_t count) noexcept
+	{
+		_transform_points_soa(x, y, z, m.data(), out_x, out_y, out_z, count);
+	}
 }
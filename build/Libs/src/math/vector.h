@@ -2,6 +2,7 @@
 
 #include <exception>
 
+#include <cmath>
 #include <algorithm>
 
 #include <iostream>
@@ -94,7 +95,7 @@ namespace rb::math
 			throw std::out_of_range("vector subscript out of range");
 		}
 
-		[[nodiscard]] constexpr void _check_range(size_type idx) const
+		constexpr void _check_range(size_type idx) const
 		{
 			if (idx >= size())
 				_Xrange();
@@ -173,7 +174,7 @@ namespace rb::math
 		}
 
 		[[nodiscard]] double mag() const noexcept { return std::sqrt(mag_sqr()); }
-		[[nodiscard]] float magf() const noexcept { return std::sqrtf(mag_sqrf()); }
+		[[nodiscard]] float magf() const noexcept { return std::sqrt(mag_sqrf()); }
 
 		[[nodiscard]] this_type norm() const noexcept { return *this / magf(); }
 
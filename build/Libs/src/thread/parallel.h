@@ -0,0 +1,52 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+namespace rb::thread
+{
+	// Splits the indices [0, count) into contiguous ranges and calls `f(first, last)` on each of them from its own thread,
+	// returns once every range is done. A `thread_count` of 0 uses every hardware thread, and no thread gets fewer than
+	// `grain` indices unless there are not enough of them. The calling thread takes the first range, and a range whose
+	// thread cannot be started is run on the calling thread as well, so `f` is called on every range even without threads.
+	template<class F>
+	void parallel_for(size_t count, size_t thread_count, const F& f, size_t grain = 1) noexcept
+	{
+		if (count == 0)
+			return;
+
+		if (thread_count == 0)
+			thread_count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+		grain = std::max<size_t>(grain, 1);
+		thread_count = std::min(thread_count, (count + grain - 1) / grain);
+
+		const size_t chunk = (count + thread_count - 1) / thread_count;
+
+		const auto work = [&](size_t first)
+		{
+			f(first, std::min(first + chunk, count));
+		};
+
+		std::vector<std::thread> workers;
+
+		for (size_t first = chunk; first < count; first += chunk)
+		{
+			try
+			{
+				workers.emplace_back(work, first);
+			}
+			catch (...)
+			{
+				work(first);
+			}
+		}
+
+		work(0);
+
+		for (std::thread& worker : workers)
+			worker.join();
+	}
+}
@@ -271,6 +271,14 @@ namespace rb::tests
 			Assert::IsTrue(int128::MAX() == "7fffffffffffffffffffffffffffffff"_i128);
 		}
 
+		TEST_METHOD(REM_EXACT_MULTIPLE_256)
+		{
+			// Exact multiples have a remainder of 0 whatever the signs are
+			Assert::IsTrue(-"348219c70f3ca6ae75240d29c9fe6542e9f59396bb3c3c324a135c0"_i256 % "57e9358719bc55eb7e1587069"_i256 == "0"_i256);
+			Assert::IsTrue("348219c70f3ca6ae75240d29c9fe6542e9f59396bb3c3c324a135c0"_i256 % -"57e9358719bc55eb7e1587069"_i256 == "0"_i256);
+			Assert::IsTrue(-"348219c70f3ca6ae75240d29c9fe6542e9f59396bb3c3c324a135c0"_i256 / "57e9358719bc55eb7e1587069"_i256 == -"98e7e4c58e70c9462f09dfb728cfc0"_i256);
+		}
+
 		TEST_METHOD(ADD_BIG)
 		{
 			bigint v = "67a7389d60ef539e65bed3893a34e08e"_bigint + "360eb0c3d1d8fba1ad0c732103394c66"_bigint;
@@ -520,5 +528,20 @@ namespace rb::tests
 			Assert::IsTrue(bigint::ONE() == "1"_bigint);
 		}
 
+		TEST_METHOD(REM_EXACT_MULTIPLE_BIG)
+		{
+			Assert::IsTrue(-"348219c70f3ca6ae75240d29c9fe6542e9f59396bb3c3c324a135c0"_bigint % "57e9358719bc55eb7e1587069"_bigint == "0"_bigint);
+			Assert::IsTrue("348219c70f3ca6ae75240d29c9fe6542e9f59396bb3c3c324a135c0"_bigint % -"57e9358719bc55eb7e1587069"_bigint == "0"_bigint);
+			Assert::IsTrue(-"348219c70f3ca6ae75240d29c9fe6542e9f59396bb3c3c324a135c0"_bigint / "57e9358719bc55eb7e1587069"_bigint == -"98e7e4c58e70c9462f09dfb728cfc0"_bigint);
+		}
+
+		TEST_METHOD(MUL_KARATSUBA_BIG)
+		{
+			bigint v = -"a39edd3a7de0d208d886c5d060fa1c95e553fb510e06acd4694398c5e11e99fb01597ac1e2eb17c8b573f6c5331155190b0ecf26cf3c17e55777039e47fbb3b46583d61435bb5c11e95027004448a6a1c5c7d1861674518de3bb41b36bf82959cb01c357b9c7e435396bcb8fac9abb0c3478442b4a8aa593eb40a9b81a070205e323bb2abf00188dca22e4c76237dbe6b03da701c632976a10363c5f972651dafdb119a9ec801bdfdf2965b3819ad93b21e6a46f1c670ea90d243a163cee5e2c2b1e1885283b73a66c2ea417b99de255f386825473b7a490f23b2cc4b4174a672b5ebaa061076dc3ba6ace6c0a78250fb339a4769ddcc6f8efb6fbfe8de4ab47558298e214b044d79acd8acde5f6db1d76b6745180b65386569c803601a5ba50ad38835eddd6ff552fa73207237751aa4462ebfc5f915ef09cfbac6e7687a66e"_bigint
+				* "8141df319c72d92c2967c63d3c9e0381e7f8ec98f36face167019017b4999178de6081741f0fd9e908c3d505ff7a96319345a915feb0b634bca4537f44b00011bec2223b2638d17fda1bddc69b3bc5efaee7d5168e187590451e5c330dde4b940a8c16a8f554d8c2b83a04209be01b4ff09131582c2c93ab25362104946dc860b36ac08417ea3a98c3d0560da382fe103131b13d65ec29f8119e333a6b8c290d32bba064ebc1d3d2899f57f77f2a75ec92aeb20c15b7d95f8034a6a704789365eaeb999b8a2e547e22184e8215607df9e4794195021cd6ff548914ef33fb4b4fda298adee5329b4e329a86139425b3e2c3ad4d991f0916cb00fded6598cae043f6c986f21caf107ad9c98c23e80a86cfbc79ce036cbaccf13c9a8df50602fe0c"_bigint;
+			bigint r = -"529d2777bd64c220c4653a1e96d9046bb0e4686552e8b615b33c0c6bcdcfce594c9bd3796b0b919f89356ffe26d487a5354506cd02f8f0fb83adc1514cb5658e2ae304438455c5fbbb2332b39e26ef614e30badb7e99ac1171bf9a2a9b1b0ba699cb7709f6b9c4dd90faf55725c1cdbd753f3ea095b5f0f361dca9570b918635b2470b7987aa4be72a2714967db7af150dbc1e742630412c1ed478e8a35bb09907d1467673e4449456cb6b654c9d68ae7e287ddf32eac7d8a2ee1d8a4403e32ca8b4d2ac01ebb45924531521d5481e5cabe69f532e0ad57aa47efd4e54da62ec273eb90c62a140a10a3cab5045dfe8553434735fa296e493757b3c978d9ff7e23c4453e82479669d29457805e508513df50eac40fcfaf1bfa31cf3b787c1071fc49be2fe1b5bd440fb080cd5a201043b4c506fff2ac19fe91f83f02a540c9a459b9b828d425a2c379ae372ac947c260a556f1febb4b2088d52f3cb24cd783e2e06232c720a7e64ad560f7eac2d9b7de595fdb1966f02272fd480fa1872c9823c804f1bd984789bf53d14a29c0ca5352f5dc757c92a8566a8ee3b5e82564ea320127d8800864d735a72bb62e06c8666a16abcb13a94379071f0582cd0c47bfa1b30fb1be227617781843b31551571d40aee0e8f557def10b4c67a0e4914c4b0df6815689ac8d60efa2b52431ecc7718342fed5e38917c6dba8bf35245094d8b25a10019121ea4cc7aabdea9b63177b0eb4a5849828a8f19d9117b32b76079d0de46e3186df415dd5dce9cfc93bd3170e5e4475a8e72d995538dc6d38bc88097b840a169cb19eacb4c006144790908142c5c0b971093e19a350d2ea7040658f128"_bigint;
+			Assert::IsTrue(v == r);
+		}
+
 	};
 }
@@ -209,6 +209,36 @@ namespace rb::tests
 			Assert::IsTrue(uint128::MAX() == "ffffffffffffffffffffffffffffffff"_u128);
 		}
 
+		TEST_METHOD(MUL_4096)
+		{
+			// Both operands have at least 32 limbs, so the product is computed with Karatsuba and truncated
+			biguint_impl<4096> v = biguint_impl<4096>(std::string_view("9884b5ff3b1fc1dca5d9b12a6ccd428d10f7bc33bcd473b290e71c233f8e05aec71cc9b5b59e60ce58989c777f510ef56dbb3c3acebb95c28f78a4cdc7dd5a6e61a23d2f068007ca0e1f35a9c8bab293847b27e21a62c23748ee59b5a127941d4ea19d1816bcaea5d0901bc653202a754506f38b71aaeea938c1b7e036a32a5d1c98def66efe9b6400284cfa54267ace9b954ae4cca380aa61027d4d04b3acbabee62671930e3b99f268403afc6f313e32e2bbbd66f4a21535c490fa738865ad5d95e3eb958a3010e1b7a662dd3177811c26b9c058e1fa75de0c057f163488cbb00e0067c64dd2e190b301ff971b377685a5a77aac937076d87d8e185daeb168bc6a37110b041000"))
+				* biguint_impl<4096>(std::string_view("a9c6b5c42b48d173cd80b868e31e0280969287dc620c5871cb7dee30c3a0a9568fda5929b42f1cfd247c3a58738efacd6b805ad010caf5361e30b9e1b22c47ff4bc7556d8e53609fbf5c166f162aa5e7f636aa932326111a471918ad8fdac9077b1d59222401474348f670b05ac28cfacc76b117f7682c1e03c988cd9c8e744c4b533d78638d8d11c95d3d6a3566ee58734fe4d10f97d8260c7fe292030a390425f841219b475cb61ec98244fc7561aa2a09f663f24f1527435165572c39bf42cf410a81f9aa920ff0812e130cedd05a0785132642480f85e021e152d7e0c939b15138192bca927e4a50eeddaae1a1d5239e666a5e8e60308f7a8c30dc228135f4b2021d5f7aecc48287503e66a1a567c2bfcd84f6cd9abc"));
+			biguint_impl<4096> r = biguint_impl<4096>(std::string_view("9452eba344d64bd6236556f5ee63c653b05f4c26f61571d57e740ba684765f2211dce7e1bec9b9257898708deab3e0de2193d32f7cabc08ed4734cf3fda9b2603576048dc607a78ecfbf10d690cbd7aa44cc9b37917b2fc913678c9e03a3cbb845ceb7a9e3768fee49ae741aed83b9cb787dfeb6097ef1391803c2f9375cf3b092dbb525bdd40fc7dcd95bda76fc23f495eb35197e7e3432528ae1a2053686c4905042beaaf7fbbb712509fa17f4375476faf65204e74df3d468e5a9a8fe9e975af051b86a08bf97559e443fc4ac41e52bb09bbdf738031be636fa93e65f51fdcdd1ab50d51ce677e5169b3bd529985d1f2d30a89e73e6693f7a57b39cf908889b816d90eba0aaedf5d2724c2b8f22364b6267c131b1aa63d65807c3bc5434a72a53bf4b7b7bb84b86862ef30eb906e4dee7446299f5f10ff76352cbcc6c2084e3ef8edcc0ec0ac7e8fa3e7ab1ea755b74a36c6d966aa015d37f1ee0f7523cb477e7856e425eb4728f613e43ba6f0b44854f590eb55795db37d65331769481aec90704ad85b83e81d50827382b0b4919c99b2772cbacb75e961c2a3c21e79db5e64190439086c0fb58985da839637a84e92a968ee45606549c14963291c9cd2af232ebb146a6b62ee48296cace546c5cc98b4ea072b7c182715dc85c4fa061aa27b8fe69fe6a4a0e1593531341c7a41db59adf5dead002fe9b44aac5589bc000"));
+			Assert::IsTrue(v == r);
+		}
+
+		TEST_METHOD(DIV_ADD_BACK_256)
+		{
+			// The first quotient limb estimate is one too large and only the add back step corrects it
+			uint256 v0 = "7fffffffffffffff800000000000000000000000000000000000000000000000"_u256 / "800000000000000000000000000000000000000000000001"_u256;
+			uint256 r0 = "fffffffffffffffe"_u256;
+			Assert::IsTrue(v0 == r0);
+
+			uint256 v1 = "7fffffffffffffff800000000000000000000000000000000000000000000000"_u256 % "800000000000000000000000000000000000000000000001"_u256;
+			uint256 r1 = "7fffffffffffffffffffffffffffffff0000000000000002"_u256;
+			Assert::IsTrue(v1 == r1);
+		}
+
+		TEST_METHOD(DIV_ADD_BACK_2048)
+		{
+			uint2048 u = "7fffffffffffffff800000000000000000000000000000000000000000000000634f806fabf4a07c566002249b191bf4d8441b5616332aca5f552773e14b0190d93936e1daca3c06f5ff0c03bb5d7385de08caa1a08179104a25e4664f5253a02a3187853184ff27459142deccea264542a00403ce80c4b0a4042bb3d4341aad06905269ed6f0b09f165c8ce36e2f24b43000de01b2ed40ed3addccb2c33be0ac79d679346d4ac7a5c3902b38963dc6e8534f45738d048ec0f1099c6c3e1b258fd724452ccea71ff4a14876aeaff1a098ca5996666ceab360512bd13110722311710cf5327ac435a7a97c643656412a9b8a1abcd1a6916c74da4f9fc3c6da5d7"_u2048;
+			uint2048 d = "800000000000000000000000000000000000000000000001738d243a6e58d5ca49c7b59b995253fd6c79a3de69f85e3131f3b9238224b122c3e4a892d9196ada4fcfa583e1df8af9b474c7e89286a1754abcb06ae8abb93f01d89a024cdce7a6d7288ff68c320f89f1347e0cdd905ecfd160c5d0ef412ed6f1cfd99216df648647adec26793d0e453f5082492d83a8233fb62d2c81862fc9"_u2048;
+
+			Assert::IsTrue(u / d == "fffffffffffffffefffffffffffffffffffffffffffffffd18e5b78b234e546f1a29de1d01f64492675c27c394e6238a929d9f6b215bc732e7b46232e68c82243b04a96dea91491453992bd5ea0903f346bb471d60e0e8af4e39a2abe6e9b00c81e138bf341ccdc3"_u2048);
+			Assert::IsTrue(u % d == "4a9757f275fbaa03d64bd737fcef43fae82e3714273319a971c841b6fb7995a4b46e1cd2d37d7983bc24ac1b4bbbf4e9aed13e40d68ee75550f23784f9fbdbd646ffa3884d3995ee2e445342d5f285a20e1a16a12fa7fc4014d11b610aaf11cf8c4e443136514ff0c0c5ce95faf863a4287aced6a70a4a57fafb9ea71944d23f8e05f2a9268e4091f688e17c896a7dd4a24be20410f74abc"_u2048);
+		}
+
 		TEST_METHOD(ADD_BIG)
 		{
 			biguint v = "67a7389d60ef539e65bed3893a34e08e"_biguint + "360eb0c3d1d8fba1ad0c732103394c66"_biguint;
@@ -396,5 +426,43 @@ namespace rb::tests
 			Assert::IsTrue(biguint::ONE() == "1"_biguint);
 		}
 
+		TEST_METHOD(MUL_KARATSUBA_BIG)
+		{
+			biguint v = "a39edd3a7de0d208d886c5d060fa1c95e553fb510e06acd4694398c5e11e99fb01597ac1e2eb17c8b573f6c5331155190b0ecf26cf3c17e55777039e47fbb3b46583d61435bb5c11e95027004448a6a1c5c7d1861674518de3bb41b36bf82959cb01c357b9c7e435396bcb8fac9abb0c3478442b4a8aa593eb40a9b81a070205e323bb2abf00188dca22e4c76237dbe6b03da701c632976a10363c5f972651dafdb119a9ec801bdfdf2965b3819ad93b21e6a46f1c670ea90d243a163cee5e2c2b1e1885283b73a66c2ea417b99de255f386825473b7a490f23b2cc4b4174a672b5ebaa061076dc3ba6ace6c0a78250fb339a4769ddcc6f8efb6fbfe8de4ab47558298e214b044d79acd8acde5f6db1d76b6745180b65386569c803601a5ba50ad38835eddd6ff552fa73207237751aa4462ebfc5f915ef09cfbac6e7687a66e"_biguint
+				* "8141df319c72d92c2967c63d3c9e0381e7f8ec98f36face167019017b4999178de6081741f0fd9e908c3d505ff7a96319345a915feb0b634bca4537f44b00011bec2223b2638d17fda1bddc69b3bc5efaee7d5168e187590451e5c330dde4b940a8c16a8f554d8c2b83a04209be01b4ff09131582c2c93ab25362104946dc860b36ac08417ea3a98c3d0560da382fe103131b13d65ec29f8119e333a6b8c290d32bba064ebc1d3d2899f57f77f2a75ec92aeb20c15b7d95f8034a6a704789365eaeb999b8a2e547e22184e8215607df9e4794195021cd6ff548914ef33fb4b4fda298adee5329b4e329a86139425b3e2c3ad4d991f0916cb00fded6598cae043f6c986f21caf107ad9c98c23e80a86cfbc79ce036cbaccf13c9a8df50602fe0c"_biguint;
+			biguint r = "529d2777bd64c220c4653a1e96d9046bb0e4686552e8b615b33c0c6bcdcfce594c9bd3796b0b919f89356ffe26d487a5354506cd02f8f0fb83adc1514cb5658e2ae304438455c5fbbb2332b39e26ef614e30badb7e99ac1171bf9a2a9b1b0ba699cb7709f6b9c4dd90faf55725c1cdbd753f3ea095b5f0f361dca9570b918635b2470b7987aa4be72a2714967db7af150dbc1e742630412c1ed478e8a35bb09907d1467673e4449456cb6b654c9d68ae7e287ddf32eac7d8a2ee1d8a4403e32ca8b4d2ac01ebb45924531521d5481e5cabe69f532e0ad57aa47efd4e54da62ec273eb90c62a140a10a3cab5045dfe8553434735fa296e493757b3c978d9ff7e23c4453e82479669d29457805e508513df50eac40fcfaf1bfa31cf3b787c1071fc49be2fe1b5bd440fb080cd5a201043b4c506fff2ac19fe91f83f02a540c9a459b9b828d425a2c379ae372ac947c260a556f1febb4b2088d52f3cb24cd783e2e06232c720a7e64ad560f7eac2d9b7de595fdb1966f02272fd480fa1872c9823c804f1bd984789bf53d14a29c0ca5352f5dc757c92a8566a8ee3b5e82564ea320127d8800864d735a72bb62e06c8666a16abcb13a94379071f0582cd0c47bfa1b30fb1be227617781843b31551571d40aee0e8f557def10b4c67a0e4914c4b0df6815689ac8d60efa2b52431ecc7718342fed5e38917c6dba8bf35245094d8b25a10019121ea4cc7aabdea9b63177b0eb4a5849828a8f19d9117b32b76079d0de46e3186df415dd5dce9cfc93bd3170e5e4475a8e72d995538dc6d38bc88097b840a169cb19eacb4c006144790908142c5c0b971093e19a350d2ea7040658f128"_biguint;
+			Assert::IsTrue(v == r);
+		}
+
+		TEST_METHOD(DIV_ADD_BACK_BIG)
+		{
+			biguint u = "7fffffffffffffff800000000000000000000000000000000000000000000000634f806fabf4a07c566002249b191bf4d8441b5616332aca5f552773e14b0190d93936e1daca3c06f5ff0c03bb5d7385de08caa1a08179104a25e4664f5253a02a3187853184ff27459142deccea264542a00403ce80c4b0a4042bb3d4341aad06905269ed6f0b09f165c8ce36e2f24b43000de01b2ed40ed3addccb2c33be0ac79d679346d4ac7a5c3902b38963dc6e8534f45738d048ec0f1099c6c3e1b258fd724452ccea71ff4a14876aeaff1a098ca5996666ceab360512bd13110722311710cf5327ac435a7a97c643656412a9b8a1abcd1a6916c74da4f9fc3c6da5d7"_biguint;
+			biguint d = "800000000000000000000000000000000000000000000001738d243a6e58d5ca49c7b59b995253fd6c79a3de69f85e3131f3b9238224b122c3e4a892d9196ada4fcfa583e1df8af9b474c7e89286a1754abcb06ae8abb93f01d89a024cdce7a6d7288ff68c320f89f1347e0cdd905ecfd160c5d0ef412ed6f1cfd99216df648647adec26793d0e453f5082492d83a8233fb62d2c81862fc9"_biguint;
+
+			Assert::IsTrue(u / d == "fffffffffffffffefffffffffffffffffffffffffffffffd18e5b78b234e546f1a29de1d01f64492675c27c394e6238a929d9f6b215bc732e7b46232e68c82243b04a96dea91491453992bd5ea0903f346bb471d60e0e8af4e39a2abe6e9b00c81e138bf341ccdc3"_biguint);
+			Assert::IsTrue(u % d == "4a9757f275fbaa03d64bd737fcef43fae82e3714273319a971c841b6fb7995a4b46e1cd2d37d7983bc24ac1b4bbbf4e9aed13e40d68ee75550f23784f9fbdbd646ffa3884d3995ee2e445342d5f285a20e1a16a12fa7fc4014d11b610aaf11cf8c4e443136514ff0c0c5ce95faf863a4287aced6a70a4a57fafb9ea71944d23f8e05f2a9268e4091f688e17c896a7dd4a24be20410f74abc"_biguint);
+		}
+
+		TEST_METHOD(DIV_CORRECTION_BIG)
+		{
+			// The quotient limb estimate is decremented twice by the test on the third divisor limb
+			biguint u = "7fffffffffffffffffffffffffffffff00000000000000010000000000000000f17ca82cdc82f2527fffffffffffffff"_biguint;
+			biguint d = "fba61c0b52595dafffffffffffffffffffffffffffffffffffffffffffffffff"_biguint;
+
+			Assert::IsTrue(u / d == "82369338eb5aab95df5657be60d30840"_biguint);
+			Assert::IsTrue(u % d == "4317e72e66ab1401000000000000000173b33b65c7dd9de85f5657be60d3083f"_biguint);
+		}
+
+		TEST_METHOD(DATA_BIG)
+		{
+			// The limbs are 64 bits wide and stored from least to most significant
+			biguint v = "0102030405060708090a"_biguint;
+
+			Assert::IsTrue(v.size() == 16);
+			Assert::IsTrue(v.data()[0] == 0x0a);
+			Assert::IsTrue(v.data()[9] == 0x01);
+			Assert::IsTrue(v.data()[10] == 0x00);
+		}
+
 	};
 }
@@ -1,11 +1,17 @@
 #include <CppUnitTest.h>
 
+#include <fstream>
+#include <filesystem>
+
 #include "crypto/md5.h"
 #include "crypto/ripemd.h"
 #include "crypto/sha1.h"
 #include "crypto/sha2.h"
 #include "crypto/keccak.h"
 #include "crypto/hmac.h"
+#include "crypto/kdf.h"
+#include "crypto/hash_file.h"
+#include "crypto/merkle_tree.h"
 #include "crypto/bases.h"
 #include "crypto/aes.h"
 #include "crypto/ecdsa.h"
@@ -76,6 +82,90 @@ namespace rb::tests
 			Assert::IsTrue(hash.hex_digest() == "91ea1245f20d46ae9a037a989f54f1f790f0a47607eeb8a14d12890cea77a1bbc6c7ed9cf205e67b7f2b8fd4c7dfd3a7a8617e45f3c463d481c7e586c39ac1ed");
 		}
 
+		TEST_METHOD(MD5_STREAM)
+		{
+			const std::string chunk(1000, 'a');
+
+			md5 hash;
+
+			for (size_t i = 0; i < 1000; i++)
+				hash << chunk;
+
+			Assert::IsTrue(hash.hex_digest() == "7707d6ae4e027c70eea2a935c2296f21");
+		}
+
+		TEST_METHOD(SHA2_256_STREAM)
+		{
+			const std::string chunk(1000, 'a');
+
+			sha2_256 hash;
+
+			for (size_t i = 0; i < 500; i++)
+				hash << chunk;
+
+			sha2_256 midstate = hash;
+
+			for (size_t i = 0; i < 500; i++)
+				hash << chunk;
+
+			Assert::IsTrue(hash.hex_digest() == "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+			Assert::IsTrue(hash.hex_digest() == "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+
+			for (size_t i = 0; i < 500; i++)
+				midstate << chunk;
+
+			Assert::IsTrue(midstate.hex_digest() == "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+		}
+
+		TEST_METHOD(SHA_HASH_MANY)
+		{
+			std::vector<std::string> messages;
+
+			for (size_t i = 0; i < 19; i++)
+				messages.emplace_back(i * i * 7, static_cast<char>('a' + i));
+
+			std::vector<const void*> msgs;
+			std::vector<size_t> lens;
+
+			for (const std::string& message : messages)
+			{
+				msgs.push_back(message.data());
+				lens.push_back(message.size());
+			}
+
+			uint8_t out_sha1[19 * sha1::DIGEST_SIZE / 8];
+			uint8_t out_sha2_256[19 * sha2_256::DIGEST_SIZE / 8];
+
+			sha1::hash_many(msgs.data(), lens.data(), messages.size(), out_sha1);
+			sha2_256::hash_many(msgs.data(), lens.data(), messages.size(), out_sha2_256);
+
+			// The AVX2 kernel is only dispatched to without SHA-NI, so it is called directly as well
+			uint8_t out_sha1_x8[19 * sha1::DIGEST_SIZE / 8];
+			uint8_t out_sha2_256_x8[19 * sha2_256::DIGEST_SIZE / 8];
+
+			sha1::_hash_many_x8(msgs.data(), lens.data(), messages.size(), out_sha1_x8);
+			sha2_256::_hash_many_x8(msgs.data(), lens.data(), messages.size(), out_sha2_256_x8);
+
+			for (size_t i = 0; i < messages.size(); i++)
+			{
+				uint8_t digest[sha2_256::DIGEST_SIZE / 8];
+
+				sha1 hash_sha1;
+				hash_sha1 << messages[i];
+				hash_sha1.digest(digest);
+
+				Assert::IsTrue(std::memcmp(digest, out_sha1 + i * sha1::DIGEST_SIZE / 8, sha1::DIGEST_SIZE / 8) == 0);
+				Assert::IsTrue(std::memcmp(digest, out_sha1_x8 + i * sha1::DIGEST_SIZE / 8, sha1::DIGEST_SIZE / 8) == 0);
+
+				sha2_256 hash_sha2_256;
+				hash_sha2_256 << messages[i];
+				hash_sha2_256.digest(digest);
+
+				Assert::IsTrue(std::memcmp(digest, out_sha2_256 + i * sha2_256::DIGEST_SIZE / 8, sha2_256::DIGEST_SIZE / 8) == 0);
+				Assert::IsTrue(std::memcmp(digest, out_sha2_256_x8 + i * sha2_256::DIGEST_SIZE / 8, sha2_256::DIGEST_SIZE / 8) == 0);
+			}
+		}
+
 		TEST_METHOD(SHA3_224)
 		{
 			sha3_224 hash;
@@ -124,6 +214,145 @@ namespace rb::tests
 			Assert::IsTrue(hash.hex_digest() == "bd225bfc8b255f3036f0c8866010ed0053b5163a3cae111e723c0c8e704eca4e5d0f1e2a2fa18c8a219de6b88d5917ff5dd75b5fb345e7409a3b333b508a65fb");
 		}
 
+		TEST_METHOD(SHA3_256_STREAM)
+		{
+			const std::string chunk(1000, 'a');
+
+			sha3_256 hash;
+
+			for (size_t i = 0; i < 500; i++)
+				hash << chunk;
+
+			sha3_256 midstate = hash;
+
+			for (size_t i = 0; i < 500; i++)
+				hash << chunk;
+
+			Assert::IsTrue(hash.hex_digest() == "5c8875ae474a3634ba4fd55ec85bffd661f32aca75c6d699d0cdcb6c115891c1");
+
+			for (size_t i = 0; i < 500; i++)
+				midstate.write(chunk.data(), 7).write(chunk.data() + 7, chunk.size() - 7);
+
+			Assert::IsTrue(midstate.hex_digest() == "5c8875ae474a3634ba4fd55ec85bffd661f32aca75c6d699d0cdcb6c115891c1");
+		}
+
+		TEST_METHOD(SHAKE128_SQUEEZE)
+		{
+			shake128<4096> hash;
+			hash << "The quick brown fox jumps over the lazy dog.";
+
+			uint8_t expected[512];
+			hash.digest(expected);
+
+			uint8_t stream[512];
+			hash.squeeze(stream, 5);
+			hash.squeeze(stream + 5, 200);
+			hash.squeeze(stream + 205, 307);
+
+			Assert::IsTrue(std::memcmp(expected, stream, sizeof(stream)) == 0);
+			Assert::IsTrue(std::memcmp(expected, "\x63\x40\x69\xe6\xb1\x3c\x3a\xf6", 8) == 0);
+		}
+
+		TEST_METHOD(SHAKE128_DIGEST_AFTER_SQUEEZE)
+		{
+			shake128<256> hash;
+			hash << "The quick brown fox jumps over the lazy dog.";
+
+			const std::string expected = hash.hex_digest();
+
+			uint8_t stream[300];
+			hash.squeeze(stream, sizeof(stream));
+
+			Assert::IsTrue(hash.hex_digest() == expected);
+
+			// Input written while squeezing is ignored
+			hash << "more";
+
+			Assert::IsTrue(hash.hex_digest() == expected);
+
+			uint8_t next[8];
+			hash.squeeze(next, sizeof(next));
+
+			shake128<2464> reference;
+			reference << "The quick brown fox jumps over the lazy dog.";
+
+			uint8_t reference_stream[308];
+			reference.digest(reference_stream);
+
+			Assert::IsTrue(std::memcmp(reference_stream, stream, sizeof(stream)) == 0);
+			Assert::IsTrue(std::memcmp(reference_stream + 300, next, sizeof(next)) == 0);
+		}
+
+		TEST_METHOD(KECCAK_P1600_X4)
+		{
+			uint64_t states[4][25];
+			uint64_t interleaved[25][4];
+
+			for (size_t j = 0; j < 4; j++)
+				for (size_t i = 0; i < 25; i++)
+					interleaved[i][j] = states[j][i] = (j + 1) * 0x9E3779B97F4A7C15ull * (i + 1);
+
+			keccak_p1600_x4(interleaved);
+
+			for (size_t j = 0; j < 4; j++)
+			{
+				keccak_p1600(states[j]);
+
+				for (size_t i = 0; i < 25; i++)
+					Assert::IsTrue(interleaved[i][j] == states[j][i]);
+			}
+		}
+
+		TEST_METHOD(PARALLEL_HASH)
+		{
+			const uint8_t data[24] = {
+				0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+				0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+				0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27
+			};
+
+			uint8_t digest[64];
+
+			parallel_hash128(data, sizeof(data), 8, digest, 32);
+			Assert::IsTrue(base16::encode(digest, 32) == "BA8DC1D1D979331D3F813603C67F72609AB5E44B94A0B8F9AF46514454A2B4F5");
+
+			parallel_hash128(data, sizeof(data), 8, digest, 32, "Parallel Data");
+			Assert::IsTrue(base16::encode(digest, 32) == "FC484DCB3F84DCEEDC353438151BEE58157D6EFED0445A81F165E495795B7206");
+
+			parallel_hash256(data, sizeof(data), 8, digest, 64, "Parallel Data");
+			Assert::IsTrue(base16::encode(digest, 64) == "CDF15289B54F6212B4BC270528B49526006DD9B54E2B6ADD1EF6900DDA3963BB33A72491F236969CA8AFAEA29C682D47A393C065B38E29FAE651A2091C833110");
+
+			std::vector<uint8_t> pattern(100000);
+
+			for (size_t i = 0; i < pattern.size(); i++)
+				pattern[i] = static_cast<uint8_t>(i % 251);
+
+			parallel_hash128(pattern.data(), pattern.size(), 1000, digest, 32, "", 3);
+			Assert::IsTrue(base16::encode(digest, 32) == "C6385496081253BD6F30A5ABB57815E298AB6E33FF287C4F6D60498D327FD047");
+		}
+
+		TEST_METHOD(KANGAROO_TWELVE)
+		{
+			uint8_t digest[32];
+
+			kangaroo_twelve(nullptr, 0, digest, 32);
+			Assert::IsTrue(base16::encode(digest, 32) == "1AC2D450FC3B4205D19DA7BFCA1B37513C0803577AC7167F06FE2CE1F0EF39E5");
+
+			std::vector<uint8_t> pattern(17 * 17 * 17 * 17 * 17);
+
+			for (size_t i = 0; i < pattern.size(); i++)
+				pattern[i] = static_cast<uint8_t>(i % 251);
+
+			kangaroo_twelve(pattern.data(), 17 * 17 * 17, digest, 32);
+			Assert::IsTrue(base16::encode(digest, 32) == "CB552E2EC77D9910701D578B457DDF772C12E322E4EE7FE417F92C758F0D59D0");
+
+			kangaroo_twelve(pattern.data(), pattern.size(), digest, 32, "", 4);
+			Assert::IsTrue(base16::encode(digest, 32) == "844D610933B1B9963CBDEB5AE3B6B05CC7CBD67CEEDF883EB678A0A8E0371682");
+
+			kangaroo_twelve(nullptr, 0, digest, 32, std::string(reinterpret_cast<const char*>(pattern.data()), 41));
+			Assert::IsTrue(base16::encode(digest, 32) == "76F06E60FBA37414E0DC56D9D1E5D03B2D38C672B70C8C51D2E00A4FA959F1AA");
+		}
+
 		TEST_METHOD(HMAC_SHA2_256)
 		{
 			hmac<sha2_256> hash;
@@ -132,6 +361,136 @@ namespace rb::tests
 			Assert::IsTrue(hash.hex_digest("key", 3) == "e98139c39d76eb80d8db982552b44b251b94f312987f91ee72d12ef673caa813");
 		}
 
+		TEST_METHOD(HMAC_SHA2_256_CONTEXT)
+		{
+			hmac_context<sha2_256> hash("Jefe", 4);
+			hash << "what do ya want for nothing?";
+
+			Assert::IsTrue(hash.hex_digest() == "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+
+			hash.clear();
+			hash << "what do ya want " << "for nothing?";
+
+			Assert::IsTrue(hash.hex_digest() == "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+
+			const std::string long_key(131, '\xAA');
+			const std::string message = "Test Using Larger Than Block-Size Key - Hash Key First";
+
+			hash.set_key(long_key.data(), long_key.size());
+
+			Assert::IsTrue(hash(message) == "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54");
+
+			const std::string block_key(64, 'k');
+
+			hmac<sha2_256> keyed;
+			keyed << "abc";
+
+			Assert::IsTrue(keyed.hex_digest(block_key.data(), block_key.size()) == "ae0c0e4a2340cf50185eb46aaa8723f4769153661612e212fb0d1fa3170c6202");
+		}
+
+		TEST_METHOD(PBKDF2_HMAC)
+		{
+			uint8_t key[32];
+
+			pbkdf2_hmac<sha1>("password", 8, "salt", 4, 4096, key, 20);
+			Assert::IsTrue(base16::encode(key, 20) == "4B007901B765489ABEAD49D926F721D065A429C1");
+
+			pbkdf2_hmac<sha1>("passwordPASSWORDpassword", 24, "saltSALTsaltSALTsaltSALTsaltSALTsalt", 36, 4096, key, 25, 2);
+			Assert::IsTrue(base16::encode(key, 25) == "3D2EEC4FE41C849B80C8D83662C0E44A8B291A964CF2F07038");
+
+			pbkdf2_hmac<sha2_256>("password", 8, "salt", 4, 4096, key, 32);
+			Assert::IsTrue(base16::encode(key, 32) == "C5E478D59288C841AA530DB6845C4C8D962893A001CE4E11A4963873AA98134A");
+		}
+
+		TEST_METHOD(HKDF_SHA2_256)
+		{
+			const std::string ikm(22, '\x0B');
+			const uint8_t salt[13] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C };
+			const uint8_t info[10] = { 0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9 };
+
+			uint8_t prk[32];
+			uint8_t okm[42];
+
+			hkdf_extract<sha2_256>(salt, sizeof(salt), ikm.data(), ikm.size(), prk);
+			Assert::IsTrue(base16::encode(prk, 32) == "077709362C2E32DF0DDC3F0DC47BBA6390B6C73BB50F9C3122EC844AD7C2B3E5");
+
+			Assert::IsTrue(hkdf_expand<sha2_256>(prk, sizeof(prk), info, sizeof(info), okm, sizeof(okm)));
+			Assert::IsTrue(base16::encode(okm, 42) == "3CB25F25FAACD57A90434F64D0362F2A2D2D0A90CF1A5A4C5DB02D56ECC4C5BF34007208D5B887185865");
+
+			Assert::IsTrue(hkdf<sha2_256>(nullptr, 0, ikm.data(), ikm.size(), nullptr, 0, okm, sizeof(okm)));
+			Assert::IsTrue(base16::encode(okm, 42) == "8DA4E775A563C18F715F802A063C5A31B8A11F5C5EE1879EC3454E5F3C738D2D9D201395FAA4B61A96C8");
+
+			Assert::IsFalse(hkdf_expand<sha2_256>(prk, sizeof(prk), info, sizeof(info), okm, 255 * 32 + 1));
+		}
+
+		TEST_METHOD(HASH_FILE)
+		{
+			std::string data(10000, '\0');
+
+			for (size_t i = 0; i < data.size(); i++)
+				data[i] = static_cast<char>(i * 7 + 3);
+
+			const std::filesystem::path path = std::filesystem::temp_directory_path() / "rblibs_hash_file_test.bin";
+			std::ofstream(path, std::ios::binary).write(data.data(), data.size());
+
+			uint8_t digest[32];
+
+			Assert::IsTrue(hash_file<sha2_256>(path, digest));
+			Assert::IsTrue(base16::encode(digest, 32) == "6E97D8601CB17906A4819E0FCC8D03150D3E4331353ECAA516C0084CADAD54DD");
+
+			merkle_tree<sha2_256> tree(1024);
+
+			Assert::IsTrue(tree.build_file(path, 4));
+			Assert::IsTrue(tree.leaf_count() == 10);
+			Assert::IsTrue(tree.hex_root() == "45f6055691cd604c16423bff8799d17c861f78c0791158ccbb523edf4c5052af");
+
+			std::filesystem::remove(path);
+
+			Assert::IsFalse(hash_file<sha2_256>(path, digest));
+			Assert::IsFalse(tree.build_file(path));
+
+			// Only regular files can be mapped
+#if defined(_WIN32)
+			const std::filesystem::path device = "NUL";
+#else
+			const std::filesystem::path device = "/dev/null";
+#endif
+
+			Assert::IsFalse(hash_file<sha2_256>(device, digest));
+			Assert::IsFalse(tree.build_file(device));
+			Assert::IsFalse(hash_file<sha2_256>(std::filesystem::temp_directory_path(), digest));
+			Assert::IsFalse(tree.build_file(std::filesystem::temp_directory_path()));
+		}
+
+		TEST_METHOD(MERKLE_TREE)
+		{
+			std::string data(10000, '\0');
+
+			for (size_t i = 0; i < data.size(); i++)
+				data[i] = static_cast<char>(i * 7 + 3);
+
+			merkle_tree<sha2_256> tree(1024);
+			tree.build(data.data(), data.size(), 3);
+
+			Assert::IsTrue(tree.hex_root() == "45f6055691cd604c16423bff8799d17c861f78c0791158ccbb523edf4c5052af");
+			Assert::IsTrue(tree.hex_leaf(3) == "35c41357885b6a24ae3847bbf752ef58b33199540c608ddd484e0c616d1194db");
+			Assert::IsTrue(tree.verify_chunk(3, data.data() + 3 * 1024, 1024));
+
+			data[3 * 1024 + 5] ^= 1;
+
+			Assert::IsFalse(tree.verify_chunk(3, data.data() + 3 * 1024, 1024));
+			Assert::IsTrue(tree.update_chunk(3, data.data() + 3 * 1024, 1024));
+			Assert::IsTrue(tree.hex_root() == "6e941635a489eae0bb8b553e8ae2b5584d5caa505922e0eb73c47ce14add0b41");
+
+			merkle_tree<sha2_256> single(1024);
+			single.build(data.data(), data.size(), 1);
+
+			Assert::IsTrue(single.hex_root() == tree.hex_root());
+
+			single.build(nullptr, 0);
+			Assert::IsTrue(single.hex_root() == sha2_256()(""));
+		}
+
 		TEST_METHOD(BASE16_TO)
 		{
 			Assert::IsTrue(base16::encode("foobar", 6) == "666F6F626172");
@@ -366,6 +725,192 @@ namespace rb::tests
 			Assert::IsTrue(cipher.hex_decrypt(key, 32) == "00112233445566778899aabbccddeeff");
 		}
 
+		TEST_METHOD(AES_128_CTR)
+		{
+			uint8_t data[32] = {
+				0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96,
+				0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+				0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c,
+				0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51
+			};
+
+			uint8_t key[16] = {
+				0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+				0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+			};
+
+			uint8_t counter[16] = {
+				0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+				0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
+			};
+
+			aes_128_ctr cipher;
+			cipher.set_iv(counter, 16);
+			cipher.write(data, 32);
+
+			Assert::IsTrue(cipher.hex_encrypt(key, 16) == "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff");
+
+			aes_128_key round_keys(key, 16);
+			round_keys.ctr_crypt(counter, data, 32);
+
+			Assert::IsTrue(data[0] == 0x87 && data[31] == 0xff);
+			Assert::IsTrue(counter[14] == 0xff && counter[15] == 0x01);
+		}
+
+		TEST_METHOD(AES_128_GCM)
+		{
+			uint8_t data[60] = {
+				0xd9, 0x31, 0x32, 0x25, 0xf8, 0x84, 0x06, 0xe5, 0xa5, 0x59, 0x09, 0xc5, 0xaf, 0xf5, 0x26, 0x9a,
+				0x86, 0xa7, 0xa9, 0x53, 0x15, 0x34, 0xf7, 0xda, 0x2e, 0x4c, 0x30, 0x3d, 0x8a, 0x31, 0x8a, 0x72,
+				0x1c, 0x3c, 0x0c, 0x95, 0x95, 0x68, 0x09, 0x53, 0x2f, 0xcf, 0x0e, 0x24, 0x49, 0xa6, 0xb5, 0x25,
+				0xb1, 0x6a, 0xed, 0xf5, 0xaa, 0x0d, 0xe6, 0x57, 0xba, 0x63, 0x7b, 0x39
+			};
+
+			uint8_t key[16] = {
+				0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c,
+				0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08
+			};
+
+			uint8_t iv[12] = {
+				0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88
+			};
+
+			uint8_t aad[20] = {
+				0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed,
+				0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xab, 0xad, 0xda, 0xd2
+			};
+
+			aes_128_gcm cipher;
+			cipher.set_iv(iv, 12);
+			cipher.set_aad(aad, 20);
+			cipher.write(data, 60);
+
+			Assert::IsTrue(cipher.hex_encrypt(key, 16) == 
+				"42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+				"21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091"
+				"5bc94fbc3221a5db94fae95ae7121a47");
+
+			aes_128_key round_keys(key, 16);
+			uint8_t buffer[60], tag[16];
+
+			std::memcpy(buffer, data, 60);
+			round_keys.gcm_encrypt(iv, 12, aad, 20, buffer, 60, tag);
+
+			Assert::IsTrue(round_keys.gcm_decrypt(iv, 12, aad, 20, buffer, 60, tag));
+			Assert::IsTrue(std::memcmp(buffer, data, 60) == 0);
+
+			round_keys.gcm_encrypt(iv, 12, aad, 20, buffer, 60, tag);
+			tag[0] ^= 1;
+
+			Assert::IsFalse(round_keys.gcm_decrypt(iv, 12, aad, 20, buffer, 60, tag));
+		}
+
+		TEST_METHOD(AES_128_CTR_LONG)
+		{
+			// 203 bytes run the 8 block AES-NI loop and leave a partial block, the counter wraps after 3 blocks
+			uint8_t data[203];
+
+			for (size_t i = 0; i < sizeof(data); i++)
+				data[i] = static_cast<uint8_t>(i * 7 + 3);
+
+			uint8_t key[16] = {
+				0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+				0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+			};
+
+			uint8_t counter[16] = {
+				0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+				0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfd
+			};
+
+			// Computed with OpenSSL
+			const std::string expected =
+				"FDF02902F9618F1CAC5C92520B30178EA2CD953E74636255832857EA8B80387F"
+				"691877F9BDF18BE01212552A0840EFE02EAD0A6475CEE437B5D069E71EB5E1D3"
+				"94D8AC98EB57534B55F66FA9D06C4AEAA4056FBB072FBF6614654DB0B87C8A15"
+				"E536CE73CA1314756FFA22698CF7A489996616855308E276020C97AAB9AC4460"
+				"6CA249BFA65B21C5FCF0F6AE461E2E16C39CE516688B959CC4D9427D0DBDA39D"
+				"E8008162B4F2E95FF3660AE43D11506ADFA64592F2028CB1A961E7E399006C67"
+				"7C3981CFD858374A8C0BDE";
+
+			aes_128_key accelerated(key, 16);
+			aes_128_key portable(key, 16);
+			portable._disable_aesni();
+
+			for (const aes_128_key* round_keys : { &accelerated, &portable })
+			{
+				uint8_t buffer[203], iv[16];
+
+				std::memcpy(buffer, data, sizeof(data));
+				std::memcpy(iv, counter, 16);
+				round_keys->ctr_crypt(iv, buffer, sizeof(buffer));
+
+				Assert::IsTrue(base16::encode(buffer, sizeof(buffer)) == expected);
+				Assert::IsTrue(iv[0] == 0x00 && iv[14] == 0x00 && iv[15] == 0x0a);
+
+				std::memcpy(iv, counter, 16);
+				round_keys->ctr_crypt(iv, buffer, sizeof(buffer));
+
+				Assert::IsTrue(std::memcmp(buffer, data, sizeof(data)) == 0);
+			}
+		}
+
+		TEST_METHOD(AES_128_GCM_LONG)
+		{
+			// 203 bytes of data and 150 bytes of AAD run the 8 block AES-NI and GHASH loops and leave a partial block
+			uint8_t data[203], aad[150];
+
+			for (size_t i = 0; i < sizeof(data); i++)
+				data[i] = static_cast<uint8_t>(i * 7 + 3);
+
+			for (size_t i = 0; i < sizeof(aad); i++)
+				aad[i] = static_cast<uint8_t>(i * 13 + 5);
+
+			uint8_t key[16] = {
+				0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c,
+				0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08
+			};
+
+			uint8_t iv[12] = {
+				0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88
+			};
+
+			// Computed with OpenSSL
+			const std::string expected =
+				"98B83DFFC6D55FF5D56961227C7B976A167709F4B6A0CE9EB03FF7DE6453FE80"
+				"DE03E9DF3E08975B49624D4ED21C5A6CF99387A4AF7137440CA90208FA3E3E6C"
+				"1E62B61C11145C0543ABF659DD3EAE4D25E2B5B98C9F7A5B48A5219C44FD71FD"
+				"53B4ED071AE98D268BEEEE34E8C9747DD2A7D59D4F50BE34CFD8F3566174E224"
+				"7D5C6C29779D09AB98BBFF7B91BEC02C334CDD8E2D53951EB9E1C1947C77F377"
+				"1107376ED22F69259AE5373183BCE37352669A294A3FCA2D78FEA7A2BDD1621C"
+				"E7F955A6C5F7C4DAD4464D";
+
+			const std::string expected_tag = "A638D140BD88A92A5BAD270E4A8025F8";
+
+			aes_128_key accelerated(key, 16);
+			aes_128_key portable(key, 16);
+			portable._disable_aesni();
+
+			for (const aes_128_key* round_keys : { &accelerated, &portable })
+			{
+				uint8_t buffer[203], tag[16];
+
+				std::memcpy(buffer, data, sizeof(data));
+				round_keys->gcm_encrypt(iv, 12, aad, sizeof(aad), buffer, sizeof(buffer), tag);
+
+				Assert::IsTrue(base16::encode(buffer, sizeof(buffer)) == expected);
+				Assert::IsTrue(base16::encode(tag, 16) == expected_tag);
+
+				Assert::IsTrue(round_keys->gcm_decrypt(iv, 12, aad, sizeof(aad), buffer, sizeof(buffer), tag));
+				Assert::IsTrue(std::memcmp(buffer, data, sizeof(data)) == 0);
+
+				round_keys->gcm_encrypt(iv, 12, aad, sizeof(aad), buffer, sizeof(buffer), tag);
+				tag[15] ^= 0x80;
+
+				Assert::IsFalse(round_keys->gcm_decrypt(iv, 12, aad, sizeof(aad), buffer, sizeof(buffer), tag));
+			}
+		}
+
 		TEST_METHOD(ECDSA_SECP192K1)
 		{
 			ECDSA_secp192k1::key_pair_type key = ECDSA_secp192k1::generate_key_pair();
@@ -494,5 +1039,37 @@ namespace rb::tests
 			Assert::IsTrue(ECDSA_secp521r1::verify(std::get<1>(key), sig, data, 16));
 		}
 
+		TEST_METHOD(ECDSA_SECP256K1_VERIFY_MANY)
+		{
+			ECDSA_secp256k1::key_pair_type key = ECDSA_secp256k1::generate_key_pair();
+
+			uint8_t data[8][16] = {};
+
+			ECDSA_secp256k1::public_key_type keys[8];
+			ECDSA_secp256k1::signature_type sigs[8];
+			const void* ptrs[8];
+			size_t sizes[8];
+			bool results[8];
+
+			for (size_t i = 0; i < 8; i++)
+			{
+				data[i][0] = static_cast<uint8_t>(i);
+
+				keys[i] = std::get<1>(key);
+				sigs[i] = ECDSA_secp256k1::sign(std::get<0>(key), data[i], 16);
+				ptrs[i] = data[i];
+				sizes[i] = 16;
+			}
+
+			data[5][1] ^= 0x01;
+
+			ECDSA_secp256k1::verify_many(keys, sigs, ptrs, sizes, 8, results, 3);
+
+			for (size_t i = 0; i < 8; i++)
+				Assert::IsTrue(results[i] == (i != 5));
+
+			Assert::IsFalse(ECDSA_secp256k1::verify(std::get<1>(key), sigs[5], data[5], 16));
+		}
+
 	};
 }
@@ -1,6 +1,7 @@
 #include <CppUnitTest.h>
 
 #include "math/matrix.h"
+#include "math/transform.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -288,5 +289,302 @@ namespace rb::tests
 			Assert::IsTrue(inv_expected == inv);
 		}
 
+		TEST_METHOD(MUL_MATRIX_MAT4)
+		{
+			mat4f m{
+				1.0f, 2.0f, 3.0f, 4.0f,
+				5.0f, 6.0f, 7.0f, 8.0f,
+				9.0f, 10.0f, 11.0f, 12.0f,
+				13.0f, 14.0f, 15.0f, 16.0f
+			};
+
+			mat4f mul_expected{
+				90.0f, 100.0f, 110.0f, 120.0f,
+				202.0f, 228.0f, 254.0f, 280.0f,
+				314.0f, 356.0f, 398.0f, 440.0f,
+				426.0f, 484.0f, 542.0f, 600.0f
+			};
+
+			Assert::IsTrue(mul_expected == m * m);
+
+			mat4d md{
+				1.0, 2.0, 3.0, 4.0,
+				5.0, 6.0, 7.0, 8.0,
+				9.0, 10.0, 11.0, 12.0,
+				13.0, 14.0, 15.0, 16.0
+			};
+
+			mat4d muld_expected{
+				90.0, 100.0, 110.0, 120.0,
+				202.0, 228.0, 254.0, 280.0,
+				314.0, 356.0, 398.0, 440.0,
+				426.0, 484.0, 542.0, 600.0
+			};
+
+			Assert::IsTrue(muld_expected == md * md);
+		}
+
+		TEST_METHOD(TRANSPOSE_MAT4)
+		{
+			mat4f m{
+				1.0f, 2.0f, 3.0f, 4.0f,
+				5.0f, 6.0f, 7.0f, 8.0f,
+				9.0f, 10.0f, 11.0f, 12.0f,
+				13.0f, 14.0f, 15.0f, 16.0f
+			};
+
+			mat4f t_expected{
+				1.0f, 5.0f, 9.0f, 13.0f,
+				2.0f, 6.0f, 10.0f, 14.0f,
+				3.0f, 7.0f, 11.0f, 15.0f,
+				4.0f, 8.0f, 12.0f, 16.0f
+			};
+
+			Assert::IsTrue(t_expected == m.transpose());
+		}
+
+		TEST_METHOD(INVERSE_MAT4)
+		{
+			mat4f m{
+				0.0f, 2.0f, 0.0f, 0.0f,
+				-4.0f, 0.0f, 0.0f, 0.0f,
+				0.0f, 0.0f, 0.5f, 0.0f,
+				1.0f, 2.0f, 3.0f, 1.0f
+			};
+
+			mat4f inv_expected{
+				0.0f, -0.25f, 0.0f, 0.0f,
+				0.5f, 0.0f, 0.0f, 0.0f,
+				0.0f, 0.0f, 2.0f, 0.0f,
+				-1.0f, 0.25f, -6.0f, 1.0f
+			};
+
+			Assert::IsTrue(inv_expected == m.inverse());
+
+			mat4d md{
+				0.0, 2.0, 0.0, 0.0,
+				-4.0, 0.0, 0.0, 0.0,
+				0.0, 0.0, 0.5, 0.0,
+				1.0, 2.0, 3.0, 1.0
+			};
+
+			mat4d invd_expected{
+				0.0, -0.25, 0.0, 0.0,
+				0.5, 0.0, 0.0, 0.0,
+				0.0, 0.0, 2.0, 0.0,
+				-1.0, 0.25, -6.0, 1.0
+			};
+
+			Assert::IsTrue(invd_expected == md.inverse());
+		}
+
+		TEST_METHOD(MUL_MATRIX_MAT3)
+		{
+			mat3f m{
+				1.0f, 2.0f, 3.0f,
+				4.0f, 5.0f, 6.0f,
+				7.0f, 8.0f, 9.0f
+			};
+
+			mat3f mul_expected{
+				30.0f, 36.0f, 42.0f,
+				66.0f, 81.0f, 96.0f,
+				102.0f, 126.0f, 150.0f
+			};
+
+			Assert::IsTrue(mul_expected == m * m);
+
+			mat3d md{
+				1.0, 2.0, 3.0,
+				4.0, 5.0, 6.0,
+				7.0, 8.0, 9.0
+			};
+
+			mat3d muld_expected{
+				30.0, 36.0, 42.0,
+				66.0, 81.0, 96.0,
+				102.0, 126.0, 150.0
+			};
+
+			Assert::IsTrue(muld_expected == md * md);
+		}
+
+		TEST_METHOD(INVERSE_MAT3)
+		{
+			mat3f m{
+				2.0f, 0.0f, 0.0f,
+				0.0f, 4.0f, 0.0f,
+				1.0f, 2.0f, 1.0f
+			};
+
+			mat3f inv_expected{
+				0.5f, 0.0f, 0.0f,
+				0.0f, 0.25f, 0.0f,
+				-0.5f, -0.5f, 1.0f
+			};
+
+			Assert::IsTrue(inv_expected == m.inverse());
+
+			mat3d md{
+				2.0, 0.0, 0.0,
+				0.0, 4.0, 0.0,
+				1.0, 2.0, 1.0
+			};
+
+			mat3d invd_expected{
+				0.5, 0.0, 0.0,
+				0.0, 0.25, 0.0,
+				-0.5, -0.5, 1.0
+			};
+
+			Assert::IsTrue(invd_expected == md.inverse());
+		}
+
+		TEST_METHOD(TRANSFORM_MAT4)
+		{
+			mat4f m{
+				1.0f, 2.0f, 3.0f, 4.0f,
+				5.0f, 6.0f, 7.0f, 8.0f,
+				9.0f, 10.0f, 11.0f, 12.0f,
+				13.0f, 14.0f, 15.0f, 16.0f
+			};
+
+			vec4f v[9];
+
+			for (size_t i = 0; i < 9; i++)
+				v[i] = vec4f{ float(i), 1.0f, 0.0f, -1.0f };
+
+			transform(m, v, v, 9);
+
+			for (size_t i = 0; i < 9; i++)
+				Assert::IsTrue(v[i] == vec4f{ float(i) - 8.0f, float(2 * i) - 8.0f, float(3 * i) - 8.0f, float(4 * i) - 8.0f });
+
+			mat4d md{
+				1.0, 2.0, 3.0, 4.0,
+				5.0, 6.0, 7.0, 8.0,
+				9.0, 10.0, 11.0, 12.0,
+				13.0, 14.0, 15.0, 16.0
+			};
+
+			vec4d vd[9];
+
+			for (size_t i = 0; i < 9; i++)
+				vd[i] = vec4d{ double(i), 1.0, 0.0, -1.0 };
+
+			transform(md, vd, vd, 9);
+
+			for (size_t i = 0; i < 9; i++)
+				Assert::IsTrue(vd[i] == vec4d{ double(i) - 8.0, double(2 * i) - 8.0, double(3 * i) - 8.0, double(4 * i) - 8.0 });
+		}
+
+		TEST_METHOD(TRANSFORM_MAT3)
+		{
+			mat3f m{
+				1.0f, 2.0f, 3.0f,
+				4.0f, 5.0f, 6.0f,
+				7.0f, 8.0f, 9.0f
+			};
+
+			vec3f v[9];
+
+			for (size_t i = 0; i < 9; i++)
+				v[i] = vec3f{ float(i), 1.0f, -1.0f };
+
+			transform(m, v, v, 9);
+
+			for (size_t i = 0; i < 9; i++)
+				Assert::IsTrue(v[i] == vec3f{ float(i) - 3.0f, float(2 * i) - 3.0f, float(3 * i) - 3.0f });
+
+			mat3d md{
+				1.0, 2.0, 3.0,
+				4.0, 5.0, 6.0,
+				7.0, 8.0, 9.0
+			};
+
+			vec3d vd[9];
+
+			for (size_t i = 0; i < 9; i++)
+				vd[i] = vec3d{ double(i), 1.0, -1.0 };
+
+			transform(md, vd, vd, 9);
+
+			for (size_t i = 0; i < 9; i++)
+				Assert::IsTrue(vd[i] == vec3d{ double(i) - 3.0, double(2 * i) - 3.0, double(3 * i) - 3.0 });
+		}
+
+		TEST_METHOD(TRANSFORM_POINTS)
+		{
+			mat4f m{
+				2.0f, 0.0f, 0.0f, 0.0f,
+				0.0f, 3.0f, 0.0f, 0.0f,
+				0.0f, 0.0f, 4.0f, 0.0f,
+				1.0f, 2.0f, 3.0f, 1.0f
+			};
+
+			// Eleven points run the four point loop twice and leave three for the tail
+			vec3f points[11];
+
+			for (size_t i = 0; i < 11; i++)
+				points[i] = vec3f{ float(i), float(2 * i), -float(i) };
+
+			transform_points(m, points, points, 11);
+
+			for (size_t i = 0; i < 11; i++)
+				Assert::IsTrue(points[i] == vec3f{ float(2 * i + 1), float(6 * i + 2), 3.0f - float(4 * i) });
+
+			float x[9], y[9], z[9];
+
+			for (size_t i = 0; i < 9; i++)
+			{
+				x[i] = float(i);
+				y[i] = float(2 * i);
+				z[i] = -float(i);
+			}
+
+			transform_points(m, x, y, z, x, y, z, 9);
+
+			for (size_t i = 0; i < 9; i++)
+			{
+				Assert::IsTrue(x[i] == float(2 * i + 1));
+				Assert::IsTrue(y[i] == float(6 * i + 2));
+				Assert::IsTrue(z[i] == 3.0f - float(4 * i));
+			}
+
+			mat4d md{
+				2.0, 0.0, 0.0, 0.0,
+				0.0, 3.0, 0.0, 0.0,
+				0.0, 0.0, 4.0, 0.0,
+				1.0, 2.0, 3.0, 1.0
+			};
+
+			vec3d pointsd[11];
+
+			for (size_t i = 0; i < 11; i++)
+				pointsd[i] = vec3d{ double(i), double(2 * i), -double(i) };
+
+			transform_points(md, pointsd, pointsd, 11);
+
+			for (size_t i = 0; i < 11; i++)
+				Assert::IsTrue(pointsd[i] == vec3d{ double(2 * i + 1), double(6 * i + 2), 3.0 - double(4 * i) });
+
+			double xd[9], yd[9], zd[9];
+
+			for (size_t i = 0; i < 9; i++)
+			{
+				xd[i] = double(i);
+				yd[i] = double(2 * i);
+				zd[i] = -double(i);
+			}
+
+			transform_points(md, xd, yd, zd, xd, yd, zd, 9);
+
+			for (size_t i = 0; i < 9; i++)
+			{
+				Assert::IsTrue(xd[i] == double(2 * i + 1));
+				Assert::IsTrue(yd[i] == double(6 * i + 2));
+				Assert::IsTrue(zd[i] == 3.0 - double(4 * i));
+			}
+		}
+
 	};
 }
@@ -21,6 +21,10 @@ workspace "RBLibs"
     filter "system:windows"
         systemversion "latest"
 
+    -- 64-bit off_t on 32-bit POSIX targets, so that mapped files can be larger than 2 GiB
+    filter "system:not windows"
+        defines { "_FILE_OFFSET_BITS=64" }
+
     filter "platforms:x86"
         architecture "x86"
         
@@ -36,6 +40,11 @@ workspace "RBLibs"
 
         vectorextensions "AVX2"
 
+        filter "toolset:gcc or clang"
+            buildoptions { "-msha", "-maes", "-mpclmul" }
+
+        filter {}
+
         pchheader "pch.h"
         pchsource (BUILD_DIR .. "/%{prj.name}/src/pch.cpp")
 
@@ -112,3 +121,43 @@ workspace "RBLibs"
             symbols "Off"
             runtime "Release"
             optimize "On"
+
+
+    project "Bench"
+        kind "ConsoleApp"
+        location (BUILD_DIR .. "/%{prj.name}")
+        language "C++"
+        cppdialect "C++17"
+
+        vectorextensions "AVX2"
+
+        filter "toolset:gcc or clang"
+            buildoptions { "-msha", "-maes", "-mpclmul" }
+
+        filter "system:linux"
+            links { "pthread" }
+
+        filter {}
+
+        -- The library headers rely on the standard headers of its precompiled header
+        forceincludes { "pch.h" }
+
+        files { BUILD_DIR .. "/%{prj.name}/src/**.h", BUILD_DIR .. "/%{prj.name}/src/**.cpp" }
+
+        targetdir (BUILD_DIR .. "/bin/" .. OUTPUT_DIR .. "/%{prj.name}/")
+        objdir (BUILD_DIR .. "/obj/" .. OBJECT_DIR .. "/%{prj.name}/")
+
+        includedirs { BUILD_DIR .. "/Libs/src/", BUILD_DIR .. "/%{prj.name}/src/" }
+
+        links { "Libs" }
+
+        filter "configurations:Debug"
+            defines { "_DEBUG" }
+            symbols "On"
+            runtime "Debug"
+            optimize "Debug"
+
+        filter "configurations:Release"
+            symbols "Off"
+            runtime "Release"
+            optimize "Speed"